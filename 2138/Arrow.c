@@ -19,10 +19,7 @@
 #include <printf_P.h>
 #include <ea_init.h>
 #include "lcd.h"
-#include "ArrowLeft.h"
-#include "ArrowRight.h"
 #include "ArrowUp.h"
-#include "ArrowDown.h"
 #include "Arrow.h"
 
 /******************************************************************************
@@ -43,21 +40,26 @@
 /*****************************************************************************
  *
  * Description:
- *    Opis tutaj
+ *    Draw the arrows. All four directions use the up arrow bitmap, the
+ *    LCD controller rotates it.
  *
  ****************************************************************************/
+static void drawArrow(tU8 orient){
+	lcdIconOrient(5, 5, _ArrowUp[0], _ArrowUp[1], _ArrowUp[2], _ArrowUp[3], &_ArrowUp[4], orient);
+}
+
 void getUpArrow(void){
-	lcdIcon(5, 5, 90, 93, _ArrowUp[2], _ArrowUp[3], &_ArrowUp[4]);
+	drawArrow(LCD_ORIENT_NORMAL);
 }
 
 void getDownArrow(void){
-	lcdIcon(5,5,90,88,_ArrowDown[2], _ArrowDown[3], &_ArrowDown[4]);
+	drawArrow(LCD_ORIENT_ROT_180);
 }
 
 void getRightArrow(void){
-	lcdIcon(5,5,90,92,_ArrowRight[2], _ArrowRight[3], &_ArrowRight[4]);
+	drawArrow(LCD_ORIENT_ROT_90);
 }
 
 void getLeftArrow(void){
-	lcdIcon(5,5,90,93,_ArrowLeft[2], _ArrowLeft[3], &_ArrowLeft[4]);
+	drawArrow(LCD_ORIENT_ROT_270);
 }
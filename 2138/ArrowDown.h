@@ -1,139 +0,0 @@
-/*
- * First element is width of image
- * Second element is height of image
- * Third element specifies compression (0=off, 1=on)
- * Fourth element specifies escape value used with compression
- */
-const unsigned char _ArrowDown[] = {0x5a,0x58,0x01,0x00,
-0x00,0x1b,0xff,0xfe,0xd9,0xb9,0xb5,0x00,0x06,0x95,0x94,0x00,0x04,0x94,0x74,0x74,
-0x74,0x74,0x00,0x0a,0x70,0x94,0x94,0x94,0x94,0x95,0xb9,0xba,0xda,0xfe,0x00,0x33,
-0xff,0xb5,0x70,0x70,0x00,0x11,0x94,0x98,0x00,0x0e,0x98,0x94,0x74,0x70,0x90,0xba,
-0x00,0x31,0xff,0x95,0x70,0x98,0x00,0x23,0xbc,0xb8,0x94,0x70,0x95,0x00,0x2f,0xff,
-0xba,0x74,0x00,0x27,0xbc,0x98,0x70,0xba,0x00,0x2e,0xff,0x70,0xb8,0x00,0x28,0xbc,
-0xb8,0x94,0x00,0x2d,0xff,0xb5,0x94,0x00,0x07,0xbc,0xbd,0x00,0x04,0xbd,0xdd,0xdd,
-0xdd,0x00,0x0a,0xbd,0xbc,0x00,0x10,0xbc,0x94,0xba,0x00,0x2c,0xff,0x94,0x98,0x00,
-0x06,0xbc,0xbd,0x00,0x04,0xdd,0xde,0xde,0x00,0x07,0xdd,0xbd,0x00,0x0d,0xbd,0xbc,
-0x00,0x07,0xbc,0x98,0xb5,0x00,0x2b,0xff,0xfe,0x94,0xb8,0x00,0x06,0xbc,0xdd,0x00,
-0x09,0xde,0xdd,0xde,0xdd,0xdd,0xdd,0x00,0x0f,0xbd,0xbc,0x00,0x06,0xbc,0x94,0x00,
-0x2b,0xff,0xda,0x74,0xb8,0x00,0x05,0xbc,0xdd,0x00,0x08,0xde,0xdd,0x00,0x06,0xdd,
-0xbd,0x00,0x0e,0xbd,0xbc,0x00,0x06,0xbc,0x94,0x00,0x2b,0xff,0xda,0x74,0x00,0x05,
-0xbc,0xdd,0x00,0x0a,0xde,0xdd,0x00,0x04,0xdd,0xbd,0x00,0x0f,0xbd,0xbc,0x00,0x06,
-0xbc,0x94,0xdf,0x00,0x2a,0xff,0xba,0x74,0x00,0x05,0xbc,0xde,0x00,0x0b,0xde,0xdd,
-0x00,0x06,0xdd,0xbd,0x00,0x0d,0xbd,0xbc,0x00,0x05,0xbc,0x94,0xdf,0x00,0x2a,0xff,
-0xba,0x74,0x00,0x04,0xbc,0xbd,0x00,0x0c,0xde,0xdd,0x00,0x04,0xdd,0xbd,0x00,0x10,
-0xbd,0xbc,0x00,0x04,0xbc,0x98,0xdb,0x00,0x2a,0xff,0xba,0x74,0x00,0x04,0xbc,0xbd,
-0x00,0x0c,0xde,0xdd,0x00,0x04,0xdd,0xbd,0x00,0x10,0xbd,0xbc,0x00,0x04,0xbc,0xb8,
-0xda,0x00,0x2a,0xff,0xba,0x74,0x00,0x04,0xbc,0xbd,0x00,0x0c,0xde,0xdd,0x00,0x04,
-0xdd,0xbd,0x00,0x10,0xbd,0xbc,0x00,0x04,0xbc,0xb8,0xde,0x00,0x2a,0xff,0xba,0x74,
-0x00,0x04,0xbc,0xdd,0x00,0x0a,0xde,0xdd,0xde,0x00,0x05,0xdd,0xbd,0x00,0x10,0xbd,
-0xbc,0x00,0x04,0xbc,0x98,0xde,0x00,0x2a,0xff,0xba,0x74,0x00,0x04,0xbc,0xdd,0x00,
-0x0a,0xde,0xdd,0x00,0x06,0xdd,0xbd,0x00,0x10,0xbd,0xbc,0x00,0x04,0xbc,0x98,0xda,
-0x00,0x2a,0xff,0xba,0x74,0x00,0x04,0xbc,0xbd,0x00,0x0a,0xde,0xdd,0x00,0x06,0xdd,
-0xbd,0x00,0x10,0xbd,0xbc,0x00,0x04,0xbc,0x94,0xda,0x00,0x2a,0xff,0xba,0x74,0x00,
-0x04,0xbc,0xbd,0x00,0x09,0xde,0xdd,0x00,0x07,0xdd,0xbd,0x00,0x10,0xbd,0xbc,0x00,
-0x04,0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,0x74,0x00,0x04,0xbc,0xbd,0x00,0x07,0xde,
-0xdd,0x00,0x07,0xdd,0xbd,0x00,0x12,0xbd,0xbc,0x00,0x04,0xbc,0x94,0xde,0x00,0x2a,
-0xff,0xda,0x74,0x00,0x04,0xbc,0xbd,0xde,0xde,0xdd,0xde,0xde,0xde,0x00,0x09,0xdd,
-0xbd,0x00,0x12,0xbd,0xbc,0x00,0x04,0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,0x74,0x00,
-0x04,0xbc,0xbd,0xde,0xdd,0xdd,0xde,0xde,0x00,0x0a,0xdd,0xbd,0x00,0x12,0xbd,0xbc,
-0x00,0x04,0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xdd,0xdd,0xdd,
-0xde,0x00,0x0a,0xdd,0xbd,0x00,0x13,0xbd,0xbc,0x00,0x04,0xbc,0x94,0xde,0x00,0x2a,
-0xff,0xda,0x74,0x00,0x05,0xbc,0xdd,0x00,0x0d,0xdd,0xbd,0x00,0x13,0xbd,0xbc,0x00,
-0x04,0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xdd,0xdd,0xbd,0x00,
-0x0a,0xdd,0xbd,0x00,0x14,0xbd,0xbc,0x00,0x04,0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,
-0x74,0x00,0x05,0xbc,0xdd,0xdd,0xbd,0x00,0x04,0xdd,0xbd,0x00,0x1a,0xbd,0xbc,0x00,
-0x04,0xbc,0x94,0xda,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xbd,0xdd,0xbd,0xdd,
-0xdd,0xbd,0xdd,0x00,0x1b,0xbd,0xbc,0x00,0x04,0xbc,0x94,0xda,0x00,0x2a,0xff,0xda,
-0x74,0x00,0x05,0xbc,0xbd,0xdd,0x00,0x20,0xbd,0xbc,0x00,0x04,0xbc,0x94,0xde,0x00,
-0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xbd,0x00,0x21,0xbd,0xbc,0x00,0x04,0xbc,0x94,
-0xde,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xbd,0x00,0x21,0xbd,0xbc,0x00,0x04,
-0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xbd,0x00,0x21,0xbd,0xbc,
-0x00,0x04,0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xbd,0x00,0x21,
-0xbd,0xbc,0x00,0x04,0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xbd,
-0x00,0x20,0xbd,0xbc,0x00,0x05,0xbc,0x94,0xde,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,
-0xbc,0xbd,0x00,0x1c,0xbd,0xb9,0xb9,0xb9,0xb9,0xbd,0x00,0x05,0xbc,0x94,0xdb,0x00,
-0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xbd,0x00,0x1d,0xbd,0xb9,0xbd,0xbd,0x00,0x06,
-0xbc,0x94,0xda,0x00,0x2a,0xff,0xda,0x74,0x00,0x05,0xbc,0xbd,0x00,0x1f,0xbd,0xb9,
-0x00,0x06,0xbc,0x94,0xde,0x00,0x2a,0xff,0xba,0x74,0x00,0x05,0xbc,0xbd,0x00,0x1c,
-0xbd,0xb9,0xb9,0xbd,0xb8,0x00,0x06,0xbc,0x94,0xde,0x00,0x19,0xff,0xde,0x00,0x0f,
-0xda,0xde,0xb9,0x74,0x00,0x05,0xbc,0xbd,0x00,0x1c,0xbd,0xb9,0xb9,0xbd,0xb8,0x00,
-0x06,0xbc,0x70,0xb5,0xdf,0xff,0xff,0xdf,0x00,0x0b,0xda,0xff,0x00,0x07,0xff,0xb5,
-0x70,0x74,0x00,0x05,0x94,0x74,0x00,0x05,0x74,0x94,0x94,0x94,0x94,0x74,0x74,0x98,
-0x00,0x05,0xbc,0xbd,0x00,0x1b,0xbd,0xb9,0xb9,0xb9,0xb9,0xb8,0xb8,0x00,0x05,0xbc,
-0x94,0x74,0x00,0x06,0x94,0x98,0x98,0x98,0x98,0x00,0x06,0x94,0x90,0xda,0x00,0x04,
-0xff,0x95,0x74,0x98,0x00,0x18,0xbc,0xbd,0x00,0x1c,0xbd,0xb9,0xbd,0xb9,0x00,0x19,
-0xbc,0x98,0x74,0xb5,0xff,0xff,0x95,0x74,0x00,0x1a,0xbc,0xbd,0x00,0x1c,0xbd,0xb9,
-0xbd,0xb9,0xb8,0xb8,0x00,0x19,0xbc,0x94,0xb9,0xde,0x70,0xb8,0x00,0x1a,0xbc,0xbd,
-0x00,0x1b,0xbd,0xb9,0xb9,0xb9,0xb9,0xb8,0xb8,0x00,0x19,0xbc,0xbd,0x94,0xb9,0x94,
-0x00,0x1b,0xbc,0xbd,0x00,0x19,0xbd,0xb9,0x00,0x04,0xb9,0xb8,0xb8,0x00,0x1b,0xbc,
-0x94,0x94,0x98,0x00,0x0c,0xbc,0xbd,0x00,0x25,0xbd,0xb9,0xbd,0x00,0x06,0xb9,0xb8,
-0xb8,0xb8,0xbc,0xbc,0x98,0xb8,0x00,0x0c,0x98,0x9c,0x00,0x09,0xbc,0x98,0x74,0x98,
-0x00,0x07,0xbc,0xbd,0xb9,0xb9,0xb9,0x00,0x25,0xbd,0xb9,0x00,0x04,0xb9,0xbd,0xb9,
-0xb9,0xb9,0xb8,0xb8,0xb8,0x00,0x13,0x98,0x9c,0x00,0x07,0xbc,0x74,0x94,0x74,0x98,
-0x98,0x98,0x78,0x78,0x98,0x98,0xb8,0xb9,0xb9,0xb9,0x00,0x24,0xbd,0xb9,0x00,0x09,
-0xb9,0xb8,0x00,0x16,0x98,0x78,0x98,0x78,0x00,0x04,0x98,0x74,0xb9,0x70,0x00,0x07,
-0x74,0x98,0xbd,0xb9,0xb9,0x00,0x09,0xbd,0xb9,0x00,0x11,0xbd,0xb9,0xb9,0x00,0x06,
-0xbd,0xb9,0x00,0x07,0xb9,0xb8,0xb8,0x98,0xb8,0x00,0x15,0x98,0x78,0x00,0x06,0x74,
-0x70,0x95,0xde,0x70,0x00,0x06,0x74,0x78,0x99,0xbd,0xb9,0x00,0x09,0xbd,0xb9,0xb9,
-0x00,0x0f,0xbd,0xb9,0xb9,0xb9,0xb9,0x00,0x06,0xbd,0xb9,0xb9,0xbd,0x00,0x04,0xb9,
-0xb8,0x00,0x19,0x98,0x78,0x00,0x06,0x74,0x70,0xde,0xff,0xb5,0x70,0x00,0x06,0x74,
-0x98,0xbd,0xbd,0xb9,0xb9,0xbd,0xbd,0xb9,0xb9,0xb9,0xbd,0xbd,0x00,0x05,0xb9,0xbd,
-0xb9,0x00,0x09,0xbd,0xb9,0x00,0x05,0xb9,0xbd,0xbd,0xb9,0xb9,0xb9,0xbd,0x00,0x06,
-0xb9,0xb8,0x99,0x00,0x18,0x98,0x78,0x00,0x05,0x74,0x70,0x95,0xff,0xff,0xff,0x95,
-0x70,0x00,0x05,0x74,0x98,0x9d,0xbd,0x9c,0xb9,0xbd,0xb9,0xb9,0xbd,0x00,0x06,0xb9,
-0xbd,0x00,0x0a,0xbd,0xb9,0xb9,0xbd,0xbd,0x00,0x0b,0xb9,0xb8,0xb8,0xb8,0xb8,0x00,
-0x1b,0x98,0x74,0x00,0x06,0x74,0xff,0x00,0x04,0xff,0x95,0x70,0x00,0x05,0x74,0x98,
-0xbd,0x9c,0x99,0xbd,0x00,0x04,0xb9,0xbd,0xb9,0xb9,0xb9,0x00,0x0d,0xbd,0xb9,0xbd,
-0xbd,0xbd,0xb9,0xb9,0xb9,0xbd,0xbd,0xbd,0xb9,0xb9,0x00,0x05,0xb8,0x98,0x00,0x1a,
-0x98,0x78,0x00,0x05,0x74,0x70,0xde,0x00,0x06,0xff,0x94,0x70,0x00,0x04,0x74,0x78,
-0x98,0xbd,0x98,0x9c,0xbd,0x99,0x00,0x06,0xb9,0xbd,0xb9,0xb9,0xb9,0x00,0x05,0xbd,
-0xb9,0x00,0x0d,0xb9,0xb8,0xb8,0xb8,0xb8,0x00,0x1d,0x98,0x78,0x00,0x05,0x74,0x70,
-0xda,0x00,0x07,0xff,0xfe,0x95,0x70,0x00,0x05,0x74,0x98,0x9c,0x98,0x98,0x9d,0x98,
-0x00,0x1c,0xb9,0xb8,0x00,0x1f,0x98,0x78,0x00,0x05,0x74,0x70,0xda,0x00,0x0a,0xff,
-0x94,0x00,0x06,0x74,0x98,0x9c,0x98,0x99,0xb8,0x00,0x18,0xb9,0xb8,0xb9,0xb8,0xb8,
-0x00,0x1f,0x98,0x78,0x00,0x05,0x74,0x70,0xda,0x00,0x0c,0xff,0x95,0x70,0x74,0x74,
-0x54,0x54,0x78,0x98,0x9d,0xb8,0xb8,0xbc,0xb8,0x00,0x04,0xb9,0xbd,0xbd,0xbd,0x00,
-0x07,0xb9,0xbd,0xbd,0xbd,0xb9,0xb9,0xbd,0xb9,0xb8,0x00,0x22,0x98,0x78,0x00,0x05,
-0x74,0x70,0xda,0x00,0x0d,0xff,0xfe,0x94,0x70,0x00,0x05,0x74,0x98,0x9c,0x99,0x99,
-0xb8,0xb8,0x98,0x98,0x98,0x00,0x0d,0xb8,0x98,0x00,0x25,0x98,0x78,0x00,0x05,0x74,
-0x70,0xda,0x00,0x0f,0xff,0xfe,0x95,0x70,0x00,0x04,0x74,0x78,0x98,0x99,0x99,0x99,
-0xb8,0xb8,0x00,0x34,0x98,0x78,0x00,0x05,0x74,0x70,0xda,0x00,0x12,0xff,0x95,0x70,
-0x00,0x04,0x74,0x78,0x98,0x99,0x98,0xb8,0x00,0x34,0x98,0x78,0x00,0x05,0x74,0x70,
-0xde,0x00,0x14,0xff,0x94,0x70,0x74,0x74,0x74,0x54,0x78,0x00,0x36,0x98,0x78,0x78,
-0x00,0x04,0x74,0x70,0xda,0x00,0x15,0xff,0xfe,0x94,0x70,0x74,0x74,0x74,0x54,0x78,
-0x00,0x34,0x98,0x78,0x00,0x06,0x74,0xda,0x00,0x17,0xff,0xfe,0x95,0x50,0x00,0x05,
-0x74,0x98,0x00,0x31,0x98,0x78,0x00,0x05,0x74,0x70,0xba,0x00,0x1a,0xff,0x95,0x70,
-0x00,0x05,0x74,0x98,0x00,0x2f,0x98,0x78,0x00,0x05,0x74,0x70,0xda,0x00,0x1c,0xff,
-0x94,0x70,0x00,0x05,0x74,0x98,0x00,0x2d,0x98,0x78,0x00,0x05,0x74,0x70,0xda,0x00,
-0x1e,0xff,0x94,0x70,0x00,0x05,0x74,0x98,0x00,0x2b,0x98,0x78,0x00,0x06,0x74,0xda,
-0x00,0x20,0xff,0x94,0x70,0x00,0x05,0x74,0x98,0x00,0x29,0x98,0x78,0x00,0x05,0x74,
-0x70,0xba,0x00,0x22,0xff,0x94,0x70,0x00,0x05,0x74,0x98,0x00,0x27,0x98,0x78,0x00,
-0x05,0x74,0x70,0xda,0x00,0x24,0xff,0x94,0x70,0x00,0x05,0x74,0x98,0x00,0x25,0x98,
-0x78,0x00,0x05,0x74,0x70,0xda,0x00,0x26,0xff,0x95,0x00,0x05,0x74,0x78,0x78,0x00,
-0x23,0x98,0x78,0x00,0x05,0x74,0x70,0xda,0x00,0x28,0xff,0x94,0x70,0x74,0x74,0x74,
-0x54,0x78,0x78,0x00,0x21,0x98,0x78,0x00,0x05,0x74,0x70,0xba,0x00,0x29,0xff,0xfe,
-0x94,0x70,0x74,0x74,0x54,0x54,0x78,0x00,0x20,0x98,0x78,0x00,0x05,0x74,0x70,0xba,
-0x00,0x2c,0xff,0x94,0x00,0x06,0x74,0x98,0x00,0x1d,0x98,0x78,0x00,0x05,0x74,0x70,
-0xba,0x00,0x2e,0xff,0x94,0x70,0x00,0x05,0x74,0x98,0x00,0x1b,0x98,0x78,0x00,0x05,
-0x74,0x70,0xba,0x00,0x30,0xff,0x94,0x70,0x00,0x05,0x74,0x98,0x00,0x19,0x98,0x78,
-0x00,0x05,0x74,0x70,0xda,0x00,0x32,0xff,0x94,0x70,0x00,0x05,0x74,0x98,0x00,0x16,
-0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xda,0x00,0x34,0xff,0x94,0x74,0x74,0x78,0x74,
-0x74,0x74,0x00,0x16,0x98,0x78,0x00,0x06,0x74,0xba,0x00,0x36,0xff,0x94,0x70,0x00,
-0x04,0x74,0x78,0x78,0x00,0x13,0x98,0x78,0x00,0x05,0x74,0x70,0xba,0x00,0x38,0xff,
-0x95,0x70,0x00,0x05,0x74,0x78,0x00,0x10,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xba,
-0x00,0x3a,0xff,0x94,0x70,0x00,0x05,0x74,0x78,0x00,0x0e,0x98,0x78,0x78,0x00,0x05,
-0x74,0x70,0xba,0x00,0x3c,0xff,0x94,0x00,0x05,0x74,0x78,0x78,0x00,0x0d,0x98,0x78,
-0x00,0x05,0x74,0x70,0xba,0x00,0x3e,0xff,0x94,0x70,0x00,0x04,0x74,0x78,0x78,0x00,
-0x09,0x98,0x78,0x78,0x78,0x00,0x05,0x74,0x70,0xba,0x00,0x40,0xff,0x95,0x70,0x00,
-0x04,0x74,0x78,0x78,0x00,0x09,0x98,0x78,0x00,0x05,0x74,0x70,0xba,0x00,0x42,0xff,
-0x94,0x70,0x00,0x05,0x74,0x78,0x00,0x04,0x98,0x78,0x98,0x78,0x78,0x00,0x05,0x74,
-0x70,0xb9,0x00,0x44,0xff,0x94,0x70,0x00,0x05,0x74,0x78,0x98,0x98,0x78,0x98,0x78,
-0x78,0x00,0x05,0x74,0x70,0xb9,0x00,0x46,0xff,0x94,0x70,0x00,0x05,0x74,0x78,0x00,
-0x04,0x78,0x74,0x00,0x04,0x74,0x70,0x95,0x00,0x48,0xff,0x94,0x00,0x06,0x74,0x78,
-0x78,0x78,0x00,0x05,0x74,0x50,0xb5,0x00,0x49,0xff,0xfe,0x95,0x70,0x00,0x05,0x74,
-0x78,0x00,0x05,0x74,0x70,0x99,0x00,0x4c,0xff,0x95,0x70,0x00,0x08,0x74,0x70,0x70,
-0xb9,0x00,0x4e,0xff,0xb9,0x70,0x00,0x06,0x74,0x70,0x70,0xda,0x00,0x50,0xff,0xde,
-0x99,0x74,0x74,0x74,0x70,0x74,0x99,0xfe,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff
-};
@@ -1,149 +0,0 @@
-/*
- * First element is width of image
- * Second element is height of image
- * Third element specifies compression (0=off, 1=on)
- * Fourth element specifies escape value used with compression
- */
-const unsigned char _ArrowRight[] = {0x5a,0x5c,0x01,0x00,
-0x00,0x29,0xff,0xda,0x95,0x74,0x74,0x74,0xb9,0xde,0x00,0x51,0xff,0xde,0x95,0x70,
-0x94,0xb8,0xb8,0xb8,0x94,0x74,0xb5,0x00,0x50,0xff,0x94,0x94,0x00,0x07,0xbc,0x94,
-0x95,0x00,0x4e,0xff,0xb9,0x94,0x00,0x09,0xbc,0x94,0x95,0xdf,0x00,0x4c,0xff,0x94,
-0xb8,0x00,0x0a,0xbc,0x94,0x74,0xde,0x00,0x4a,0xff,0xda,0x74,0x00,0x0c,0xbc,0x94,
-0x70,0xfe,0x00,0x49,0xff,0xba,0x74,0x00,0x0d,0xbc,0x94,0x94,0x00,0x49,0xff,0xb6,
-0x74,0x00,0x0e,0xbc,0x94,0x90,0xfe,0x00,0x47,0xff,0x95,0x74,0x00,0x0f,0xbc,0x94,
-0x94,0xfe,0x00,0x46,0xff,0x95,0x74,0x00,0x07,0xbc,0xb8,0xbd,0x00,0x07,0xbc,0x94,
-0x90,0xfe,0x00,0x45,0xff,0x95,0x74,0x00,0x04,0xbc,0xbd,0xbd,0xbd,0xb9,0xb9,0xb9,
-0xb8,0x00,0x06,0xbc,0x94,0x94,0x00,0x45,0xff,0x95,0x74,0x00,0x04,0xbc,0xbd,0xbd,
-0xbd,0x00,0x04,0xb9,0xb8,0x00,0x06,0xbc,0x94,0x94,0x00,0x44,0xff,0x95,0x74,0x00,
-0x04,0xbc,0xbd,0xbd,0xbd,0xbd,0xb9,0xb9,0xb9,0xb8,0x00,0x07,0xbc,0x94,0x94,0xfe,
-0x00,0x42,0xff,0x95,0x74,0x00,0x04,0xbc,0xbd,0x00,0x06,0xbd,0xb8,0xb8,0xb8,0x00,
-0x06,0xbc,0x94,0x94,0x00,0x42,0xff,0x95,0x74,0x00,0x04,0xbc,0xbd,0x00,0x07,0xbd,
-0xb9,0xb8,0xb8,0x00,0x06,0xbc,0x94,0x70,0x00,0x41,0xff,0x95,0x74,0x00,0x04,0xbc,
-0xbd,0x00,0x08,0xbd,0xb9,0xb9,0x98,0x00,0x06,0xbc,0x94,0x94,0x00,0x40,0xff,0xb5,
-0x74,0x00,0x04,0xbc,0xbd,0x00,0x08,0xbd,0xb9,0xb9,0xb9,0x99,0x00,0x06,0xbc,0x94,
-0x94,0x00,0x3f,0xff,0xb9,0x70,0x00,0x04,0xbc,0xbd,0x00,0x08,0xbd,0xb9,0xb9,0xb9,
-0xb9,0xb8,0x00,0x06,0xbc,0x94,0x94,0x00,0x3e,0xff,0xb9,0x70,0x00,0x04,0xbc,0xbd,
-0x00,0x08,0xbd,0xb9,0xb9,0xb8,0xb8,0xb9,0x99,0xb8,0x00,0x05,0xbc,0x94,0x90,0xfe,
-0x00,0x3c,0xff,0xba,0x70,0x00,0x04,0xbc,0xbd,0x00,0x0a,0xbd,0xb8,0xb9,0xb9,0x99,
-0x98,0x00,0x06,0xbc,0x94,0x74,0xfe,0x00,0x3b,0xff,0xba,0x70,0xb8,0xbc,0xbc,0xbc,
-0x00,0x0c,0xbd,0xb9,0x98,0x98,0x98,0x99,0xb8,0x00,0x05,0xbc,0x94,0x94,0x00,0x1d,
-0xff,0xde,0xda,0xba,0x00,0x07,0xb9,0xba,0xba,0xba,0x00,0x07,0xda,0xde,0x00,0x04,
-0xde,0xda,0xda,0xda,0xba,0xb9,0x94,0x70,0x00,0x04,0xbc,0xbd,0x00,0x0b,0xbd,0xb9,
-0xb9,0xb8,0xb8,0x99,0x98,0x98,0x00,0x05,0xbc,0x94,0x95,0xfe,0x00,0x19,0xff,0xb5,
-0x94,0x74,0x74,0x74,0x00,0x08,0x94,0x74,0x00,0x09,0x74,0x94,0x94,0x94,0x00,0x04,
-0x74,0x70,0x70,0x74,0x74,0x00,0x04,0xbc,0xbd,0x00,0x09,0xbd,0xb9,0xbd,0x00,0x04,
-0xb9,0x98,0x98,0x98,0x98,0x00,0x05,0xbc,0x94,0x94,0xde,0x00,0x16,0xff,0xda,0x70,
-0x74,0x98,0xb8,0x00,0x23,0xbc,0xbd,0x00,0x08,0xbd,0xb9,0xb9,0xbd,0xb9,0xb9,0xb9,
-0x00,0x06,0x98,0xbc,0x00,0x04,0xbc,0x94,0x94,0x00,0x15,0xff,0xb9,0x70,0x98,0x00,
-0x26,0xbc,0xbd,0x00,0x0c,0xbd,0xb9,0xb9,0x99,0x00,0x06,0x98,0xbc,0x00,0x04,0xbc,
-0x94,0x90,0x00,0x13,0xff,0xda,0x70,0xb8,0x00,0x27,0xbc,0xbd,0x00,0x0c,0xbd,0xb9,
-0xb9,0x99,0x00,0x07,0x98,0xbc,0x00,0x04,0xbc,0x94,0x90,0xfe,0x00,0x11,0xff,0x95,
-0x94,0x00,0x28,0xbc,0xbd,0x00,0x0c,0xbd,0xb9,0xb9,0x99,0x00,0x08,0x98,0xbc,0x00,
-0x04,0xbc,0x94,0x94,0xfe,0x00,0x0f,0xff,0xde,0x70,0xb8,0x00,0x28,0xbc,0xbd,0x00,
-0x0b,0xbd,0xb9,0xb9,0x99,0x00,0x0a,0x98,0xbc,0x00,0x04,0xbc,0x94,0x94,0x00,0x0f,
-0xff,0xb9,0x74,0x00,0x09,0xbc,0xbd,0x00,0x08,0xbd,0xdd,0x00,0x12,0xdd,0xbd,0x00,
-0x0f,0xbd,0xb9,0xb9,0x99,0x00,0x0b,0x98,0xbc,0x00,0x04,0xbc,0x94,0x94,0xfe,0x00,
-0x0d,0xff,0x95,0x94,0x00,0x06,0xbc,0xbd,0x00,0x0a,0xbd,0xdd,0xdd,0xdd,0x00,0x0f,
-0xde,0xdd,0xdd,0x00,0x10,0xbd,0xb9,0xb9,0x99,0x00,0x0c,0x98,0xbc,0x00,0x04,0xbc,
-0x94,0x74,0xfe,0x00,0x0c,0xff,0x94,0x98,0x00,0x05,0xbc,0xbd,0xb9,0x00,0x0a,0xbd,
-0xdd,0xdd,0x00,0x10,0xde,0xdd,0x00,0x11,0xbd,0xb9,0xb9,0x00,0x0e,0x98,0xbc,0x00,
-0x04,0xbc,0x94,0x70,0x00,0x0c,0xff,0x94,0x98,0x00,0x05,0xbc,0xbd,0xb9,0x00,0x0a,
-0xbd,0xdd,0x00,0x04,0xdd,0xde,0x00,0x09,0xde,0xdd,0x00,0x04,0xdd,0xbd,0x00,0x0f,
-0xbd,0xb9,0xb9,0x00,0x0f,0x98,0xbc,0x00,0x04,0xbc,0x94,0x90,0x00,0x0b,0xff,0x74,
-0x98,0x00,0x04,0xbc,0xbd,0x00,0x0d,0xbd,0xdd,0x00,0x04,0xdd,0xde,0x00,0x08,0xde,
-0xdd,0x00,0x04,0xdd,0xbd,0x00,0x0d,0xbd,0xb9,0xb9,0xbd,0xb9,0xb9,0x00,0x0f,0x98,
-0xbc,0x00,0x04,0xbc,0x94,0x94,0xfe,0x00,0x09,0xff,0x74,0xb8,0x00,0x04,0xbc,0xbd,
-0x00,0x0d,0xbd,0xdd,0x00,0x04,0xdd,0xde,0x00,0x08,0xde,0xdd,0xdd,0xdd,0xdd,0x00,
-0x0f,0xbd,0xb9,0xb9,0xbd,0xb9,0xb8,0x00,0x10,0x98,0xbc,0x00,0x04,0xbc,0x94,0x94,
-0xfe,0x00,0x08,0xff,0x70,0xb8,0x00,0x04,0xbc,0xbd,0x00,0x0d,0xbd,0xdd,0x00,0x06,
-0xdd,0xde,0x00,0x04,0xde,0xdd,0x00,0x05,0xdd,0xbd,0x00,0x0f,0xbd,0xb9,0xb9,0xb9,
-0xb8,0x00,0x11,0x98,0xbc,0x00,0x04,0xbc,0x94,0x94,0x00,0x08,0xff,0x74,0xb8,0x00,
-0x04,0xbc,0xb9,0x00,0x0e,0xbd,0xdd,0x00,0x07,0xdd,0xde,0xde,0x00,0x06,0xdd,0xbd,
-0x00,0x0f,0xbd,0xb9,0xb9,0xb9,0xb9,0x00,0x13,0x98,0xbc,0x00,0x04,0xbc,0x94,0x91,
-0x00,0x07,0xff,0x74,0xb8,0xbc,0xbc,0xbc,0xb8,0xb8,0x00,0x0e,0xbd,0xdd,0x00,0x0f,
-0xdd,0xbd,0x00,0x0e,0xbd,0xb9,0xbd,0xb9,0xb9,0xb8,0x00,0x14,0x98,0xbc,0x00,0x04,
-0xbc,0x94,0x90,0x00,0x06,0xff,0x94,0x98,0xbc,0xbc,0xbc,0x98,0xb9,0x00,0x11,0xbd,
-0xdd,0x00,0x0b,0xdd,0xbd,0x00,0x10,0xbd,0xb9,0xb9,0xb9,0xb9,0x00,0x15,0x98,0xbc,
-0x00,0x04,0xbc,0x94,0x94,0xfe,0x00,0x04,0xff,0x94,0x98,0xbc,0xbc,0xbc,0x98,0xb8,
-0x00,0x12,0xbd,0xdd,0x00,0x07,0xdd,0xbd,0x00,0x13,0xbd,0xb9,0xb9,0xb9,0xb8,0x00,
-0x16,0x98,0xbc,0x00,0x04,0xbc,0x94,0x94,0x00,0x04,0xff,0x94,0x98,0xbc,0xbc,0xbc,
-0x98,0xb8,0x00,0x18,0xbd,0xdd,0x00,0x14,0xbd,0xb9,0xb9,0xb9,0xb9,0x00,0x18,0x98,
-0xbc,0x00,0x04,0xbc,0x94,0x95,0xff,0xff,0xff,0x95,0x94,0xbc,0xbc,0xbc,0x98,0xb8,
-0xb9,0xbc,0x00,0x2b,0xbd,0xb9,0xb9,0xb9,0xb8,0x00,0x19,0x98,0xbc,0x00,0x04,0xbc,
-0x74,0x95,0xff,0xff,0xb9,0x94,0xbc,0xbc,0xbc,0x98,0xb8,0xbd,0xbc,0x00,0x2b,0xbd,
-0xb9,0xb9,0xb9,0xb8,0x00,0x18,0x98,0x78,0x98,0x00,0x04,0xbc,0xb8,0x70,0xb9,0xff,
-0xb9,0x94,0xbc,0xbc,0xbc,0x98,0xb8,0x00,0x2c,0xbd,0xb9,0xb9,0xb9,0xb8,0xb8,0x00,
-0x12,0x98,0x78,0x00,0x08,0x98,0xbc,0xbc,0xbc,0xbc,0xb8,0x70,0xde,0xb9,0x94,0x00,
-0x04,0xbc,0xb8,0xb9,0x00,0x2a,0xbd,0xb9,0xb9,0xb9,0xb8,0x00,0x14,0x98,0x78,0x00,
-0x09,0x98,0xbc,0xbc,0xbc,0xbc,0x94,0x94,0xb9,0x94,0x00,0x04,0xbc,0xb8,0x00,0x2b,
-0xbd,0xb9,0xb9,0xb9,0xb8,0x00,0x1f,0x98,0xbc,0xbc,0xbc,0xb8,0x70,0xb9,0x94,0x00,
-0x04,0xbc,0xb8,0xb9,0xbd,0xbd,0xb9,0xb9,0x00,0x24,0xbd,0xb9,0xb9,0xb9,0xb9,0xb8,
-0x00,0x1f,0x98,0x78,0x98,0xbc,0xbc,0xbc,0x74,0xb9,0x94,0x00,0x04,0xbc,0x98,0x00,
-0x05,0xb9,0xbd,0x00,0x21,0xbd,0xb9,0x00,0x04,0xb9,0xb8,0x00,0x21,0x98,0x78,0x78,
-0x98,0xbc,0x74,0xb9,0x94,0x00,0x04,0xbc,0xb8,0x99,0xbd,0xb9,0x00,0x24,0xbd,0xb9,
-0x00,0x04,0xb9,0xb8,0x00,0x1d,0x98,0x78,0x00,0x04,0x78,0x74,0x74,0x98,0x74,0xb9,
-0x94,0x00,0x04,0xbc,0x98,0x99,0xb8,0xb9,0xb9,0xbd,0xb9,0x00,0x21,0xbd,0xb9,0xb9,
-0xb9,0xb9,0x00,0x21,0x98,0x78,0x00,0x05,0x74,0x94,0x95,0x94,0x00,0x04,0xbc,0x98,
-0x99,0xb8,0xb8,0xb9,0xb9,0x00,0x20,0xbd,0xb9,0x00,0x04,0xb9,0xb8,0x00,0x20,0x98,
-0x78,0x78,0x00,0x04,0x74,0x70,0xba,0x95,0x94,0x00,0x04,0xbc,0x98,0x98,0x98,0xb8,
-0xb8,0xb8,0xb9,0xbd,0xbd,0xb9,0xb9,0x00,0x19,0xbd,0xb9,0x00,0x04,0xb9,0xb8,0x00,
-0x21,0x98,0x78,0x78,0x00,0x04,0x74,0x70,0x95,0xff,0x95,0x94,0x00,0x04,0xbc,0x98,
-0x98,0x98,0x98,0xb8,0xb8,0xb8,0xbc,0xb9,0xbd,0xb9,0x00,0x16,0xbd,0xb9,0x00,0x06,
-0xb9,0xb8,0x00,0x1f,0x98,0x78,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xde,0xff,0x95,
-0x94,0x00,0x04,0xbc,0x98,0x00,0x06,0x98,0xb8,0xbd,0x00,0x06,0xb9,0xbd,0x00,0x0b,
-0xbd,0xb9,0xb9,0xb9,0xbd,0xbd,0xbd,0x00,0x06,0xb9,0xb8,0x00,0x1c,0x98,0x78,0x78,
-0x78,0x78,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xb9,0xff,0xff,0x95,0x94,0x00,0x04,
-0xbc,0x98,0x00,0x06,0x98,0xb8,0xb8,0x00,0x0b,0xb9,0xbd,0x00,0x05,0xb9,0xbd,0xbd,
-0x00,0x0a,0xb9,0xb8,0x00,0x21,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xb9,0xff,0xff,
-0xff,0x95,0x94,0xbc,0xbc,0xbc,0x9c,0x00,0x0a,0x98,0xb8,0x00,0x10,0xb9,0xbd,0x00,
-0x06,0xb9,0xb8,0xb8,0xb8,0x00,0x22,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xb9,0x00,
-0x04,0xff,0x95,0x94,0xbc,0xbc,0xbc,0x9c,0x00,0x0b,0x98,0xb8,0xb8,0x00,0x06,0xb9,
-0xbd,0xbd,0x00,0x05,0xb9,0xbd,0xbd,0xb9,0xb9,0xbd,0xbd,0xb8,0xb8,0x98,0xb8,0xb8,
-0x00,0x21,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xb9,0x00,0x05,0xff,0x95,0x94,0xbc,
-0xbc,0xbc,0x9c,0x00,0x0f,0x98,0x99,0x99,0x99,0x00,0x08,0xb9,0x99,0x99,0x99,0x99,
-0x00,0x27,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xba,0x00,0x06,0xff,0x95,0x94,0xbc,
-0xbc,0xbc,0x00,0x45,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xba,0x00,0x07,0xff,0x99,
-0x94,0xbc,0xbc,0xbc,0x00,0x41,0x98,0x78,0x98,0x98,0x78,0x00,0x07,0x74,0xda,0x00,
-0x08,0xff,0xb9,0x94,0xbc,0xbc,0xbc,0x98,0x74,0x00,0x14,0x98,0xb8,0x00,0x04,0xb8,
-0x98,0x00,0x27,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xda,0x00,0x09,0xff,0xb9,0x94,
-0xbc,0xbc,0xbc,0x9c,0x74,0x74,0x00,0x3f,0x98,0x78,0x00,0x06,0x74,0x70,0xde,0x00,
-0x0a,0xff,0xba,0x94,0xbc,0xbc,0xbc,0x98,0x74,0x74,0x74,0x78,0x00,0x3c,0x98,0x78,
-0x00,0x06,0x74,0x70,0xde,0x00,0x0b,0xff,0xda,0x70,0xbc,0xbc,0xbc,0x98,0x00,0x05,
-0x74,0x78,0x78,0x78,0x00,0x37,0x98,0x78,0x00,0x06,0x74,0x70,0xda,0x00,0x0c,0xff,
-0xde,0x70,0xb8,0xbc,0xbc,0x98,0x00,0x25,0x74,0x98,0x00,0x18,0x98,0x78,0x00,0x05,
-0x74,0x54,0x70,0xda,0x00,0x0e,0xff,0x95,0x94,0xbc,0xbc,0x9c,0x00,0x25,0x74,0x98,
-0x00,0x17,0x98,0x78,0x78,0x00,0x06,0x74,0xda,0x00,0x0f,0xff,0xda,0x70,0x98,0xbc,
-0xbc,0x00,0x04,0x74,0x78,0x00,0x15,0x74,0x54,0x00,0x0a,0x74,0x98,0x00,0x16,0x98,
-0x78,0x78,0x00,0x04,0x74,0x70,0x70,0xde,0x00,0x11,0xff,0xba,0x70,0x94,0xbc,0x78,
-0x00,0x19,0x74,0x78,0x00,0x0a,0x74,0x98,0x00,0x15,0x98,0x78,0x00,0x07,0x74,0xda,
-0x00,0x13,0xff,0xde,0x95,0x74,0x70,0x00,0x24,0x74,0x98,0x00,0x14,0x98,0x78,0x78,
-0x00,0x06,0x74,0xde,0x00,0x16,0xff,0xde,0xb9,0x95,0x94,0x00,0x1d,0x70,0x74,0x00,
-0x04,0x74,0x98,0x00,0x10,0x98,0x78,0x98,0x98,0x78,0x78,0x54,0x00,0x05,0x74,0xde,
-0x00,0x1e,0xff,0xfe,0x00,0x18,0xff,0xb9,0x00,0x05,0x74,0x98,0x00,0x0f,0x98,0x78,
-0x78,0x98,0x78,0x78,0x74,0x54,0x00,0x04,0x74,0xde,0x00,0x38,0xff,0xda,0x70,0x00,
-0x04,0x74,0x98,0x00,0x11,0x98,0x78,0x00,0x07,0x74,0xde,0x00,0x39,0xff,0xda,0x70,
-0x00,0x04,0x74,0x98,0x00,0x10,0x98,0x78,0x00,0x07,0x74,0xde,0x00,0x3a,0xff,0xda,
-0x70,0x00,0x04,0x74,0x98,0x00,0x0f,0x98,0x78,0x00,0x06,0x74,0x70,0xde,0x00,0x3b,
-0xff,0xda,0x70,0x00,0x04,0x74,0x98,0x00,0x0e,0x98,0x78,0x78,0x00,0x05,0x74,0x70,
-0xde,0x00,0x3c,0xff,0xda,0x70,0x00,0x04,0x74,0x98,0x00,0x0d,0x98,0x78,0x00,0x05,
-0x74,0x54,0x74,0xde,0x00,0x3d,0xff,0xda,0x70,0x00,0x04,0x74,0x98,0x00,0x0c,0x98,
-0x78,0x78,0x00,0x04,0x74,0x70,0x74,0xde,0x00,0x3e,0xff,0xda,0x70,0x00,0x04,0x74,
-0x98,0x00,0x0b,0x98,0x78,0x78,0x00,0x04,0x74,0x70,0x90,0xde,0x00,0x3f,0xff,0xda,
-0x70,0x00,0x04,0x74,0x98,0x00,0x0a,0x98,0x78,0x00,0x07,0x74,0xde,0x00,0x40,0xff,
-0xda,0x70,0x00,0x04,0x74,0x98,0x00,0x09,0x98,0x78,0x78,0x00,0x05,0x74,0x70,0xde,
-0x00,0x41,0xff,0xda,0x70,0x00,0x04,0x74,0x98,0x00,0x07,0x98,0x78,0x78,0x78,0x00,
-0x06,0x74,0xde,0x00,0x42,0xff,0xda,0x70,0x00,0x04,0x74,0x78,0x00,0x06,0x98,0x78,
-0x78,0x78,0x00,0x05,0x74,0x94,0xde,0x00,0x43,0xff,0xda,0x70,0x00,0x04,0x74,0x78,
-0x98,0x98,0x98,0x00,0x04,0x78,0x74,0x00,0x06,0x74,0xde,0x00,0x44,0xff,0xda,0x70,
-0x00,0x05,0x74,0x78,0x78,0x98,0x78,0x78,0x78,0x00,0x07,0x74,0xde,0x00,0x45,0xff,
-0xda,0x70,0x00,0x07,0x74,0x78,0x00,0x07,0x74,0x70,0x70,0xde,0x00,0x46,0xff,0xda,
-0x70,0x00,0x0f,0x74,0x90,0xde,0x00,0x47,0xff,0xda,0x70,0x00,0x0d,0x74,0x54,0x74,
-0xde,0x00,0x48,0xff,0xda,0x70,0x74,0x74,0x74,0x54,0x00,0x05,0x74,0x54,0x74,0x74,
-0x74,0x70,0xdf,0x00,0x49,0xff,0xdf,0x70,0x00,0x06,0x74,0x78,0x00,0x05,0x74,0x94,
-0xde,0x00,0x4b,0xff,0x95,0x70,0x00,0x0b,0x74,0xfe,0x00,0x4c,0xff,0xde,0x70,0x00,
-0x08,0x74,0x70,0x74,0xde,0x00,0x4e,0xff,0xda,0x70,0x70,0x00,0x05,0x74,0x70,0x95,
-0x00,0x51,0xff,0xdf,0xb9,0x74,0x70,0x74,0x74,0x74,0xb9,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xff,0xff
-};
@@ -58,7 +58,7 @@ void initApp(void){
 	for(;;){
 
 		tU8 pressKey;
-		pressKey = checkKey();
+		pressKey = waitKey(0);
 	    if (pressKey != KEY_NOTHING)
 	    {
 		if(pressKey == KEY_LEFT) getLeftArrow();
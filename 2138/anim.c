@@ -0,0 +1,117 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    anim.c
+ *
+ * Description:
+ *    Player for animation containers (img.h with IMG_FLAG_DELTA, made by
+ *    imgc -d). Frame 0 is drawn in full when the animation is started,
+ *    after that only the rectangles that change from one frame to the
+ *    next are drawn. The frames loop, the last delta goes back to frame 0.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "anim.h"
+#include "img.h"
+#include "lcd.h"
+
+
+/*****************************************************************************
+ * External variables
+ ****************************************************************************/
+extern volatile tU32 ms;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start an animation, draws frame 0.
+ *
+ * Params:
+ *    [in] pAnim    - animation state
+ *    [in] x, y     - position on the screen
+ *    [in] pImg     - animation container
+ *    [in] periodMs - time between frames
+ *
+ ****************************************************************************/
+void
+animStart(tAnim* pAnim, tU8 x, tU8 y, const tU8* pImg, tU16 periodMs)
+{
+  pAnim->pImg     = pImg;
+  pAnim->x        = x;
+  pAnim->y        = y;
+  pAnim->frame    = 0;
+  pAnim->periodMs = periodMs;
+  pAnim->nextMs   = ms + periodMs;
+
+  lcdImage(x, y, pImg, 0);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw the changes to the next frame.
+ *
+ ****************************************************************************/
+void
+animNext(tAnim* pAnim)
+{
+  const tU8* pData;
+  const tU8* pPixels;
+  tU16 rects;
+
+  if (imgIsDelta(pAnim->pImg) == FALSE)
+    return;
+
+  //delta n holds the changes from frame n - 1 to frame n (last one to 0)
+  pData   = imgFrameData(pAnim->pImg, pAnim->frame + 1);
+  rects   = pData[0] | (pData[1] << 8);
+  pData  += 2;
+  pPixels = pData + IMG_RECT_SIZE * rects;
+
+  //the pixels of all rectangles are one stream
+  for(; rects > 0; rects--, pData += IMG_RECT_SIZE)
+  {
+    lcdImageRect(pAnim->x + pData[0], pAnim->y + pData[1], pData[2], pData[3],
+                 pAnim->pImg, pPixels);
+    pPixels = NULL;
+  }
+
+  pAnim->frame++;
+  if (pAnim->frame == imgFrames(pAnim->pImg))
+    pAnim->frame = 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw the next frame if it is time for it. The frames are paced on
+ *    the ms counter without drift; if the caller is late by more than a
+ *    frame the pacing restarts from now instead of catching up.
+ *
+ * Returns:
+ *    TRUE if a frame was drawn.
+ *
+ ****************************************************************************/
+tBool
+animUpdate(tAnim* pAnim)
+{
+  if ((tS32)(ms - pAnim->nextMs) < 0)
+    return FALSE;
+
+  animNext(pAnim);
+
+  pAnim->nextMs += pAnim->periodMs;
+  if ((tS32)(ms - pAnim->nextMs) >= 0)
+    pAnim->nextMs = ms + pAnim->periodMs;
+  return TRUE;
+}
@@ -0,0 +1,40 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    anim.h
+ *
+ * Description:
+ *    Expose the player for animations with delta frames.
+ *
+ *****************************************************************************/
+#ifndef _ANIM_H_
+#define _ANIM_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+typedef struct
+{
+  const tU8* pImg;          //animation container (img.h)
+  tU8  x;
+  tU8  y;
+  tU8  frame;               //frame on the screen
+  tU16 periodMs;            //time between frames
+  tU32 nextMs;              //time for the next frame
+} tAnim;
+
+
+void  animStart(tAnim* pAnim, tU8 x, tU8 y, const tU8* pImg, tU16 periodMs);
+void  animNext(tAnim* pAnim);
+tBool animUpdate(tAnim* pAnim);
+
+#endif
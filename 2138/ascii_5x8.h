@@ -0,0 +1,101 @@
+/*
+ * 5x8 characters (32 - 126) for the font compiler tools/fontc, one byte per
+ * pixel row, MSB is the leftmost pixel. Not included by the target code.
+ */
+const tU8 charMap5x8[] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	//32 - Space
+0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x20, 0x00,	//33 - !
+0x50, 0x50, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00,	//34 - "
+0x50, 0x50, 0xf8, 0x50, 0xf8, 0x50, 0x50, 0x00,	//35 - #
+0x20, 0x78, 0xa0, 0x70, 0x28, 0xf0, 0x20, 0x00,	//36 - $
+0xc0, 0xc8, 0x10, 0x20, 0x40, 0x98, 0x18, 0x00,	//37 - %
+0x40, 0xa0, 0xa0, 0x40, 0xa8, 0x90, 0x68, 0x00,	//38 - &
+0x60, 0x20, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,	//39 - '
+0x10, 0x20, 0x40, 0x40, 0x40, 0x20, 0x10, 0x00,	//40 - (
+0x40, 0x20, 0x10, 0x10, 0x10, 0x20, 0x40, 0x00,	//41 - )
+0x00, 0x20, 0xa8, 0x70, 0xa8, 0x20, 0x00, 0x00,	//42 - *
+0x00, 0x20, 0x20, 0xf8, 0x20, 0x20, 0x00, 0x00,	//43 - +
+0x00, 0x00, 0x00, 0x00, 0x60, 0x20, 0x40, 0x00,	//44 - ,
+0x00, 0x00, 0x00, 0xf8, 0x00, 0x00, 0x00, 0x00,	//45 - -
+0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00,	//46 - .
+0x00, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00,	//47 - /
+0x70, 0x88, 0x98, 0xa8, 0xc8, 0x88, 0x70, 0x00,	//48 - 0
+0x20, 0x60, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00,	//49 - 1
+0x70, 0x88, 0x08, 0x10, 0x20, 0x40, 0xf8, 0x00,	//50 - 2
+0xf8, 0x10, 0x20, 0x10, 0x08, 0x88, 0x70, 0x00,	//51 - 3
+0x10, 0x30, 0x50, 0x90, 0xf8, 0x10, 0x10, 0x00,	//52 - 4
+0xf8, 0x80, 0xf0, 0x08, 0x08, 0x88, 0x70, 0x00,	//53 - 5
+0x30, 0x40, 0x80, 0xf0, 0x88, 0x88, 0x70, 0x00,	//54 - 6
+0xf8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40, 0x00,	//55 - 7
+0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70, 0x00,	//56 - 8
+0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0x60, 0x00,	//57 - 9
+0x00, 0x60, 0x60, 0x00, 0x60, 0x60, 0x00, 0x00,	//58 - :
+0x00, 0x60, 0x60, 0x00, 0x60, 0x20, 0x40, 0x00,	//59 - ;
+0x08, 0x10, 0x20, 0x40, 0x20, 0x10, 0x08, 0x00,	//60 - <
+0x00, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0x00, 0x00,	//61 - =
+0x80, 0x40, 0x20, 0x10, 0x20, 0x40, 0x80, 0x00,	//62 - >
+0x70, 0x88, 0x08, 0x10, 0x20, 0x00, 0x20, 0x00,	//63 - ?
+0x70, 0x88, 0x08, 0x68, 0xa8, 0xa8, 0x70, 0x00,	//64 - @
+0x70, 0x88, 0x88, 0x88, 0xf8, 0x88, 0x88, 0x00,	//65 - A
+0xf0, 0x88, 0x88, 0xf0, 0x88, 0x88, 0xf0, 0x00,	//66 - B
+0x70, 0x88, 0x80, 0x80, 0x80, 0x88, 0x70, 0x00,	//67 - C
+0xe0, 0x90, 0x88, 0x88, 0x88, 0x90, 0xe0, 0x00,	//68 - D
+0xf8, 0x80, 0x80, 0xf0, 0x80, 0x80, 0xf8, 0x00,	//69 - E
+0xf8, 0x80, 0x80, 0xf0, 0x80, 0x80, 0x80, 0x00,	//70 - F
+0x70, 0x88, 0x80, 0xb8, 0x88, 0x88, 0x78, 0x00,	//71 - G
+0x88, 0x88, 0x88, 0xf8, 0x88, 0x88, 0x88, 0x00,	//72 - H
+0x70, 0x20, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00,	//73 - I
+0x38, 0x10, 0x10, 0x10, 0x10, 0x90, 0x60, 0x00,	//74 - J
+0x88, 0x90, 0xa0, 0xc0, 0xa0, 0x90, 0x88, 0x00,	//75 - K
+0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xf8, 0x00,	//76 - L
+0x88, 0xd8, 0xa8, 0xa8, 0x88, 0x88, 0x88, 0x00,	//77 - M
+0x88, 0x88, 0xc8, 0xa8, 0x98, 0x88, 0x88, 0x00,	//78 - N
+0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00,	//79 - O
+0xf0, 0x88, 0x88, 0xf0, 0x80, 0x80, 0x80, 0x00,	//80 - P
+0x70, 0x88, 0x88, 0x88, 0xa8, 0x90, 0x68, 0x00,	//81 - Q
+0xf0, 0x88, 0x88, 0xf0, 0xa0, 0x90, 0x88, 0x00,	//82 - R
+0x78, 0x80, 0x80, 0x70, 0x08, 0x08, 0xf0, 0x00,	//83 - S
+0xf8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00,	//84 - T
+0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00,	//85 - U
+0x88, 0x88, 0x88, 0x88, 0x88, 0x50, 0x20, 0x00,	//86 - V
+0x88, 0x88, 0x88, 0xa8, 0xa8, 0xa8, 0x50, 0x00,	//87 - W
+0x88, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x00,	//88 - X
+0x88, 0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x00,	//89 - Y
+0xf8, 0x08, 0x10, 0x20, 0x40, 0x80, 0xf8, 0x00,	//90 - Z
+0x70, 0x40, 0x40, 0x40, 0x40, 0x40, 0x70, 0x00,	//91 - [
+0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x00, 0x00,	//92 - Backslash
+0x70, 0x10, 0x10, 0x10, 0x10, 0x10, 0x70, 0x00,	//93 - ]
+0x20, 0x50, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00,	//94 - ^
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x00,	//95 - _
+0x40, 0x20, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,	//96 - `
+0x00, 0x00, 0x70, 0x08, 0x78, 0x88, 0x78, 0x00,	//97 - a
+0x80, 0x80, 0xb0, 0xc8, 0x88, 0x88, 0xf0, 0x00,	//98 - b
+0x00, 0x00, 0x70, 0x80, 0x80, 0x88, 0x70, 0x00,	//99 - c
+0x08, 0x08, 0x68, 0x98, 0x88, 0x88, 0x78, 0x00,	//100 - d
+0x00, 0x00, 0x70, 0x88, 0xf8, 0x80, 0x70, 0x00,	//101 - e
+0x30, 0x48, 0x40, 0xe0, 0x40, 0x40, 0x40, 0x00,	//102 - f
+0x00, 0x78, 0x88, 0x88, 0x78, 0x08, 0x70, 0x00,	//103 - g
+0x80, 0x80, 0xb0, 0xc8, 0x88, 0x88, 0x88, 0x00,	//104 - h
+0x20, 0x00, 0x60, 0x20, 0x20, 0x20, 0x70, 0x00,	//105 - i
+0x10, 0x00, 0x30, 0x10, 0x10, 0x90, 0x60, 0x00,	//106 - j
+0x80, 0x80, 0x90, 0xa0, 0xc0, 0xa0, 0x90, 0x00,	//107 - k
+0x60, 0x20, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00,	//108 - l
+0x00, 0x00, 0xd0, 0xa8, 0xa8, 0x88, 0x88, 0x00,	//109 - m
+0x00, 0x00, 0xb0, 0xc8, 0x88, 0x88, 0x88, 0x00,	//110 - n
+0x00, 0x00, 0x70, 0x88, 0x88, 0x88, 0x70, 0x00,	//111 - o
+0x00, 0x00, 0xf0, 0x88, 0xf0, 0x80, 0x80, 0x00,	//112 - p
+0x00, 0x00, 0x68, 0x98, 0x78, 0x08, 0x08, 0x00,	//113 - q
+0x00, 0x00, 0xb0, 0xc8, 0x80, 0x80, 0x80, 0x00,	//114 - r
+0x00, 0x00, 0x70, 0x80, 0x70, 0x08, 0xf0, 0x00,	//115 - s
+0x40, 0x40, 0xe0, 0x40, 0x40, 0x48, 0x30, 0x00,	//116 - t
+0x00, 0x00, 0x88, 0x88, 0x88, 0x98, 0x68, 0x00,	//117 - u
+0x00, 0x00, 0x88, 0x88, 0x88, 0x50, 0x20, 0x00,	//118 - v
+0x00, 0x00, 0x88, 0x88, 0xa8, 0xa8, 0x50, 0x00,	//119 - w
+0x00, 0x00, 0x88, 0x50, 0x20, 0x50, 0x88, 0x00,	//120 - x
+0x00, 0x00, 0x88, 0x88, 0x78, 0x08, 0x70, 0x00,	//121 - y
+0x00, 0x00, 0xf8, 0x10, 0x20, 0x40, 0xf8, 0x00,	//122 - z
+0x10, 0x20, 0x20, 0x40, 0x20, 0x20, 0x10, 0x00,	//123 - {
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00,	//124 - |
+0x40, 0x20, 0x20, 0x10, 0x20, 0x20, 0x40, 0x00,	//125 - }
+0x00, 0x00, 0x00, 0x68, 0x90, 0x00, 0x00, 0x00	//126 - ~
+};
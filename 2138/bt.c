@@ -25,6 +25,8 @@
 #include "uart.h"
 #include "hw.h"
 #include "select.h"
+#include "term.h"
+#include "ui.h"
 
 /******************************************************************************
  * Typedefs and defines
@@ -54,7 +56,22 @@ static tU8 pidBt;
 static volatile tBool stopRecvProc = FALSE;
 static tCntSem recvSem;
 
-static tU8 btCursor = 0;
+//Bluetooth menu
+static tUiWidget btScreen;
+static tUiWidget btPanel;
+static tUiWidget btList;
+static tUiWidget btStatTitle;
+static tUiWidget btStatLabel;
+static tUiWidget btModeLabel;
+static const char* btItems[] =
+{
+  "Inquiry",
+  "Set name",
+  "Set address",
+  "Set comm.mode",
+  "Deactivate BT",
+  "Main menu"
+};
 
 static tBool btSleepState = FALSE;
 static tBool btCommandMode = FALSE;
@@ -164,6 +181,7 @@ procBt(void* arg)
       if (consolGetChar(&rxChar) == TRUE)
       {
         uart1SendChar(rxChar);
+        termPutchar(rxChar);
         nothing = FALSE;
       }
 
@@ -171,11 +189,16 @@ procBt(void* arg)
       if (uart1GetChar(&rxChar) == TRUE)
       {
         printf("%c", rxChar);
+        termPutchar(rxChar);
         nothing = FALSE;
       }
         
       if (nothing == TRUE)
+      {
+        //show the collected traffic on the LCD console (if open)
+        termFlush();
         osSleep(1);
+      }
     }
     stopRecvProc = FALSE;
   }
@@ -200,40 +223,6 @@ displayMessage(tU8 *pMessage, tU8 speed)
 }
 
 
-/*****************************************************************************
- *
- * Description:
- *    Prints the list of 'found' Bluetooth units
- *
- ****************************************************************************/
-static void
-drawBtsFound(tBool drawCursor, tU8 cursorPos)
-{
-  tU32 row;
-
-  for(row=0; row<MAX_BT_UNITS; row++)
-  {
-    lcdGotoxy(2,30+(14*row));
-    if(foundBtUnits[row].active == FALSE)
-    {
-      if ((drawCursor == TRUE) && (cursorPos == row))
-        lcdColor(BT_BACKGROUND_COLOR+1,0xe0);
-      else
-        lcdColor(BT_BACKGROUND_COLOR,0xfd);
-      lcdPuts("-");
-    }
-    else
-    {
-      if ((drawCursor == TRUE) && (cursorPos == row))
-        lcdColor(BT_BACKGROUND_COLOR+1,0xe0);
-      else
-        lcdColor(BT_BACKGROUND_COLOR,0xfd);
-      lcdPuts(foundBtUnits[row].btAddress);
-    }
-  }
-}
-
-
 /*****************************************************************************
  *
  * Description:
@@ -255,19 +244,26 @@ btInquiry(void)
   tU8  foundBt;
   tU32 cnt;
   tU8  numServices;
+  tUiWidget   found;
+  const char* foundItems[MAX_BT_UNITS];
 
   for(foundBt=0; foundBt<MAX_BT_UNITS; foundBt++)
   {
     foundBtUnits[foundBt].active = FALSE;
     foundBtUnits[foundBt].btName[0] = '\0';
+    foundItems[foundBt] = "-";
   }
 
+  //list of found units, no cursor until the inquiry is done
+  uiList(&found, 2, 30, 12, foundItems, MAX_BT_UNITS,
+         BT_BACKGROUND_COLOR, 0xfd, BT_BACKGROUND_COLOR, 0xfd);
+
   //clear menu screen
   lcdRect(1, 16, 126, 84, BT_BACKGROUND_COLOR);
   lcdGotoxy(18,16);
   lcdColor(BT_BACKGROUND_COLOR,0xfd);
   lcdPuts("Inquiry");
-  drawBtsFound(FALSE,0);
+  uiDraw(&found);
 
   //stop the BT handling process
   stopRecvProc = TRUE;
@@ -312,7 +308,8 @@ btInquiry(void)
             foundBt++;
 
             //display newly found bt unit
-            drawBtsFound(FALSE, 0);
+            uiListSetItem(&found, foundBt - 1, (char*)foundBtUnits[foundBt - 1].btAddress);
+            uiDraw(&found);
           }
         }
         else if (memcmp(recvBuf, "+BTINQ: COMPLETE", 16) == 0)
@@ -350,11 +347,13 @@ btInquiry(void)
   //* Handle user key inputs (move between discovered units)
   //*************************************************************
   done = FALSE;
-  cursorPos = 0;
-  drawBtsFound(TRUE, cursorPos);
+  found.selBkgColor = BT_BACKGROUND_COLOR+1;
+  found.selColor    = 0xe0;
+  uiInvalidateAll(&found);
+  uiDraw(&found);
   while(done == FALSE)
   {
-    anyKey = checkKey();
+    anyKey = waitKey(0);
     if (anyKey != KEY_NOTHING)
     {
       //exit and save new name
@@ -366,25 +365,19 @@ btInquiry(void)
       //
       else if (anyKey == KEY_UP)
       {
-        if (cursorPos > 0)
-          cursorPos--;
-        else
-          cursorPos = MAX_BT_UNITS-1;
-        drawBtsFound(TRUE, cursorPos);
+        uiListMove(&found, -1);
+        uiDraw(&found);
       }
       
       //
       else if (anyKey == KEY_DOWN)
       {
-        if (cursorPos < MAX_BT_UNITS-1)
-          cursorPos++;
-        else
-          cursorPos = 0;
-          drawBtsFound(TRUE, cursorPos);
+        uiListMove(&found, 1);
+        uiDraw(&found);
       }
     }
-    osSleep(1);
   }
+  cursorPos = found.cursor;
 
   //*************************************************************
   //* Get name of selected (discovered) bt unit
@@ -509,14 +502,7 @@ btInquiry(void)
     }
 
     //wait for key press
-    done = FALSE;
-    while(done == FALSE)
-    {
-      anyKey = checkKey();
-      if (anyKey != KEY_NOTHING)
-        done = TRUE;
-      osSleep(1);
-    }
+    waitKey(0);
   }
   
   //erase screen
@@ -645,7 +631,7 @@ btSetAddress(void)
   drawBtAddress(cursorPos);
   while(done == FALSE)
   {
-    anyKey = checkKey();
+    anyKey = waitKey(0);
     if (anyKey != KEY_NOTHING)
     {
       //exit and save new address
@@ -724,7 +710,6 @@ btSetAddress(void)
         drawBtAddress(cursorPos);
       }
     }
-    osSleep(1);
   }
 
   osSleep(100);
@@ -850,7 +835,7 @@ btSetName(void)
   drawBtName(cursorPos);
   while(done == FALSE)
   {
-    anyKey = checkKey();
+    anyKey = waitKey(0);
     if (anyKey != KEY_NOTHING)
     {
       //exit and save new name
@@ -941,7 +926,6 @@ btSetName(void)
         drawBtName(cursorPos);
       }
     }
-    osSleep(1);
   }
 
   osSleep(100);
@@ -1084,74 +1068,46 @@ btMode(void)
 /*****************************************************************************
  *
  * Description:
- *    Draw cursor in main menu
- *
- * Params:
- *    [in] cursor - Cursor positions
+ *    Update the texts of the Bluetooth menu that depend on the state,
+ *    only the changed texts are drawn again.
  *
  ****************************************************************************/
 static void
-drawBtMenuCursor(tU8 cursor)
+updateBtMenu(void)
 {
-  tU32 row;
-
-  for(row=0; row<=5; row++)
-  {
-    lcdGotoxy(7,16+(14*row));
-    if(row == btCursor)
-      lcdColor(BT_BACKGROUND_COLOR,0xe0);
-    else
-      lcdColor(BT_BACKGROUND_COLOR,0xfd);
-    
-    switch(row)
-    {
-      case 0: lcdPuts("Inquiry"); break;
-      case 1: lcdPuts("Set name"); break;
-      case 2: lcdPuts("Set address"); break;
-      case 3: if (btCommandMode == FALSE) lcdPuts("Set comm.mode"); else lcdPuts("Set data mode"); break;
-      case 4: if (btSleepState == FALSE) lcdPuts("Deactivate BT"); else lcdPuts("Activate BT"); break;
-      case 5: lcdPuts("Main menu"); break;
-      default: break;
-    }
-  }
+  uiListSetItem(&btList, 3, (btCommandMode == FALSE) ? "Set comm.mode" : "Set data mode");
+  uiListSetItem(&btList, 4, (btSleepState == FALSE) ? "Deactivate BT" : "Activate BT");
+  uiLabelSet(&btStatLabel, (btSleepState == FALSE) ? "Active" : "Inactive");
+  uiLabelSet(&btModeLabel, (btCommandMode == FALSE) ? "Data mode" : "Command mode");
 }
 
 
 /*****************************************************************************
  *
  * Description:
- *    Draw main menu
+ *    Create the widgets of the Bluetooth menu, the cursor position is
+ *    kept from the last time.
  *
  ****************************************************************************/
 static void
-drawBtMenu(void)
+initBtMenu(void)
 {
-  lcdColor(0,0);
-  lcdClrscr();
+  tU8 cursor = btList.cursor;
 
-  lcdRect(255, 255, 130, 130, BT_BACKBACKGROUND_COLOR);
-  lcdRect(1, 16, 126, 84, BT_BACKGROUND_COLOR);
-
-  lcdGotoxy(8,0);
-  lcdColor(BT_BACKBACKGROUND_COLOR,0);
-  lcdPuts("BLUETOOTH MENU");
-  drawBtMenuCursor(btCursor);
-  
-  //display sleep status
-  lcdGotoxy(0,101);
-  lcdColor(BT_BACKBACKGROUND_COLOR,0x00);
-  lcdPuts("BT stat:");
-  lcdColor(BT_BACKBACKGROUND_COLOR,0xfd);
-  if (btSleepState == FALSE)
-    lcdPuts("Active");
-  else
-    lcdPuts("Inactive");
-
-  lcdGotoxy(32,115);
-  if (btCommandMode == FALSE)
-    lcdPuts("Data mode");
-  else
-    lcdPuts("Command mode");
+  uiFrame(&btScreen, 0, 0, 130, 130, BT_BACKBACKGROUND_COLOR);
+  uiFrameHeader(&btScreen, "BLUETOOTH MENU", 8, 0, 0);
+  uiFrame(&btPanel, 1, 16, 126, 84, BT_BACKGROUND_COLOR);
+  uiList(&btList, 7, 16, 15, btItems, 6, BT_BACKGROUND_COLOR, 0xfd, BT_BACKGROUND_COLOR, 0xe0);
+  uiListSetCursor(&btList, cursor);
+  uiLabel(&btStatTitle, 0, 101, 8, "BT stat:", BT_BACKBACKGROUND_COLOR, 0x00);
+  uiLabel(&btStatLabel, 64, 101, 8, NULL, BT_BACKBACKGROUND_COLOR, 0xfd);
+  uiLabel(&btModeLabel, 32, 115, 12, NULL, BT_BACKBACKGROUND_COLOR, 0xfd);
+  uiAdd(&btScreen, &btPanel);
+  uiAdd(&btPanel, &btList);
+  uiAdd(&btScreen, &btStatTitle);
+  uiAdd(&btScreen, &btStatLabel);
+  uiAdd(&btScreen, &btModeLabel);
+  updateBtMenu();
 }
 
 
@@ -1167,19 +1123,20 @@ handleBt(void)
   tU8 exit = FALSE;
 
   //print menu
-  drawBtMenu();
+  initBtMenu();
+  uiDraw(&btScreen);
   
   while(exit == FALSE)
   {
     tU8 anyKey;
 
-    anyKey = checkKey();
+    anyKey = waitKey(0);
     if (anyKey != KEY_NOTHING)
     {
       //select specific function
       if (anyKey == KEY_CENTER)
       {
-        switch(btCursor)
+        switch(btList.cursor)
         {
           case 0: btInquiry(); break;
           case 1: btSetName(); break;
@@ -1189,34 +1146,60 @@ handleBt(void)
           case 5: exit = TRUE; break;
           default: break;
         }
-        drawBtMenu();
+
+        //the functions only draw inside the menu frame
+        if (exit == FALSE)
+        {
+          updateBtMenu();
+          uiInvalidate(&btScreen, 1, 16, 126, 84);
+          uiDraw(&btScreen);
+        }
       }
       
       //move cursor up
       else if (anyKey == KEY_UP)
       {
-        if (btCursor > 0)
-          btCursor--;
-        else
-          btCursor = 5;
-        drawBtMenuCursor(btCursor);
+        uiListMove(&btList, -1);
+        uiDraw(&btList);
       }
       
       //move cursor down
       else if (anyKey == KEY_DOWN)
       {
-        if (btCursor < 5)
-          btCursor++;
-        else
-          btCursor = 0;
-        drawBtMenuCursor(btCursor);
+        uiListMove(&btList, 1);
+        uiDraw(&btList);
       }
     }
-    osSleep(1);
   }
 }
 
 
+/*****************************************************************************
+ *
+ * Description:
+ *    Shows the traffic between the terminal and the BGB203-S06 unit
+ *    (e.g. AT commands and responses) on the LCD until a key is pressed.
+ *
+ ****************************************************************************/
+void
+btTerminal(void)
+{
+  lcdColor(0,0);
+  lcdClrscr();
+
+  lcdRect(0, 0, 130, 15, BT_BACKBACKGROUND_COLOR);
+  lcdGotoxy(20,1);
+  lcdColor(BT_BACKBACKGROUND_COLOR,0xfd);
+  lcdPuts("BT terminal");
+
+  termOpen(16, 8, BT_BACKGROUND_COLOR, 0xfd);
+
+  waitKey(0);
+
+  termClose();
+}
+
+
 /*****************************************************************************
  *
  * Description:
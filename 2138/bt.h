@@ -16,6 +16,7 @@
 
 void initBtProc(void);
 void handleBt(void);
+void btTerminal(void);
 void blockBtProc(void);
 void activateBtProc(void);
 
@@ -25,6 +25,7 @@
 #include "../lcd.h"
 #include "../key.h"
 #include "../select.h"
+#include "../lcdCapture.h"
 #include "chess.h"
 #include "pieces.h"
 #include "M6502.h"
@@ -159,7 +160,10 @@ drawPiece(tU8 i, tU8 j, char piece)
 	/*
 	 * Create the bitmap of a complete field on the board.
 	 * this includes the background.
+	 * lcdIcon() only queues the bitmap, so wait until the previous
+	 * field has been sent before it is overwritten.
 	 */
+	lcdFlush();
 	bptr = bitmap;
 	for(x=0; x<((FIELD_WIDTH*HEIGHT_OFFS)+WIDTH_OFFS); x++)
 	{
@@ -209,7 +213,8 @@ drawPiece(tU8 i, tU8 j, char piece)
 			bptr++;
 		}
 	}
-	for(x=0; x<((FIELD_WIDTH*HEIGHT_OFFS)+WIDTH_OFFS); x++)
+	// the right offset of the last row is already written
+	for(x=0; x<((FIELD_WIDTH*HEIGHT_OFFS)-WIDTH_OFFS); x++)
 	{
 		*bptr = background;
 		bptr++;
@@ -366,7 +371,7 @@ void getUserMove()
 	 */
 	do
 	{
-		key = checkKey();
+		key = waitKey(0);
 		if(key != KEY_NOTHING)
 		{
 			drawBorderPiece(cursor & 7, cursor >> 3, ram[cursor], 0);
@@ -400,7 +405,7 @@ void getUserMove()
 	found = 0;
 	do
 	{
-		key = checkKey();
+		key = waitKey(0);
 		if(key != KEY_NOTHING)
 		{
 			if(cursor != from)
@@ -617,7 +622,9 @@ byte Patch6502(register byte Op,register M6502 *R)
 			printf("%c", R->A);
 			break;
 		case 0x12: // Print board, is placed right before the first JSR INALL
+			LCD_CAPTURE_BEGIN("chess");
 			showBoard();
+			LCD_CAPTURE_STOP();
 			idx=0;
 			if(ram[0x88] == 8)
 			{
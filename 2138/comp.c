@@ -0,0 +1,356 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    comp.c
+ *
+ * Description:
+ *    Tile based off-screen compositor. Drawing is done in a RAM buffer
+ *    that is divided in 10x10 tiles, every tile that is drawn in is marked
+ *    dirty, and compPresent() sends only the dirty tiles to the LCD (with
+ *    lcdIcon(), one window per tile). The buffer is stored tile by tile so
+ *    that a tile can be sent directly from the buffer.
+ *
+ *    With enough RAM (LPC2136/LPC2138) the buffer holds the whole screen.
+ *    On the other variants it holds a strip of COMP_BAND_ROWS tile rows:
+ *    drawing outside compPresent() only marks tiles dirty, and
+ *    compPresent() calls the paint function once for every strip that has
+ *    dirty tiles, with drawing clipped to that strip. The paint function
+ *    shall draw the complete scene with the comp functions. A paint
+ *    function is not needed (and not called) with a full screen buffer.
+ *
+ *    The module only uses lcdIcon() and lcdFlush() from lcd.c, so it can
+ *    be built on a host against an in-memory panel (host/fakePanel.c).
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "comp.h"
+#include "lcd.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define TILE_PIXELS   (COMP_TILE_SIZE * COMP_TILE_SIZE)
+#define NO_BAND       0xff
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tU8   buffer[COMP_BAND_ROWS * COMP_TILES * TILE_PIXELS];
+static tU16  dirty[COMP_TILES];          //one bit per tile, per tile row
+static tU8   bkgColor;
+static tBool presentPending = FALSE;     //tiles still referenced by display list
+#ifdef COMP_FULL_BUFFER
+static tU8   bandRow = 0;                //first tile row in buffer
+#else
+static tU8   bandRow = NO_BAND;
+static tBool painting = FALSE;
+#endif
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static void compSync(void);
+static void markDirty(tU8 x, tU8 y, tU8 xLen, tU8 yLen);
+static tU8* pixelAddr(tU8 x, tU8 y);
+static void fillBand(tU8 color);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait until the tiles sent by the last compPresent() have left the
+ *    buffer (the display list refers to the buffer).
+ *
+ ****************************************************************************/
+static void
+compSync(void)
+{
+  if (presentPending == TRUE)
+  {
+    lcdFlush();
+    presentPending = FALSE;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Mark all tiles that overlap an area as dirty.
+ *
+ ****************************************************************************/
+static void
+markDirty(tU8 x, tU8 y, tU8 xLen, tU8 yLen)
+{
+  tU8  tx0, tx1, ty0, ty1;
+  tU16 mask;
+
+#ifndef COMP_FULL_BUFFER
+  //the paint function redraws tiles that are already dirty
+  if (painting == TRUE)
+    return;
+#endif
+
+  if ((xLen == 0) || (yLen == 0) || (x >= 130) || (y >= 130))
+    return;
+
+  tx0 = x / COMP_TILE_SIZE;
+  ty0 = y / COMP_TILE_SIZE;
+  tx1 = (x + xLen - 1 >= 130) ? COMP_TILES - 1 : (x + xLen - 1) / COMP_TILE_SIZE;
+  ty1 = (y + yLen - 1 >= 130) ? COMP_TILES - 1 : (y + yLen - 1) / COMP_TILE_SIZE;
+
+  mask = ((1 << (tx1 + 1)) - 1) & ~((1 << tx0) - 1);
+  for(; ty0 <= ty1; ty0++)
+    dirty[ty0] |= mask;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the buffer address of a pixel.
+ *
+ * Returns:
+ *    NULL if the pixel is outside the screen or not in the buffer.
+ *
+ ****************************************************************************/
+static tU8*
+pixelAddr(tU8 x, tU8 y)
+{
+  tU8 tx, ty;
+
+  if ((x >= 130) || (y >= 130) || (bandRow == NO_BAND))
+    return NULL;
+
+  tx = x / COMP_TILE_SIZE;
+  ty = y / COMP_TILE_SIZE;
+  if ((ty < bandRow) || (ty >= bandRow + COMP_BAND_ROWS))
+    return NULL;
+
+  return &buffer[((ty - bandRow) * COMP_TILES + tx) * TILE_PIXELS +
+                 (y - ty * COMP_TILE_SIZE) * COMP_TILE_SIZE +
+                 (x - tx * COMP_TILE_SIZE)];
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Fill the whole buffer with one color.
+ *
+ ****************************************************************************/
+static void
+fillBand(tU8 color)
+{
+  tU32 i;
+
+  for(i=0; i<sizeof(buffer); i++)
+    buffer[i] = color;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize the compositor. The screen is cleared to color at the
+ *    next compPresent().
+ *
+ ****************************************************************************/
+void
+compInit(tU8 color)
+{
+  tU8 i;
+
+  compSync();
+
+  bkgColor = color;
+#ifdef COMP_FULL_BUFFER
+  fillBand(color);
+#endif
+
+  for(i=0; i<COMP_TILES; i++)
+    dirty[i] = (1 << COMP_TILES) - 1;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a rectangular area with specified color.
+ *
+ ****************************************************************************/
+void
+compRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color)
+{
+  tU8  tx, ty;
+  tU8  xs, xe, ys, ye;
+  tU8  x1, y1;
+  tU8  i, j;
+  tU8* pTile;
+
+  markDirty(x, y, xLen, yLen);
+
+  if (bandRow == NO_BAND)
+    return;
+  compSync();
+
+  //clip to the part of the screen that is in the buffer
+  x1 = (x + xLen > 130) ? 130 : x + xLen;
+  y1 = (y + yLen > 130) ? 130 : y + yLen;
+  if (y < bandRow * COMP_TILE_SIZE)
+    y = bandRow * COMP_TILE_SIZE;
+  if (y1 > (bandRow + COMP_BAND_ROWS) * COMP_TILE_SIZE)
+    y1 = (bandRow + COMP_BAND_ROWS) * COMP_TILE_SIZE;
+
+  //fill tile by tile
+  for(ty = y / COMP_TILE_SIZE; ty * COMP_TILE_SIZE < y1; ty++)
+  {
+    ys = (y > ty * COMP_TILE_SIZE) ? y - ty * COMP_TILE_SIZE : 0;
+    ye = (y1 < (ty + 1) * COMP_TILE_SIZE) ? y1 - ty * COMP_TILE_SIZE : COMP_TILE_SIZE;
+
+    for(tx = x / COMP_TILE_SIZE; tx * COMP_TILE_SIZE < x1; tx++)
+    {
+      xs = (x > tx * COMP_TILE_SIZE) ? x - tx * COMP_TILE_SIZE : 0;
+      xe = (x1 < (tx + 1) * COMP_TILE_SIZE) ? x1 - tx * COMP_TILE_SIZE : COMP_TILE_SIZE;
+
+      pTile = &buffer[((ty - bandRow) * COMP_TILES + tx) * TILE_PIXELS];
+      for(j=ys; j<ye; j++)
+        for(i=xs; i<xe; i++)
+          pTile[j * COMP_TILE_SIZE + i] = color;
+    }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw rectangular area from bitmap, same format as lcdIcon().
+ *
+ ****************************************************************************/
+void
+compIcon(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData)
+{
+  tU8  i, j;
+  tU8  runLeft = 0;
+  tU8  color   = 0;
+  tU8* pPixel;
+
+  markDirty(x, y, xLen, yLen);
+
+  if (bandRow == NO_BAND)
+    return;
+  compSync();
+
+  for(j=0; j<yLen; j++)
+  {
+    for(i=0; i<xLen; i++)
+    {
+      if (compressionOn == FALSE)
+        color = *pData++;
+      else
+      {
+        while(runLeft == 0)
+        {
+          if (*pData == escapeChar)
+          {
+            runLeft = pData[1];
+            color   = pData[2];
+            pData  += 3;
+          }
+          else
+          {
+            runLeft = 1;
+            color   = *pData++;
+          }
+        }
+        runLeft--;
+      }
+
+      pPixel = pixelAddr(x + i, y + j);
+      if (pPixel != NULL)
+        *pPixel = color;
+    }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Mark an area as changed without drawing in it. Useful with a strip
+ *    buffer when the paint function draws the new content.
+ *
+ ****************************************************************************/
+void
+compInvalidate(tU8 x, tU8 y, tU8 xLen, tU8 yLen)
+{
+  markDirty(x, y, xLen, yLen);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send all dirty tiles to the LCD. Returns when the tiles have been
+ *    queued in the display list; the next comp call waits until they have
+ *    been sent.
+ *
+ * Params:
+ *    [in] pPaint - function that draws the complete scene with the comp
+ *                  functions (only used with a strip buffer)
+ *
+ ****************************************************************************/
+void
+compPresent(void (*pPaint)(void))
+{
+  tU8 band;
+  tU8 tx, ty;
+
+  for(band=0; band<COMP_TILES; band+=COMP_BAND_ROWS)
+  {
+    tU16 bandDirty = 0;
+
+    for(ty=band; (ty < band + COMP_BAND_ROWS) && (ty < COMP_TILES); ty++)
+      bandDirty |= dirty[ty];
+    if (bandDirty == 0)
+      continue;
+
+#ifndef COMP_FULL_BUFFER
+    //render the strip
+    compSync();
+    bandRow = band;
+    fillBand(bkgColor);
+    if (pPaint != NULL)
+    {
+      painting = TRUE;
+      (*pPaint)();
+      painting = FALSE;
+    }
+#endif
+
+    for(ty=band; (ty < band + COMP_BAND_ROWS) && (ty < COMP_TILES); ty++)
+    {
+      for(tx=0; tx<COMP_TILES; tx++)
+        if (dirty[ty] & (1 << tx))
+          lcdIcon(tx * COMP_TILE_SIZE, ty * COMP_TILE_SIZE,
+                  COMP_TILE_SIZE, COMP_TILE_SIZE, FALSE, 0,
+                  &buffer[((ty - band) * COMP_TILES + tx) * TILE_PIXELS]);
+      dirty[ty] = 0;
+    }
+    presentPending = TRUE;
+  }
+
+#ifndef COMP_FULL_BUFFER
+  bandRow = NO_BAND;
+#endif
+}
@@ -0,0 +1,46 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    comp.h
+ *
+ * Description:
+ *    Expose the tile based off-screen compositor.
+ *
+ *****************************************************************************/
+#ifndef _COMP_H_
+#define _COMP_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define COMP_TILE_SIZE   10     //tiles are 10x10 pixels
+#define COMP_TILES       13     //tiles per row and column (130 pixels)
+
+//number of tile rows kept in RAM
+#if defined(LPC2136) || defined(LPC2138)
+#define COMP_BAND_ROWS   COMP_TILES   //whole screen (16900 bytes)
+#else
+#define COMP_BAND_ROWS   2            //strip of 20 lines (2600 bytes)
+#endif
+
+#if (COMP_BAND_ROWS == COMP_TILES)
+#define COMP_FULL_BUFFER
+#endif
+
+
+void compInit(tU8 color);
+void compRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color);
+void compIcon(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData);
+void compInvalidate(tU8 x, tU8 y, tU8 xLen, tU8 yLen);
+void compPresent(void (*pPaint)(void));
+
+#endif
@@ -0,0 +1,493 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    draw.c
+ *
+ * Description:
+ *    Lines, circles and polygons on top of lcdRect(). The shapes are
+ *    rasterized to horizontal or vertical spans and every span is sent
+ *    as one rectangle (one window and a burst of pixels), never one
+ *    window per pixel:
+ *
+ *    - lines are split into the runs of the Bresenham algorithm, along
+ *      the major axis,
+ *    - circles and filled shapes are rasterized row by row, and equal
+ *      spans on consecutive rows are merged into one rectangle, so the
+ *      steep parts of an outline and the straight parts of a filled
+ *      shape also cost one window each.
+ *
+ *    A pixel (x,y) is inside a circle if dx*dx + dy*dy <= r*r + r.
+ *    Polygons are filled with the even-odd rule and the top-left rule
+ *    (a 10x10 square from 0,0 to 10,10 fills the pixels 0..9), the
+ *    outline functions also draw the end points.
+ *
+ *    The span merging uses static state, so only one process at a time
+ *    may draw with these functions.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "draw.h"
+#include "lcd.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define SCREEN_SIZE 130
+#define MAX_SPANS   (DRAW_MAX_VERTICES / 2)    //spans on one row
+
+//open rectangle, grows downwards as long as the rows have the same span
+typedef struct
+{
+  tS16 x;
+  tS16 xLen;
+  tS16 y;
+  tS16 yLen;
+} tSpan;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tSpan open[MAX_SPANS];
+static tU8   numOpen;
+static tU8   batchColor;
+
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static void span(tS16 x, tS16 y, tS16 xLen, tS16 yLen, tU8 color);
+static void batchStart(tU8 color);
+static void batchRow(tS16 y, tS16* pEdges, tU8 spans);
+static void batchEnd(void);
+static tS16 circleWidth(tS16 w, tS32 limit);
+static void circle(tS16 xc, tS16 yc, tU8 r, tU8 color, tBool fill);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a rectangle clipped to the screen.
+ *
+ ****************************************************************************/
+static void
+span(tS16 x, tS16 y, tS16 xLen, tS16 yLen, tU8 color)
+{
+  if (x < 0)
+  {
+    xLen += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    yLen += y;
+    y = 0;
+  }
+  if (x + xLen > SCREEN_SIZE)
+    xLen = SCREEN_SIZE - x;
+  if (y + yLen > SCREEN_SIZE)
+    yLen = SCREEN_SIZE - y;
+
+  if (xLen > 0 && yLen > 0)
+    lcdRect(x, y, xLen, yLen, color);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start row by row output, see batchRow().
+ *
+ ****************************************************************************/
+static void
+batchStart(tU8 color)
+{
+  numOpen    = 0;
+  batchColor = color;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Add the spans of one row. A span that is equal to an open rectangle
+ *    ending on the row above extends it, the open rectangles that are not
+ *    extended are drawn. Rows must come in increasing order.
+ *
+ * Params:
+ *    [in] y      - row
+ *    [in] pEdges - start and end (exclusive) of each span, left to right
+ *    [in] spans  - number of spans, at most MAX_SPANS
+ *
+ ****************************************************************************/
+static void
+batchRow(tS16 y, tS16* pEdges, tU8 spans)
+{
+  tU16 extended = 0;
+  tU8  i;
+  tU8  j;
+
+  //clip to the screen, empty spans get xLen <= 0 and are skipped
+  for(j = 0; j < spans; j++)
+  {
+    if (pEdges[2*j] < 0)
+      pEdges[2*j] = 0;
+    if (pEdges[2*j + 1] > SCREEN_SIZE)
+      pEdges[2*j + 1] = SCREEN_SIZE;
+  }
+
+  i = 0;
+  while (i < numOpen)
+  {
+    for(j = 0; j < spans; j++)
+    {
+      if ((extended & (1 << j)) == 0 &&
+          open[i].x == pEdges[2*j] &&
+          open[i].xLen == pEdges[2*j + 1] - pEdges[2*j] &&
+          open[i].y + open[i].yLen == y)
+        break;
+    }
+
+    if (j < spans)
+    {
+      open[i].yLen++;
+      extended |= 1 << j;
+      i++;
+    }
+    else
+    {
+      span(open[i].x, open[i].y, open[i].xLen, open[i].yLen, batchColor);
+      open[i] = open[--numOpen];
+    }
+  }
+
+  for(j = 0; j < spans; j++)
+  {
+    tS16 xLen = pEdges[2*j + 1] - pEdges[2*j];
+
+    if ((extended & (1 << j)) != 0 || xLen <= 0)
+      continue;
+
+    open[numOpen].x    = pEdges[2*j];
+    open[numOpen].xLen = xLen;
+    open[numOpen].y    = y;
+    open[numOpen].yLen = 1;
+    numOpen++;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw all open rectangles.
+ *
+ ****************************************************************************/
+static void
+batchEnd(void)
+{
+  while (numOpen > 0)
+  {
+    numOpen--;
+    span(open[numOpen].x, open[numOpen].y, open[numOpen].xLen, open[numOpen].yLen, batchColor);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a line, including both end points. The line is drawn as one
+ *    span per row (mostly horizontal lines) or per column (mostly
+ *    vertical lines). The pixels do not depend on the direction.
+ *
+ ****************************************************************************/
+void
+drawLine(tS16 x0, tS16 y0, tS16 x1, tS16 y1, tU8 color)
+{
+  tS16 dx;
+  tS16 dy;
+  tS16 step;
+  tS16 err;
+  tS16 start;
+  tS16 t;
+
+  //completely outside on one side
+  if ((x0 < 0 && x1 < 0) || (y0 < 0 && y1 < 0) ||
+      (x0 >= SCREEN_SIZE && x1 >= SCREEN_SIZE) || (y0 >= SCREEN_SIZE && y1 >= SCREEN_SIZE))
+    return;
+
+  dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+  dy = (y1 > y0) ? y1 - y0 : y0 - y1;
+
+  if (dx >= dy)
+  {
+    //mostly horizontal, from left to right
+    if (x0 > x1)
+    {
+      t = x0; x0 = x1; x1 = t;
+      t = y0; y0 = y1; y1 = t;
+    }
+    step  = (y1 > y0) ? 1 : -1;
+    err   = dx / 2;
+    start = x0;
+    for(; x0 < x1; x0++)
+    {
+      err -= dy;
+      if (err < 0)
+      {
+        span(start, y0, x0 - start + 1, 1, color);
+        y0   += step;
+        err  += dx;
+        start = x0 + 1;
+      }
+    }
+    span(start, y0, x1 - start + 1, 1, color);
+  }
+  else
+  {
+    //mostly vertical, from top to bottom
+    if (y0 > y1)
+    {
+      t = x0; x0 = x1; x1 = t;
+      t = y0; y0 = y1; y1 = t;
+    }
+    step  = (x1 > x0) ? 1 : -1;
+    err   = dy / 2;
+    start = y0;
+    for(; y0 < y1; y0++)
+    {
+      err -= dx;
+      if (err < 0)
+      {
+        span(x0, start, 1, y0 - start + 1, color);
+        x0   += step;
+        err  += dy;
+        start = y0 + 1;
+      }
+    }
+    span(x0, start, 1, y1 - start + 1, color);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Adjust the half width w of a circle row to the largest value with
+ *    w * w <= limit (-1 if limit < 0). w changes little between rows.
+ *
+ ****************************************************************************/
+static tS16
+circleWidth(tS16 w, tS32 limit)
+{
+  if (w < 0)
+    w = 0;
+  while ((tS32)(w + 1) * (w + 1) <= limit)
+    w++;
+  while (w >= 0 && (tS32)w * w > limit)
+    w--;
+  return w;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Rasterize a circle row by row. For the outline, a row has the
+ *    end pixels and the pixels of the disc that are missing in the
+ *    row above or below.
+ *
+ ****************************************************************************/
+static void
+circle(tS16 xc, tS16 yc, tU8 r, tU8 color, tBool fill)
+{
+  tS32 rr = (tS32)r * r + r;
+  tS16 edges[4];
+  tS16 dy;
+  tS16 wPrev = -1;      //half width of row dy - 1, -1 outside the disc
+  tS16 w;
+  tS16 wNext;
+
+  w = circleWidth(0, rr - (tS32)r * r);
+  batchStart(color);
+  for(dy = -r; dy <= r; dy++)
+  {
+    wNext = (dy < r) ? circleWidth(w, rr - (tS32)(dy + 1) * (dy + 1)) : -1;
+
+    if (yc + dy >= 0 && yc + dy < SCREEN_SIZE)
+    {
+      tS16 inner = (wPrev < wNext) ? wPrev : wNext;
+
+      //first pixel from the centre that is drawn
+      if (fill == TRUE)
+        inner = 0;
+      else
+        inner = (inner >= w) ? w : inner + 1;
+
+      if (inner == 0)
+      {
+        edges[0] = xc - w;
+        edges[1] = xc + w + 1;
+        batchRow(yc + dy, edges, 1);
+      }
+      else
+      {
+        edges[0] = xc - w;
+        edges[1] = xc - inner + 1;
+        edges[2] = xc + inner;
+        edges[3] = xc + w + 1;
+        batchRow(yc + dy, edges, 2);
+      }
+    }
+
+    wPrev = w;
+    w     = wNext;
+  }
+  batchEnd();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw the outline of a circle.
+ *
+ ****************************************************************************/
+void
+drawCircle(tS16 xc, tS16 yc, tU8 r, tU8 color)
+{
+  circle(xc, yc, r, color, FALSE);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a filled circle.
+ *
+ ****************************************************************************/
+void
+drawFillCircle(tS16 xc, tS16 yc, tU8 r, tU8 color)
+{
+  circle(xc, yc, r, color, TRUE);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw the outline of a closed polygon.
+ *
+ ****************************************************************************/
+void
+drawPolygon(const tPoint* pPoints, tU8 count, tU8 color)
+{
+  tU8 i;
+
+  for(i = 0; i < count; i++)
+  {
+    const tPoint* pNext = &pPoints[(i + 1 < count) ? i + 1 : 0];
+
+    drawLine(pPoints[i].x, pPoints[i].y, pNext->x, pNext->y, color);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a filled polygon (at most DRAW_MAX_VERTICES corners). The
+ *    polygon may be concave or self-intersecting.
+ *
+ ****************************************************************************/
+void
+drawFillPolygon(const tPoint* pPoints, tU8 count, tU8 color)
+{
+  tS16 edges[DRAW_MAX_VERTICES];
+  tS16 yMin;
+  tS16 yMax;
+  tS16 y;
+  tU8  i;
+
+  if (count < 3 || count > DRAW_MAX_VERTICES)
+    return;
+
+  yMin = yMax = pPoints[0].y;
+  for(i = 1; i < count; i++)
+  {
+    if (pPoints[i].y < yMin)
+      yMin = pPoints[i].y;
+    if (pPoints[i].y > yMax)
+      yMax = pPoints[i].y;
+  }
+  if (yMin < 0)
+    yMin = 0;
+  if (yMax > SCREEN_SIZE)
+    yMax = SCREEN_SIZE;
+
+  batchStart(color);
+  for(y = yMin; y < yMax; y++)
+  {
+    tU8 crossings = 0;
+    tU8 spans;
+    tU8 j;
+
+    //x where the edges cross the row, an edge covers the rows ya <= y < yb
+    for(i = 0; i < count; i++)
+    {
+      const tPoint* pA = &pPoints[i];
+      const tPoint* pB = &pPoints[(i + 1 < count) ? i + 1 : 0];
+      tS32 num;
+      tS32 den;
+      tS16 x;
+
+      if (pA->y > pB->y)
+      {
+        const tPoint* pT = pA;
+        pA = pB;
+        pB = pT;
+      }
+      if (y < pA->y || y >= pB->y)
+        continue;
+
+      //first pixel centre on or right of the crossing
+      num = (tS32)(y - pA->y) * (pB->x - pA->x);
+      den = pB->y - pA->y;
+      x   = pA->x + ((num >= 0) ? (num + den - 1) / den : -(-num / den));
+
+      //insertion sort
+      for(j = crossings; j > 0 && edges[j - 1] > x; j--)
+        edges[j] = edges[j - 1];
+      edges[j] = x;
+      crossings++;
+    }
+
+    //merge spans that touch
+    spans = 0;
+    for(j = 0; j + 1 < crossings; j += 2)
+    {
+      if (spans > 0 && edges[2*spans - 1] >= edges[j])
+      {
+        if (edges[j + 1] > edges[2*spans - 1])
+          edges[2*spans - 1] = edges[j + 1];
+      }
+      else
+      {
+        edges[2*spans]     = edges[j];
+        edges[2*spans + 1] = edges[j + 1];
+        spans++;
+      }
+    }
+    batchRow(y, edges, spans);
+  }
+  batchEnd();
+}
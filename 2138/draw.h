@@ -0,0 +1,41 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    draw.h
+ *
+ * Description:
+ *    Expose the vector drawing functions (lines, circles and polygons).
+ *
+ *****************************************************************************/
+#ifndef _DRAW_H_
+#define _DRAW_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define DRAW_MAX_VERTICES 16    //max corners of a filled polygon
+
+//coordinates may be outside the screen, all shapes are clipped
+typedef struct
+{
+  tS16 x;
+  tS16 y;
+} tPoint;
+
+
+void drawLine(tS16 x0, tS16 y0, tS16 x1, tS16 y1, tU8 color);
+void drawCircle(tS16 xc, tS16 yc, tU8 r, tU8 color);
+void drawFillCircle(tS16 xc, tS16 yc, tU8 r, tU8 color);
+void drawPolygon(const tPoint* pPoints, tU8 count, tU8 color);
+void drawFillPolygon(const tPoint* pPoints, tU8 count, tU8 color);
+
+#endif
@@ -16,6 +16,7 @@
  *****************************************************************************/
 #include "../pre_emptive_os/api/general.h"
 #include "i2c.h"
+#include "perf.h"
 
 /******************************************************************************
  * Defines and typedefs
@@ -490,6 +491,8 @@ pca9532(tU8* pBuf, tU16 len, tU8* pBuf2, tU16 len2)
   tU8  status  = 0;
   tU16 i       = 0;
 
+  PERF_I2C();
+
 getI2cLock();
   do
   {
@@ -0,0 +1,145 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    font.c
+ *
+ * Description:
+ *    Access to the glyphs, advances and kerning pairs of a compiled font
+ *    (see font.h). Shared by the LCD code and the host tool fontc.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "font.h"
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check the header of a font.
+ *
+ ****************************************************************************/
+tBool
+fontValid(const tU8* pFont)
+{
+  if (pFont[0] != FONT_MAGIC || pFont[1] == 0 || pFont[1] > FONT_MAX_HEIGHT)
+    return FALSE;
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the height of a font (all glyphs have this number of rows).
+ *
+ ****************************************************************************/
+tU8
+fontHeight(const tU8* pFont)
+{
+  return pFont[1];
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the glyph of a character.
+ *
+ * Params:
+ *    [in]  pFont    - font
+ *    [in]  c        - character
+ *    [out] pWidth   - width of the bitmap in pixels
+ *    [out] pAdvance - distance to the next character
+ *
+ * Returns:
+ *    The bitmap, or NULL (width and advance 0) if the character is not in
+ *    the font.
+ *
+ ****************************************************************************/
+const tU8*
+fontGlyph(const tU8* pFont, tU8 c, tU8* pWidth, tU8* pAdvance)
+{
+  const tU8* pGlyph;
+
+  if (c < pFont[2] || c - pFont[2] >= pFont[3])
+  {
+    *pWidth   = 0;
+    *pAdvance = 0;
+    return NULL;
+  }
+
+  pGlyph    = pFont + FONT_HEADER_SIZE + FONT_GLYPH_SIZE * (c - pFont[2]);
+  *pWidth   = pGlyph[2];
+  *pAdvance = pGlyph[3];
+  return pFont + (pGlyph[0] | (pGlyph[1] << 8));
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the change of the advance between two characters (binary
+ *    search of the kerning pairs).
+ *
+ ****************************************************************************/
+tS8
+fontKern(const tU8* pFont, tU8 first, tU8 second)
+{
+  const tU8* pPairs = pFont + FONT_HEADER_SIZE + FONT_GLYPH_SIZE * pFont[3];
+  tU16 key = (first << 8) | second;
+  tS32 low = 0;
+  tS32 high = (tS32)(pFont[4] | (pFont[5] << 8)) - 1;
+
+  while (low <= high)
+  {
+    tS32 mid = (low + high) / 2;
+    const tU8* pPair = pPairs + FONT_KERN_SIZE * mid;
+    tU16 pairKey = (pPair[0] << 8) | pPair[1];
+
+    if (pairKey == key)
+      return (tS8)pPair[2];
+    if (pairKey < key)
+      low = mid + 1;
+    else
+      high = mid - 1;
+  }
+  return 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Measure the width of a text without drawing it, i.e. the sum of the
+ *    advances and kerning changes.
+ *
+ * Params:
+ *    [in] pFont - font
+ *    [in] pText - text
+ *    [in] len   - max number of characters, the text may end before
+ *
+ ****************************************************************************/
+tU16
+fontMeasure(const tU8* pFont, const char* pText, tU8 len)
+{
+  tU16 width = 0;
+  tU8  glyphWidth;
+  tU8  advance;
+  tU8  i;
+
+  for(i = 0; i < len && pText[i] != '\0'; i++)
+  {
+    fontGlyph(pFont, pText[i], &glyphWidth, &advance);
+    width += advance;
+    if (i + 1 < len && pText[i + 1] != '\0')
+      width += fontKern(pFont, pText[i], pText[i + 1]);
+  }
+  return width;
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    font.h
+ *
+ * Description:
+ *    Expose the compiled (proportional) font format. Fonts are generated
+ *    by the host tool tools/fontc.
+ *
+ *    Font layout (16-bit values are little endian):
+ *      0  magic (FONT_MAGIC)
+ *      1  height in pixel rows (1 - FONT_MAX_HEIGHT)
+ *      2  first character
+ *      3  number of characters
+ *      4  number of kerning pairs (16 bits)
+ *      6  glyph table, FONT_GLYPH_SIZE bytes per character:
+ *           offset of the bitmap from start of font (16 bits), width in
+ *           pixels (0 - FONT_MAX_WIDTH), advance to the next character
+ *      -  kerning pairs, FONT_KERN_SIZE bytes each, sorted on first and
+ *         second character: first, second, signed change of the advance
+ *      -  bitmaps, height rows of (width + 7) / 8 bytes, MSB is the
+ *         leftmost pixel
+ *
+ *****************************************************************************/
+#ifndef _FONT_H_
+#define _FONT_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define FONT_MAGIC       0x46
+#define FONT_HEADER_SIZE 6
+#define FONT_GLYPH_SIZE  4
+#define FONT_KERN_SIZE   3
+#define FONT_MAX_WIDTH   16
+#define FONT_MAX_HEIGHT  32
+
+
+tBool      fontValid(const tU8* pFont);
+tU8        fontHeight(const tU8* pFont);
+const tU8* fontGlyph(const tU8* pFont, tU8 c, tU8* pWidth, tU8* pAdvance);
+tS8        fontKern(const tU8* pFont, tU8 first, tU8 second);
+tU16       fontMeasure(const tU8* pFont, const char* pText, tU8 len);
+
+#endif
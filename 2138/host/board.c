@@ -0,0 +1,441 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    board.c
+ *
+ * Description:
+ *    Host build of the firmware (make host/board): main.c, the LCD driver,
+ *    the games and bt.c run on the models of host/ (OS, LCD bus, I2C and
+ *    UARTs) and the modelled bus time is reported per screen.
+ *
+ *    Usage: board [-t <ms>] [-k <key script>] [-g <game>] [-s <ppm file>]
+ *                 [-c <capture file>]
+ *
+ *    -t  virtual run time in ms (default 30000)
+ *    -k  key script, pairs of "<ms> <keys>": at the virtual time the keys
+ *        (c, u, d, l, r for center, up, down, left, right, combined for a
+ *        chord) are pressed for KEY_PRESS_MS
+ *    -g  run a game directly instead of main.c (startup sequence and menu):
+ *        snake, pong, chess, reflexes, right, up, down or bt; the run ends
+ *        when the game returns
+ *    -s  write the screen at the end of the run as 130x130 PPM image
+ *    -c  write the LCD bus captures to a file, in the stream format of
+ *        lcdCapture.c (console output of a build with LCD_CAPTURE = 1),
+ *        for tools/lcdreplay
+ *
+ *    The screens are named by the LCD capture points (see lcdCapture.h),
+ *    or by the game given with -g.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include "../lcd.h"
+#include "../key.h"
+#include "../hw.h"
+#include "../snake.h"
+#include "../pong.h"
+#include "../bt.h"
+#include "../term.h"
+#include "../Arrow.h"
+#include "../Reflexes.h"
+#include "../chess/chess.h"
+#include "../lcdCapture.h"
+#include "../lcdCache.h"
+#include "../replay.h"
+#include "../prof.h"
+#include "fakeOs.h"
+#include "fakeBus.h"
+#include "fakeSpi.h"
+#include "fakeI2c.h"
+#include "fakeController.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define RUN_MS          30000
+#define KEY_PRESS_MS    100
+#define MAX_KEY_EVENTS  256
+#define GAME_STACK_SIZE 800
+
+typedef struct
+{
+  tU32 ms;
+  tU8  keys;
+} tKeyScript;
+
+typedef struct
+{
+  const char* pName;
+  void      (*pGame)(void);
+} tGame;
+
+
+/*****************************************************************************
+ * External functions
+ ****************************************************************************/
+int boardMain(void);      //main() of main.c
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tKeyScript keyEvents[MAX_KEY_EVENTS];
+static tU32      keyEventCnt;
+static const char* pScreenFile;
+static const tGame* pGame;
+
+//capture stream (-c)
+static FILE* pCaptureFile;
+static tBool capturing = FALSE;
+static tU16  runWord;
+static tU16  runCount = 0;
+
+static tU8 gameStack[GAME_STACK_SIZE];
+
+//bits of the SPI frames of a wire format image
+static tU32 frameAcc;
+static tU8  frameBits = 0;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The Bluetooth terminal needs the Bluetooth process
+ *
+ ****************************************************************************/
+static void
+playBt(void)
+{
+  initBtProc();
+  btTerminal();
+}
+
+static const tGame games[] =
+{
+  {"snake",    playSnake},
+  {"pong",     playPong},
+  {"chess",    playChess},
+  {"reflexes", initApp},
+  {"right",    getRightArrow},
+  {"up",       getUpArrow},
+  {"down",     getDownArrow},
+  {"bt",       playBt}
+};
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Parse the key script
+ *
+ ****************************************************************************/
+static void
+parseKeys(const char* pScript)
+{
+  char keys[8];
+  int  ms;
+  int  n;
+  tU8  i;
+
+  while(keyEventCnt < MAX_KEY_EVENTS &&
+        sscanf(pScript, " %d %7s%n", &ms, keys, &n) == 2)
+  {
+    tKeyScript* pEvent = &keyEvents[keyEventCnt++];
+
+    pEvent->ms   = ms;
+    pEvent->keys = KEY_NOTHING;
+    for(i=0; keys[i] != '\0'; i++)
+    {
+      switch(keys[i])
+      {
+        case 'c': pEvent->keys |= KEY_CENTER; break;
+        case 'u': pEvent->keys |= KEY_UP;     break;
+        case 'd': pEvent->keys |= KEY_DOWN;   break;
+        case 'l': pEvent->keys |= KEY_LEFT;   break;
+        case 'r': pEvent->keys |= KEY_RIGHT;  break;
+        default:
+          fprintf(stderr, "unknown key '%c'\n", keys[i]);
+          exit(1);
+      }
+    }
+    pScript += n;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The keys pressed at the current virtual time (called by the PCA9532
+ *    model)
+ *
+ ****************************************************************************/
+static tU8
+scriptKeys(void)
+{
+  tFakeTime now = fakeOsNow();
+  tU8       keys = KEY_NOTHING;
+  tU32      i;
+
+  for(i=0; i<keyEventCnt; i++)
+    if (now >= keyEvents[i].ms * FAKE_TIME_MS &&
+        now <  (keyEvents[i].ms + KEY_PRESS_MS) * FAKE_TIME_MS)
+      keys |= keyEvents[i].keys;
+  return keys;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write the screen as PPM image
+ *
+ ****************************************************************************/
+static void
+writeScreen(const char* pName)
+{
+  static tU8 rgb[FAKE_CONTROLLER_SIZE * FAKE_CONTROLLER_SIZE * 3];
+  FILE* pFile = fopen(pName, "wb");
+
+  if (pFile == NULL)
+  {
+    perror(pName);
+    return;
+  }
+  fakeControllerRgb(rgb);
+  fprintf(pFile, "P6\n%u %u\n255\n", FAKE_CONTROLLER_SIZE, FAKE_CONTROLLER_SIZE);
+  fwrite(rgb, 1, sizeof(rgb), pFile);
+  fclose(pFile);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    End of the run: report and exit
+ *
+ ****************************************************************************/
+static void
+endRun(void)
+{
+  printf("\n");
+  fakeBusReport(stdout);
+  if (pScreenFile != NULL)
+    writeScreen(pScreenFile);
+  fflush(stdout);
+  exit(0);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Process that runs a game (-g)
+ *
+ ****************************************************************************/
+static void
+gameProc(void* arg)
+{
+  initKeyProc();
+  termInit();
+  resetLCD();
+  lcdInit();
+
+  fakeBusScreen(pGame->pName);
+  pGame->pGame();
+  REPLAY_END();
+
+  //the last frame ends when it is drawn, the bus probes with it
+  lcdFlush();
+  PROF_DUMP();
+  osSleep(1);
+
+  fakeOsLock();
+  endRun();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write the collected run of equal words to the capture file.
+ *
+ ****************************************************************************/
+static void
+putUnit(tU16 unit)
+{
+  fputc(unit & 0xff, pCaptureFile);
+  fputc(unit >> 8, pCaptureFile);
+}
+
+static void
+flushRun(void)
+{
+  if (runCount > 1)
+    putUnit(LCD_CAPTURE_REPEAT | runCount);
+  if (runCount > 0)
+    putUnit(runWord);
+  runCount = 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Stand-in for lcdCapture.c: every word on the LCD bus goes to the
+ *    controller model, a capture point switches the screen statistics.
+ *    With -c the captures are also written to a file, as lcdCapture.c
+ *    sends them to the console.
+ *
+ ****************************************************************************/
+void
+lcdCaptureBegin(const char* pName)
+{
+  lcdFlush();
+  lcdCacheReset();
+
+  fakeBusScreen(pName);
+  frameBits = 0;
+
+  if (pCaptureFile != NULL)
+  {
+    fprintf(pCaptureFile, "LCDC%s", pName);
+    fputc('\0', pCaptureFile);
+    runCount  = 0;
+    capturing = TRUE;
+  }
+}
+
+void
+lcdCaptureStop(void)
+{
+  lcdFlush();
+
+  if (capturing == TRUE)
+  {
+    capturing = FALSE;
+    flushRun();
+    putUnit(LCD_CAPTURE_END);
+    fflush(pCaptureFile);
+  }
+}
+
+void
+lcdCaptureFill(tU16 word, tU32 count)
+{
+  fakeOsLock();
+  while(count-- > 0)
+  {
+    fakeControllerWord(word);
+
+    if (capturing == TRUE)
+    {
+      if (runCount > 0 && (runWord != word || runCount == LCD_CAPTURE_MAX_RUN))
+        flushRun();
+      runWord = word;
+      runCount++;
+    }
+  }
+  fakeOsUnlock();
+}
+
+void
+lcdCaptureData(const tU8* pData, tU32 len)
+{
+  fakeOsLock();
+  while(len-- > 0)
+    fakeControllerWord(0x100 | *pData++);
+  fakeOsUnlock();
+}
+
+void
+lcdCaptureFrame(tU8 frame)
+{
+  frameAcc   = (frameAcc << 8) | frame;
+  frameBits += 8;
+  if (frameBits >= 9)
+  {
+    frameBits -= 9;
+    lcdCaptureFill((frameAcc >> frameBits) & 0x1ff, 1);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Parse the options and start the firmware
+ *
+ ****************************************************************************/
+int
+main(int argc, char** argv)
+{
+  tU32 runMs = RUN_MS;
+  tU8  error;
+  tU8  pid;
+  int  i;
+  tU32 j;
+
+  for(i=1; i<argc; i++)
+  {
+    if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+      runMs = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc)
+      parseKeys(argv[++i]);
+    else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+      pScreenFile = argv[++i];
+    else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+    {
+      pCaptureFile = fopen(argv[++i], "wb");
+      if (pCaptureFile == NULL)
+      {
+        perror(argv[i]);
+        return 1;
+      }
+    }
+    else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+    {
+      i++;
+      for(j=0; j<sizeof(games)/sizeof(games[0]); j++)
+        if (strcmp(argv[i], games[j].pName) == 0)
+          pGame = &games[j];
+      if (pGame == NULL)
+      {
+        fprintf(stderr, "unknown game %s\n", argv[i]);
+        return 1;
+      }
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [-t <ms>] [-k <key script>] [-g <game>] [-s <ppm file>] "
+                      "[-c <capture file>]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  fakeControllerReset();
+  fakeI2cKeys(scriptKeys);
+  fakeOsEnd(runMs * FAKE_TIME_MS, endRun);
+  fakeSpiStart();
+
+  if (pGame == NULL)
+    return boardMain();
+
+  immediateIoInit();
+  osInit();
+  osCreateProcess(gameProc, gameStack, GAME_STACK_SIZE, &pid, 3, NULL, &error);
+  osStartProcess(pid, &error);
+  osStart();
+  return 0;
+}
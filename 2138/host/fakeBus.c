@@ -0,0 +1,321 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeBus.c
+ *
+ * Description:
+ *    Timing model of the SPI, I2C and UART buses for the host build of
+ *    the firmware.
+ *
+ *    Every bus has a time line. A transfer starts when the bus is free
+ *    and takes its number of bits times the bit time of the bus (from
+ *    the divider the firmware programs). A charged transfer is polled by
+ *    the CPU, so the virtual clock moves to its end. A queued transfer is
+ *    shifted out in the background (by an ISR) and only occupies the bus.
+ *
+ *    The time of every transfer is added to the current screen, which is
+ *    named by LCD_CAPTURE_BEGIN() in the firmware. A frame starts with the
+ *    first LCD transfer and ends when the process that drew it sleeps;
+ *    the frame time is the time until the last transfer of the frame is
+ *    shifted out.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <string.h>
+#include "fakeBus.h"
+#include "fakeSpi.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+typedef struct
+{
+  const char* pName;
+  tFakeTime   elapsed;
+  tFakeTime   busy[FAKE_BUS_COUNT];
+  tU32        bits[FAKE_BUS_COUNT];
+  tU32        frames;
+  tFakeTime   frameSum;
+  tFakeTime   frameMax;
+} tFakeScreen;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static const char* busNames[FAKE_BUS_COUNT] = {"spi", "i2c", "uart0", "uart1"};
+
+static tFakeTime busFree[FAKE_BUS_COUNT];
+
+static tFakeScreen  screens[FAKE_SCREENS];
+static tU8          screenCnt;
+static tFakeScreen* pScreen;
+static tFakeTime    screenSince;
+
+static tBool     frameOpen;
+static tFakeTime frameStart;
+static tU8       frameDrawer;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Bit time of a bus clocked at PCLK divided by pclkPerBit
+ *
+ ****************************************************************************/
+tFakeTime
+fakeBusBitTime(tU32 pclkPerBit)
+{
+  return ((tFakeTime)pclkPerBit * 1000000000ULL + FAKE_PCLK / 2) / FAKE_PCLK;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Add the time of a transfer to the current screen, and open a frame
+ *    at the first LCD transfer.
+ *
+ ****************************************************************************/
+static void
+account(tU8 bus, tFakeTime start, tFakeTime end, tU32 bits)
+{
+  if (pScreen == NULL)
+    fakeBusScreen("boot");
+
+  pScreen->busy[bus] += end - start;
+  pScreen->bits[bus] += bits;
+
+  if (bus == FAKE_BUS_SPI && frameOpen == FALSE)
+  {
+    frameOpen   = TRUE;
+    frameStart  = start;
+    frameDrawer = fakeOsRunning();
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start a transfer on a bus, when the bus is free
+ *
+ * Returns:
+ *    The time the transfer ends
+ *
+ ****************************************************************************/
+static tFakeTime
+transfer(tU8 bus, tU32 bits, tFakeTime bitTime)
+{
+  tFakeTime start = fakeOsNow();
+
+  if (start < busFree[bus])
+    start = busFree[bus];
+  busFree[bus] = start + bits * bitTime;
+  account(bus, start, busFree[bus], bits);
+  return busFree[bus];
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    A transfer that the CPU waits for (polled). The clock moves to the
+ *    end of the transfer.
+ *
+ ****************************************************************************/
+void
+fakeBusCharge(tU8 bus, tU32 bits, tFakeTime bitTime)
+{
+  fakeOsLock();
+  fakeOsAdvance(transfer(bus, bits, bitTime));
+  fakeOsUnlock();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    A transfer that is shifted out in the background
+ *
+ * Returns:
+ *    The time the transfer ends
+ *
+ ****************************************************************************/
+tFakeTime
+fakeBusQueue(tU8 bus, tU32 bits, tFakeTime bitTime)
+{
+  tFakeTime end;
+
+  fakeOsLock();
+  end = transfer(bus, bits, bitTime);
+  fakeOsUnlock();
+  return end;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The time a bus is free
+ *
+ ****************************************************************************/
+tFakeTime
+fakeBusFree(tU8 bus)
+{
+  return busFree[bus];
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Switch to the statistics of a screen (created at first use)
+ *
+ ****************************************************************************/
+void
+fakeBusScreen(const char* pName)
+{
+  tU8 i;
+
+  fakeOsLock();
+  if (pScreen != NULL)
+    pScreen->elapsed += fakeOsNow() - screenSince;
+  screenSince = fakeOsNow();
+
+  for(i=0; i<screenCnt; i++)
+    if (strcmp(screens[i].pName, pName) == 0)
+      break;
+
+  if (i == screenCnt)
+  {
+    if (screenCnt == FAKE_SCREENS)
+      i = FAKE_SCREENS - 1;
+    else
+    {
+      screenCnt++;
+      memset(&screens[i], 0, sizeof(tFakeScreen));
+      screens[i].pName = pName;
+    }
+  }
+  pScreen = &screens[i];
+  fakeOsUnlock();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    A process goes to sleep. If it drew the open frame, the frame ends
+ *    when the LCD bus has shifted out all of it.
+ *
+ ****************************************************************************/
+void
+fakeBusFrame(tU8 pid)
+{
+  tFakeTime end;
+
+  fakeOsLock();
+  if (frameOpen == TRUE && pid == frameDrawer)
+  {
+    fakeSpiSync(FAKE_TIME_MAX);
+
+    end = fakeOsNow();
+    if (end < busFree[FAKE_BUS_SPI])
+      end = busFree[FAKE_BUS_SPI];
+
+    pScreen->frames++;
+    pScreen->frameSum += end - frameStart;
+    if (pScreen->frameMax < end - frameStart)
+      pScreen->frameMax = end - frameStart;
+    frameOpen = FALSE;
+  }
+  fakeOsUnlock();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Print one line of the report
+ *
+ ****************************************************************************/
+static void
+reportLine(FILE* pFile, const tFakeScreen* pStat)
+{
+  double ms = (double)pStat->elapsed / FAKE_TIME_MS;
+  tU8 bus;
+
+  fprintf(pFile, "%-12s %9.0f %7u", pStat->pName, ms, pStat->frames);
+  if (pStat->frames > 0)
+    fprintf(pFile, " %7.1f %9.2f %9.2f",
+            pStat->frames * 1000.0 / ms,
+            (double)pStat->frameSum / pStat->frames / FAKE_TIME_MS,
+            (double)pStat->frameMax / FAKE_TIME_MS);
+  else
+    fprintf(pFile, " %7s %9s %9s", "-", "-", "-");
+
+  for(bus=0; bus<FAKE_BUS_COUNT; bus++)
+    fprintf(pFile, " %6.1f", ms > 0 ? 100.0 * pStat->busy[bus] / pStat->elapsed : 0.0);
+  fprintf(pFile, "\n");
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Print frame time, frame rate and bus utilisation of every screen,
+ *    and of the whole run.
+ *
+ ****************************************************************************/
+void
+fakeBusReport(FILE* pFile)
+{
+  tFakeScreen all;
+  tU8 i;
+  tU8 bus;
+
+  fakeOsLock();
+  if (pScreen == NULL)
+    fakeBusScreen("boot");
+  fakeBusScreen(pScreen->pName);
+
+  memset(&all, 0, sizeof(all));
+  all.pName = "(all)";
+
+  fprintf(pFile, "\n%-12s %9s %7s %7s %9s %9s", "screen", "time ms", "frames",
+          "fps", "frame ms", "max ms");
+  for(bus=0; bus<FAKE_BUS_COUNT; bus++)
+    fprintf(pFile, " %5s%%", busNames[bus]);
+  fprintf(pFile, "\n");
+
+  for(i=0; i<screenCnt; i++)
+  {
+    reportLine(pFile, &screens[i]);
+
+    all.elapsed  += screens[i].elapsed;
+    all.frames   += screens[i].frames;
+    all.frameSum += screens[i].frameSum;
+    if (all.frameMax < screens[i].frameMax)
+      all.frameMax = screens[i].frameMax;
+    for(bus=0; bus<FAKE_BUS_COUNT; bus++)
+    {
+      all.busy[bus] += screens[i].busy[bus];
+      all.bits[bus] += screens[i].bits[bus];
+    }
+  }
+  reportLine(pFile, &all);
+
+  fprintf(pFile, "\nbits:");
+  for(bus=0; bus<FAKE_BUS_COUNT; bus++)
+    fprintf(pFile, " %s %u", busNames[bus], all.bits[bus]);
+  fprintf(pFile, "\n");
+  fakeOsUnlock();
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeBus.h
+ *
+ * Description:
+ *    Timing model of the SPI, I2C and UART buses for the host build of
+ *    the firmware, and the frame time, bus utilisation and frame rate of
+ *    every screen.
+ *
+ *****************************************************************************/
+#ifndef _FAKE_BUS_H_
+#define _FAKE_BUS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include "../pre_emptive_os/api/general.h"
+#include "config.h"
+#include "fakeOs.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define FAKE_PCLK       ((CORE_FREQ) / PBSD)
+
+#define FAKE_BUS_SPI    0     //LCD, SPI0 (and the ninth bit on GPIO)
+#define FAKE_BUS_I2C    1     //PCA9532: keys, LEDs and resets
+#define FAKE_BUS_UART0  2     //console
+#define FAKE_BUS_UART1  3     //Bluetooth module
+#define FAKE_BUS_COUNT  4
+
+#define FAKE_SCREENS    16
+
+
+tFakeTime fakeBusBitTime(tU32 pclkPerBit);
+void      fakeBusCharge(tU8 bus, tU32 bits, tFakeTime bitTime);
+tFakeTime fakeBusQueue(tU8 bus, tU32 bits, tFakeTime bitTime);
+tFakeTime fakeBusFree(tU8 bus);
+
+void      fakeBusScreen(const char* pName);
+void      fakeBusFrame(tU8 pid);
+void      fakeBusReport(FILE* pFile);
+
+#endif
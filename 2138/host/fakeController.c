@@ -0,0 +1,267 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeController.c
+ *
+ * Description:
+ *    Model of the LCD controller behind the 9-bit bus for host builds and
+ *    tools. CASET, PASET, RAMWR, MADCTL, RGBSET, VSCRDEF and VSCSAD are
+ *    interpreted into display memory, other commands are counted only.
+ *    The visible image is read through the scroll areas and the color
+ *    lookup table, as the panel shows it.
+ *
+ *    MADCTL is interpreted relative to MADCTL_HORIZ (the normal mode of
+ *    lcd.c), i.e., toggling MX or MY mirrors the address counters.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <string.h>
+#include "fakeController.h"
+#include "../lcd.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LAST_ADDRESS  (FAKE_CONTROLLER_ROWS - 1)
+#define MAX_PARAMS    20
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tFakeController ctrl;
+static tU8  command;
+static tU8  params[MAX_PARAMS];
+static tU8  numParams;
+static tU8  column;
+static tU8  row;
+
+static const tU8 paletteNormal[20] =
+{
+  0, 2, 4, 6, 9, 11, 13, 15,
+  0, 2, 4, 6, 9, 11, 13, 15,
+  0, 6, 10, 15
+};
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Reset the model: black display memory, full window, normal mode and
+ *    palette, no scroll areas.
+ *
+ ****************************************************************************/
+void
+fakeControllerReset(void)
+{
+  memset(&ctrl, 0, sizeof(ctrl));
+  ctrl.madctl = MADCTL_HORIZ;
+  ctrl.xe     = LAST_ADDRESS;
+  ctrl.ye     = LAST_ADDRESS;
+  ctrl.scroll[1] = FAKE_CONTROLLER_ROWS;
+  memcpy(ctrl.palette, paletteNormal, sizeof(ctrl.palette));
+
+  command   = LCD_CMD_NOP;
+  numParams = 0;
+  column    = 0;
+  row       = 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the model state and counters.
+ *
+ ****************************************************************************/
+const tFakeController*
+fakeController(void)
+{
+  return &ctrl;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Bytes on the bus for the words received so far (9 bits per word).
+ *
+ ****************************************************************************/
+tU32
+fakeControllerBusBytes(void)
+{
+  return (ctrl.words * 9 + 7) / 8;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write one pixel and advance the address counters in the window.
+ *
+ ****************************************************************************/
+static void
+writePixel(tU8 color)
+{
+  tU8 x = column;
+  tU8 y = row;
+
+  if ((ctrl.madctl ^ MADCTL_HORIZ) & MADCTL_MX)
+    x = LAST_ADDRESS - x;
+  if ((ctrl.madctl ^ MADCTL_HORIZ) & MADCTL_MY)
+    y = LAST_ADDRESS - y;
+  if (x <= LAST_ADDRESS && y <= LAST_ADDRESS)
+    ctrl.memory[y][x] = color;
+  ctrl.pixels++;
+
+  if (ctrl.madctl & MADCTL_V)
+  {
+    if (row++ >= ctrl.ye)
+    {
+      row = ctrl.ys;
+      if (column++ >= ctrl.xe)
+        column = ctrl.xs;
+    }
+  }
+  else
+  {
+    if (column++ >= ctrl.xe)
+    {
+      column = ctrl.xs;
+      if (row++ >= ctrl.ye)
+        row = ctrl.ys;
+    }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Apply a command when all its parameters have been received.
+ *
+ ****************************************************************************/
+static void
+applyParams(void)
+{
+  switch(command)
+  {
+    case LCD_CMD_CASET:
+    if (numParams == 2)
+    {
+      ctrl.xs = params[0];
+      ctrl.xe = params[1];
+    }
+    break;
+
+    case LCD_CMD_PASET:
+    if (numParams == 2)
+    {
+      ctrl.ys = params[0];
+      ctrl.ye = params[1];
+    }
+    break;
+
+    case LCD_CMD_MADCTL:
+    if (numParams == 1)
+      ctrl.madctl = params[0];
+    break;
+
+    case LCD_CMD_RGBSET:
+    if (numParams == 20)
+      memcpy(ctrl.palette, params, 20);
+    break;
+
+    case LCD_CMD_VSCRDEF:
+    if (numParams == 3)
+      memcpy(ctrl.scroll, params, 3);
+    break;
+
+    case LCD_CMD_VSCSAD:
+    if (numParams == 1)
+      ctrl.scrollStart = params[0];
+    break;
+
+    default:
+    break;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Receive one 9-bit word (bit 8 set for data).
+ *
+ ****************************************************************************/
+void
+fakeControllerWord(tU16 word)
+{
+  ctrl.words++;
+
+  if ((word & 0x100) == 0)
+  {
+    ctrl.commands++;
+    command   = (tU8)word;
+    numParams = 0;
+    if (command == LCD_CMD_RAMWR)
+    {
+      column = ctrl.xs;
+      row    = ctrl.ys;
+    }
+  }
+  else if (command == LCD_CMD_RAMWR)
+    writePixel((tU8)word);
+  else if (numParams < MAX_PARAMS)
+  {
+    params[numParams++] = (tU8)word;
+    applyParams();
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the visible image as 8-bit RGB triplets, FAKE_CONTROLLER_SIZE
+ *    pixels square.
+ *
+ ****************************************************************************/
+void
+fakeControllerRgb(tU8* pRgb)
+{
+  tU32 top    = ctrl.scroll[0];
+  tU32 height = ctrl.scroll[1];
+  tU32 x, y;
+
+  for(y=0; y<FAKE_CONTROLLER_SIZE; y++)
+  {
+    tU32 memRow = y + 2;
+
+    //rows in the scroll area start at the scroll start address
+    if (height > 0 && memRow >= top && memRow < top + height)
+    {
+      memRow = ctrl.scrollStart + (memRow - top);
+      if (memRow >= top + height)
+        memRow -= height;
+      if (memRow > LAST_ADDRESS)
+        memRow = LAST_ADDRESS;
+    }
+
+    for(x=0; x<FAKE_CONTROLLER_SIZE; x++)
+    {
+      tU8 color = ctrl.memory[memRow][x + 2];
+
+      *pRgb++ = ctrl.palette[color >> 5] * 17;
+      *pRgb++ = ctrl.palette[8 + ((color >> 2) & 7)] * 17;
+      *pRgb++ = ctrl.palette[16 + (color & 3)] * 17;
+    }
+  }
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeController.h
+ *
+ * Description:
+ *    Model of the LCD controller behind the 9-bit bus for host builds
+ *    and tools. Interprets the words sent on the bus into display memory.
+ *
+ *****************************************************************************/
+#ifndef _FAKE_CONTROLLER_H_
+#define _FAKE_CONTROLLER_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define FAKE_CONTROLLER_ROWS  132   //display memory rows and columns
+#define FAKE_CONTROLLER_SIZE  130   //visible pixels, from address 2
+
+typedef struct
+{
+  tU32 words;               //9-bit words received
+  tU32 commands;            //command words received
+  tU32 pixels;              //pixels written
+  tU8  madctl;
+  tU8  xs, xe, ys, ye;      //window (CASET/PASET)
+  tU8  palette[20];         //RGBSET: 8 red, 8 green and 4 blue levels
+  tU8  scroll[3];           //VSCRDEF: top fixed, scroll and bottom fixed area
+  tU8  scrollStart;         //VSCSAD
+  tU8  memory[FAKE_CONTROLLER_ROWS][FAKE_CONTROLLER_ROWS];   //[row][column]
+} tFakeController;
+
+
+void fakeControllerReset(void);
+void fakeControllerWord(tU16 word);
+tU32 fakeControllerBusBytes(void);
+void fakeControllerRgb(tU8* pRgb);
+const tFakeController* fakeController(void);
+
+#endif
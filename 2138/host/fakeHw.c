@@ -0,0 +1,289 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeHw.c
+ *
+ * Description:
+ *    Stand-in for hw.c in the host build of the firmware. The board is a
+ *    hardware version 1.1 board: keys, LEDs and the reset signals are on
+ *    the PCA9532 (eeprom.c, host/fakeI2c.c). The words sent directly to
+ *    the LCD are charged at nine bits each on the SPI time line (eight
+ *    bit SPI frames plus the ninth bit on GPIO, or packed groups of eight
+ *    words in nine frames), and the CPU waits for them. The timebase
+ *    (nowUs) is the virtual clock.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include <lpc2xxx.h>
+
+#include "../hw.h"
+#include "../key.h"
+#include "../i2c.h"
+#include "../eeprom.h"
+#include "../lcdCapture.h"
+#include "../perf.h"
+#include "fakeBus.h"
+#include "fakeSpi.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LCD_WORD_BITS 9
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tU8 greenLedShadow;
+static tU8 btResetShadow;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Charge words sent directly to the LCD. The display list must have
+ *    released the bus first.
+ *
+ ****************************************************************************/
+static void
+chargeWords(tU32 count)
+{
+  fakeSpiSync(FAKE_TIME_MAX);
+  fakeBusCharge(FAKE_BUS_SPI, count * LCD_WORD_BITS, fakeSpiBitTime());
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize the PCA9532 (the board is a version 1.1 board)
+ *
+ ****************************************************************************/
+void
+immediateIoInit(void)
+{
+  tU8 initCommand[] = {0x12, 0x97, 0x80, 0x00, 0x40, 0x00, 0x14, 0x00, 0x00};
+
+  i2cInit();
+  pca9532(initCommand, sizeof(initCommand), NULL, 0);
+
+  ver1_0 = FALSE;
+  ver1_1 = TRUE;
+  greenLedShadow = FALSE;
+  btResetShadow  = TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Reset the LCD controller (LCD_RST# on the PCA9532)
+ *
+ ****************************************************************************/
+void
+resetLCD(void)
+{
+  tU8 command[] = {0x07, 0x04};
+
+  pca9532(command, sizeof(command), NULL, 0);
+  osSleep(2);
+  command[1] = 0x00;
+  pca9532(command, sizeof(command), NULL, 0);
+  osSleep(5);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Set or release the reset of the Bluetooth module (BT_RST# on the
+ *    PCA9532, together with the green LED)
+ *
+ ****************************************************************************/
+void
+resetBT(tBool resetFlag)
+{
+  tU8 command[] = {0x07, 0x00};
+
+  btResetShadow = resetFlag;
+  if (TRUE == resetFlag)
+    command[1] = 0x10;
+  if (TRUE == greenLedShadow)
+    command[1] |= 0x40;
+  pca9532(command, sizeof(command), NULL, 0);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The buzzer is on a GPIO pin, nothing to model
+ *
+ ****************************************************************************/
+void
+setBuzzer(tBool on)
+{
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Set an LED on the PCA9532
+ *
+ ****************************************************************************/
+void
+setLED(tU8 ledSelect, tBool ledState)
+{
+  tU8 command[] = {0x07, 0x00};
+
+  if (LED_GREEN == ledSelect)
+  {
+    greenLedShadow = ledState;
+    if (TRUE == ledState)
+      command[1] = 0x40;
+    if (TRUE == btResetShadow)
+      command[1] |= 0x10;
+  }
+  else
+  {
+    command[0] = 0x08;
+    if (TRUE == ledState)
+      command[1] = 0x01;
+  }
+  pca9532(command, sizeof(command), NULL, 0);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read the keys from the PCA9532 (INPUT0, active low)
+ *
+ ****************************************************************************/
+tU8
+getKeys(void)
+{
+  tU8 commandReadKeys[] = {0x00};
+  tU8 readKeys = KEY_NOTHING;
+  tU8 keySample;
+
+  pca9532(commandReadKeys, sizeof(commandReadKeys), &keySample, 1);
+  if ((keySample & 0x01) == 0) readKeys |= KEY_CENTER;
+  if ((keySample & 0x04) == 0) readKeys |= KEY_UP;
+  if ((keySample & 0x10) == 0) readKeys |= KEY_DOWN;
+  if ((keySample & 0x02) == 0) readKeys |= KEY_LEFT;
+  if ((keySample & 0x08) == 0) readKeys |= KEY_RIGHT;
+
+  return readKeys;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The chip select is a GPIO pin, nothing to model
+ *
+ ****************************************************************************/
+void
+selectLCD(tBool select)
+{
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send one 9-bit word to the LCD
+ *
+ ****************************************************************************/
+void
+sendToLCD(tU8 firstBit, tU8 data)
+{
+  LCD_CAPTURE_WORD(((tU16)firstBit << 8) | data);
+  PERF_LCD_WORDS(1);
+  chargeWords(1);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send a block of data words to the LCD
+ *
+ ****************************************************************************/
+void
+sendBurstToLCD(const tU8* pData, tU32 len)
+{
+  LCD_CAPTURE_DATA(pData, len);
+  PERF_LCD_WORDS(len);
+  chargeWords(len);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send a data word repeated count times to the LCD
+ *
+ ****************************************************************************/
+void
+sendFillToLCD(tU8 data, tU32 count)
+{
+  LCD_CAPTURE_FILL(0x100 | data, count);
+  PERF_LCD_WORDS(count);
+  chargeWords(count);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Nothing is held back, every word is charged when it is sent
+ *
+ ****************************************************************************/
+void
+flushBurstToLCD(void)
+{
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize SPI0 for the LCD (the bit rate is PCLK / SPI_SPCCR)
+ *
+ ****************************************************************************/
+void
+initSpiForLcd(void)
+{
+  SPI_SPCCR = 0x08;
+  SPI_SPCR  = 0x20;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The timebase is the virtual clock (the timer is not modelled)
+ *
+ ****************************************************************************/
+void
+initTimebase(void)
+{
+}
+
+tU32
+nowUs(void)
+{
+  return (tU32)(fakeOsNow() / FAKE_TIME_US);
+}
@@ -0,0 +1,339 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeI2c.c
+ *
+ * Description:
+ *    Stand-in for i2c.c in the host build of the firmware, with models
+ *    of the PCA9532 port expander and the 24C16 EEPROM (the only devices
+ *    on the bus; nothing else acknowledges its address).
+ *
+ *    The functions keep the status codes of the I2C block, so eeprom.c
+ *    is compiled unchanged. A transfer completes at once; every byte is
+ *    charged nine bit times (plus one for start and stop conditions) on
+ *    the I2C time line, and the CPU waits for it, as it polls the status.
+ *    The PCA9532 input register 0 reads the keys of the host (active low).
+ *    The EEPROM starts erased and writes at once (no burn cycle).
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <string.h>
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include "../i2c.h"
+#include "../key.h"
+#include "fakeI2c.h"
+#include "fakeBus.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define PCA9532_INPUT0  0x00
+#define PCA9532_AI      0x10     //auto increment of the register pointer
+
+#define EEPROM_PAGE     16       //bytes, a write wraps within the page
+
+#define DEV_NONE        0
+#define DEV_PCA9532     1
+#define DEV_EEPROM      2
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tCntSem i2cSem;
+
+static tU8   status = 0xf8;
+static tBool si;                 //status changed (SI flag)
+static tU8   device;             //addressed device (DEV_)
+static tBool controlNext;        //next byte written is the control register
+static tU8   control;
+static tU8   data;
+
+static tU8  regs[FAKE_PCA9532_REGS];
+static tU8  eeprom[FAKE_EEPROM_SIZE];
+static tU16 eepromAddr;           //address counter of the EEPROM
+static tBool eepromInit;
+static tU8 (*pKeysFunc)(void);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Set the function that returns the pressed keys (KEY_ bit mask)
+ *
+ ****************************************************************************/
+void
+fakeI2cKeys(tU8 (*pKeys)(void))
+{
+  pKeysFunc = pKeys;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The registers of the PCA9532 (LED selectors, prescalers and PWM)
+ *
+ ****************************************************************************/
+const tU8*
+fakePca9532(void)
+{
+  return regs;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Charge bits on the I2C bus
+ *
+ ****************************************************************************/
+static void
+charge(tU32 bits)
+{
+  fakeBusCharge(FAKE_BUS_I2C, bits, fakeBusBitTime(FAKE_I2C_SCL_PCLK));
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read the register the PCA9532 register pointer points at
+ *
+ ****************************************************************************/
+static tU8
+readRegister(void)
+{
+  tU8 reg = control & 0x0f;
+  tU8 keys;
+  tU8 value = 0xff;
+
+  if (reg == PCA9532_INPUT0)
+  {
+    keys = (pKeysFunc != NULL) ? pKeysFunc() : KEY_NOTHING;
+    if (keys & KEY_CENTER) value &= ~0x01;
+    if (keys & KEY_LEFT)   value &= ~0x02;
+    if (keys & KEY_UP)     value &= ~0x04;
+    if (keys & KEY_RIGHT)  value &= ~0x08;
+    if (keys & KEY_DOWN)   value &= ~0x10;
+  }
+  else if (reg < FAKE_PCA9532_REGS)
+    value = regs[reg];
+
+  if (control & PCA9532_AI)
+    control = (control & 0xf0) | ((reg + 1) % FAKE_PCA9532_REGS);
+  return value;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write the register the PCA9532 register pointer points at
+ *
+ ****************************************************************************/
+static void
+writeRegister(tU8 value)
+{
+  tU8 reg = control & 0x0f;
+
+  if (reg < FAKE_PCA9532_REGS)
+    regs[reg] = value;
+  if (control & PCA9532_AI)
+    control = (control & 0xf0) | ((reg + 1) % FAKE_PCA9532_REGS);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write a byte to the EEPROM. The first byte after the device address
+ *    is the low byte of the address (the block is in the device address).
+ *
+ ****************************************************************************/
+static void
+writeEeprom(tU8 value)
+{
+  if (controlNext == TRUE)
+    eepromAddr = (eepromAddr & 0x700) | value;
+  else
+  {
+    eeprom[eepromAddr] = value;
+    eepromAddr = (eepromAddr & ~(EEPROM_PAGE - 1)) |
+                 ((eepromAddr + 1) & (EEPROM_PAGE - 1));
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read the next byte of the EEPROM
+ *
+ ****************************************************************************/
+static tU8
+readEeprom(void)
+{
+  tU8 value = eeprom[eepromAddr];
+
+  eepromAddr = (eepromAddr + 1) % FAKE_EEPROM_SIZE;
+  return value;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    i2c.h
+ *
+ ****************************************************************************/
+void
+getI2cLock(void)
+{
+  tU8 error;
+  osSemTake(&i2cSem, 0, &error);
+}
+
+void
+releaseI2cLock(void)
+{
+  tU8 error;
+  osSemGive(&i2cSem, &error);
+}
+
+tU8
+i2cCheckStatus(void)
+{
+  return (si == TRUE) ? status : 0xf8;
+}
+
+void
+i2cInit(void)
+{
+  status = 0xf8;
+  si     = FALSE;
+  osSemInit(&i2cSem, 1);
+
+  if (eepromInit == FALSE)
+  {
+    memset(eeprom, 0xff, sizeof(eeprom));
+    eepromInit = TRUE;
+  }
+}
+
+tS8
+i2cStart(void)
+{
+  charge(1);
+  status = 0x08;
+  si     = TRUE;
+  return I2C_CODE_OK;
+}
+
+tS8
+i2cRepeatStart(void)
+{
+  charge(1);
+  status = 0x10;
+  si     = TRUE;
+  return I2C_CODE_OK;
+}
+
+tS8
+i2cStop(void)
+{
+  charge(1);
+  status = 0xf8;
+  si     = FALSE;
+  return I2C_CODE_OK;
+}
+
+tS8
+i2cPutChar(tU8 byte)
+{
+  if (si == FALSE)
+    return I2C_CODE_BUSY;
+
+  charge(9);
+
+  //address after a start condition
+  if (status == 0x08 || status == 0x10)
+  {
+    device = DEV_NONE;
+    if ((byte & 0xfe) == FAKE_PCA9532_ADDR)
+      device = DEV_PCA9532;
+    else if ((byte & 0xf0) == FAKE_EEPROM_ADDR)
+    {
+      device     = DEV_EEPROM;
+      eepromAddr = ((tU16)(byte & 0x0e) << 7) | (eepromAddr & 0xff);
+    }
+    controlNext = TRUE;
+    if (byte & 0x01)
+      status = (device != DEV_NONE) ? 0x40 : 0x48;
+    else
+      status = (device != DEV_NONE) ? 0x18 : 0x20;
+  }
+
+  //data byte
+  else if (device != DEV_NONE)
+  {
+    if (device == DEV_EEPROM)
+      writeEeprom(byte);
+    else if (controlNext == TRUE)
+      control = byte;
+    else
+      writeRegister(byte);
+    controlNext = FALSE;
+    status = 0x28;
+  }
+  else
+    status = 0x30;
+
+  return I2C_CODE_OK;
+}
+
+tS8
+i2cGetChar(tU8 mode, tU8* pData)
+{
+  if (mode == I2C_MODE_READ)
+  {
+    if (si == FALSE)
+      return I2C_CODE_EMPTY;
+    *pData = data;
+    return I2C_CODE_OK;
+  }
+
+  //receive the next byte, with ACK (more to come) or NACK (last byte)
+  charge(9);
+  if (device == DEV_EEPROM)
+    data = readEeprom();
+  else if (device == DEV_PCA9532)
+    data = readRegister();
+  else
+    data = 0xff;
+  status = (mode == I2C_MODE_ACK0) ? 0x50 : 0x58;
+  si     = TRUE;
+  return I2C_CODE_OK;
+}
+
+tS8
+i2cWriteWithWait(tU8 byte)
+{
+  tU8 s;
+
+  if (i2cPutChar(byte) != I2C_CODE_OK)
+    return I2C_CODE_ERROR;
+
+  s = i2cCheckStatus();
+  if (s == 0x18 || s == 0x28)
+    return I2C_CODE_OK;
+  return I2C_CODE_ERROR;
+}
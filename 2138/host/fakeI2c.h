@@ -0,0 +1,36 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeI2c.h
+ *
+ * Description:
+ *    Stand-in for i2c.c in the host build of the firmware, with a model
+ *    of the PCA9532 port expander.
+ *
+ *****************************************************************************/
+#ifndef _FAKE_I2C_H_
+#define _FAKE_I2C_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define FAKE_I2C_SCL_PCLK  50      //I2C_SCLH + I2C_SCLL of i2cInit()
+#define FAKE_PCA9532_ADDR  0xc0
+#define FAKE_PCA9532_REGS  10
+#define FAKE_EEPROM_ADDR   0xa0    //24C16, the block in bits 1-3
+#define FAKE_EEPROM_SIZE   0x0800
+
+
+void fakeI2cKeys(tU8 (*pKeys)(void));
+const tU8* fakePca9532(void);
+
+#endif
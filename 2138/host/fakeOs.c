@@ -0,0 +1,799 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeOs.c
+ *
+ * Description:
+ *    The operating system (osapi.h) on pthreads for the host build of the
+ *    firmware.
+ *
+ *    Every process is a thread, but only the process that owns the CPU
+ *    runs. The others wait on their condition variable, so processes are
+ *    switched at OS calls only. A higher priority process that is woken
+ *    by the timer tick takes the CPU at once, but the thread of the
+ *    process it preempts runs on until its next OS call (a polling loop
+ *    without OS calls keeps running beside it).
+ *    One lock protects the OS and stands in for disabled interrupts;
+ *    disIrq() takes it, and the LCD bus ISR (host/fakeSpi.c) and the
+ *    timer tick run with it.
+ *
+ *    The virtual clock moves when bus time is charged, when all processes
+ *    wait (to the next tick or to the time a process was woken) and when
+ *    the running process makes no OS call for FAKE_SPIN_US of real time
+ *    (a polling loop, to the next tick). The time the firmware itself
+ *    executes is not modelled.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include "fakeOs.h"
+#include "fakeBus.h"
+#include "fakeSpi.h"
+#include "../pre_emptive_os/api/osapi.h"
+#include "../irq_code/irqUart.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define PROC_FREE    0
+#define PROC_CREATED 1
+#define PROC_READY   2
+#define PROC_SLEEP   3
+#define PROC_SEM     4
+
+typedef struct
+{
+  pthread_t      thread;
+  pthread_cond_t run;          //signalled when the process gets the CPU
+  void         (*pProc)(void* arg);
+  void*          pParam;
+  tU8            prio;
+  tU8            state;
+  tU32           wakeTick;     //end of sleep or semaphore timeout (0 = none)
+  tCntSem*       pSem;
+  tBool          semTaken;
+  tFakeTime      readyAt;      //virtual time the process was woken
+} tFakeProc;
+
+
+/*****************************************************************************
+ * External functions
+ ****************************************************************************/
+void appTick(tU32 elapsedTime);
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t       lockOwner;
+static tU32            lockDepth;
+static tU32            irqOff;          //nesting of disIrq()
+
+static tFakeProc  procs[MAX_NUM_PROC];
+static tFakeProc* pRunning;             //process that owns the CPU
+static tFakeProc* pLast;                //process that owned it last
+static tBool      started;
+static tU32       isrDepth;             //timer tick in progress
+static tU32       busyWaits;            //running process waits on the bus
+static tU32       progress;             //OS calls and charged time
+
+static tFakeTime  now;
+static tU32       ticks;
+static tFakeTime  endTime = FAKE_TIME_MAX;
+static void     (*pEndFunc)(void);
+
+static pthread_cond_t startCond = PTHREAD_COND_INITIALIZER;
+static pthread_t      spinThread;
+
+static __thread tFakeProc* pSelf;       //process of the calling thread
+static __thread tBool      isrThread;   //the calling thread is an ISR
+static __thread tFakeTime  isrTime;     //virtual time of that ISR
+
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static void schedule(void);
+static void waitCpu(void);
+static tFakeProc* pickReady(void);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Take the OS lock (recursive)
+ *
+ ****************************************************************************/
+void
+fakeOsLock(void)
+{
+  if (lockDepth > 0 && pthread_equal(lockOwner, pthread_self()))
+  {
+    lockDepth++;
+    return;
+  }
+  pthread_mutex_lock(&lock);
+  lockOwner = pthread_self();
+  lockDepth = 1;
+  waitCpu();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Release the OS lock
+ *
+ ****************************************************************************/
+void
+fakeOsUnlock(void)
+{
+  if (lockDepth == 1)
+    waitCpu();
+  if (--lockDepth == 0)
+    pthread_mutex_unlock(&lock);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait on a condition variable with the OS lock released (at any
+ *    depth). Not possible with disabled interrupts.
+ *
+ * Params:
+ *    [in] pCond     - condition variable
+ *    [in] timeoutUs - real time to wait at most, 0 waits until signalled
+ *
+ * Returns:
+ *    FALSE if it was not possible to wait
+ *
+ ****************************************************************************/
+tBool
+fakeOsWait(pthread_cond_t* pCond, tU32 timeoutUs)
+{
+  tU32 depth = lockDepth;
+  tBool busy = (pSelf != NULL && pSelf == pRunning);
+
+  if (irqOff > 0)
+    return FALSE;
+
+  if (busy == TRUE)
+    busyWaits++;
+  lockDepth = 0;
+  if (timeoutUs == 0)
+    pthread_cond_wait(pCond, &lock);
+  else
+  {
+    struct timespec until;
+
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_nsec += (long)timeoutUs * 1000;
+    until.tv_sec  += until.tv_nsec / 1000000000;
+    until.tv_nsec %= 1000000000;
+    pthread_cond_timedwait(pCond, &lock, &until);
+  }
+  lockOwner = pthread_self();
+  lockDepth = depth;
+  if (busy == TRUE)
+    busyWaits--;
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Mark the calling thread as an ISR running at a virtual time. The
+ *    processes it wakes are ready from that time.
+ *
+ ****************************************************************************/
+void
+fakeOsIsrTime(tFakeTime time)
+{
+  isrThread = TRUE;
+  isrTime   = time;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Disable/restore interrupts (irq_code/irqUart.h)
+ *
+ ****************************************************************************/
+tU32
+disIrq(void)
+{
+  fakeOsLock();
+  irqOff++;
+  return 0;
+}
+
+void
+restoreIrq(tU32 restoreValue)
+{
+  irqOff--;
+  fakeOsUnlock();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Current time of the virtual clock
+ *
+ ****************************************************************************/
+tFakeTime
+fakeOsNow(void)
+{
+  return now;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Pid of the process that owns the CPU, or owned it last when all
+ *    processes wait (FAKE_NO_PID before the first process runs)
+ *
+ ****************************************************************************/
+tU8
+fakeOsRunning(void)
+{
+  if (pLast == NULL)
+    return FAKE_NO_PID;
+  return (tU8)(pLast - procs);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Set the virtual time at which the run ends, and the function that is
+ *    called then (it must not return).
+ *
+ ****************************************************************************/
+void
+fakeOsEnd(tFakeTime time, void (*pEnd)(void))
+{
+  endTime  = time;
+  pEndFunc = pEnd;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Virtual time of the next timer tick
+ *
+ ****************************************************************************/
+static tFakeTime
+nextTick(void)
+{
+  return (tFakeTime)(ticks + 1) * FAKE_TICK_MS * FAKE_TIME_MS;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    A process preempted by the timer tick waits here for the CPU when
+ *    it enters or leaves the OS (the OS lock is held once).
+ *
+ ****************************************************************************/
+static void
+waitCpu(void)
+{
+  if (pSelf != NULL && pSelf->state == PROC_READY && irqOff == 0)
+    while(pRunning != pSelf)
+      fakeOsWait(&pSelf->run, 0);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Give the CPU to a higher priority process that the timer tick made
+ *    ready. The running process stops in waitCpu().
+ *
+ ****************************************************************************/
+static void
+interrupt(void)
+{
+  tFakeProc* p = pickReady();
+
+  if (pRunning != NULL && p != NULL && p->prio < pRunning->prio)
+  {
+    pRunning = p;
+    pLast    = p;
+    pthread_cond_signal(&p->run);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The timer tick: appTick() in interrupt context, then the processes
+ *    whose sleep or semaphore timeout ends are woken.
+ *
+ ****************************************************************************/
+static void
+tick(void)
+{
+  tU8 i;
+
+  ticks++;
+  isrDepth++;
+  appTick(FAKE_TICK_MS);
+  isrDepth--;
+
+  for(i=0; i<MAX_NUM_PROC; i++)
+  {
+    tFakeProc* p = &procs[i];
+
+    if ((p->state == PROC_SLEEP || p->state == PROC_SEM) &&
+        p->wakeTick != 0 && p->wakeTick <= ticks)
+    {
+      p->state   = PROC_READY;
+      p->readyAt = now;
+    }
+  }
+  interrupt();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Move the virtual clock forward. The timer ticks on the way are
+ *    executed unless interrupts are disabled or this is called from the
+ *    tick itself (then they are executed at the next advance). The LCD
+ *    bus is brought up to the time of each tick first, since it may wake
+ *    a process before the tick.
+ *
+ ****************************************************************************/
+void
+fakeOsAdvance(tFakeTime time)
+{
+  fakeOsLock();
+  progress++;
+
+  if (started == TRUE && irqOff == 0 && isrDepth == 0)
+  {
+    while(nextTick() <= time)
+    {
+      fakeSpiSync(nextTick());
+      if (now < nextTick())
+        now = nextTick();
+      tick();
+      if (now >= endTime)
+        pEndFunc();
+    }
+  }
+  if (now < time)
+    now = time;
+  if (now >= endTime && isrDepth == 0)
+    pEndFunc();
+
+  fakeOsUnlock();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Pick the process to run: the highest priority process that is ready
+ *    at the current virtual time. The running process is kept among
+ *    processes of the same priority.
+ *
+ ****************************************************************************/
+static tFakeProc*
+pickReady(void)
+{
+  tFakeProc* pBest = NULL;
+  tU8 i;
+
+  for(i=0; i<MAX_NUM_PROC; i++)
+  {
+    tFakeProc* p = &procs[i];
+
+    if (p->state != PROC_READY || p->readyAt > now)
+      continue;
+    if (pBest == NULL || p->prio < pBest->prio ||
+        (p->prio == pBest->prio && p == pRunning))
+      pBest = p;
+  }
+  return pBest;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Nothing is ready: let the LCD bus catch up with the next tick, then
+ *    move the clock to the next tick or to the earliest woken process.
+ *
+ ****************************************************************************/
+static void
+idle(void)
+{
+  tFakeTime next;
+  tU8 i;
+
+  fakeSpiSync(nextTick());
+
+  //a process that waits on a semaphore while the LCD bus is idle waits
+  //for input (not for the LCD list), its frame is done
+  if (fakeSpiIdle() == TRUE)
+    for(i=0; i<MAX_NUM_PROC; i++)
+      if (procs[i].state == PROC_SEM)
+        fakeBusFrame(i);
+
+  next = nextTick();
+  for(i=0; i<MAX_NUM_PROC; i++)
+    if (procs[i].state == PROC_READY && procs[i].readyAt < next)
+      next = procs[i].readyAt;
+
+  fakeOsAdvance(next);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Give the CPU to the process that shall run (the OS lock is held).
+ *
+ ****************************************************************************/
+static void
+schedule(void)
+{
+  tFakeProc* p;
+
+  progress++;
+  for(;;)
+  {
+    p = pickReady();
+    if (p != NULL)
+    {
+      pLast = p;
+      if (p != pRunning)
+      {
+        pRunning = p;
+        pthread_cond_signal(&p->run);
+      }
+      return;
+    }
+    pRunning = NULL;
+    idle();
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Schedule and wait until the calling process owns the CPU again
+ *
+ ****************************************************************************/
+static void
+yield(void)
+{
+  schedule();
+  while(pRunning != pSelf)
+    fakeOsWait(&pSelf->run, 0);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Let a process that was just made ready run if it has higher priority
+ *    than the running process.
+ *
+ ****************************************************************************/
+static void
+preempt(tFakeProc* pReady)
+{
+  if (pSelf != NULL && pSelf == pRunning && isrDepth == 0 &&
+      pReady->prio < pSelf->prio && pReady->readyAt <= now)
+    yield();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Thread of a process. It waits for the CPU before the entry function
+ *    is called; a process that returns is deleted.
+ *
+ ****************************************************************************/
+static void*
+procThread(void* pArg)
+{
+  pSelf = (tFakeProc*)pArg;
+
+  //a process that polls must not keep the ISR threads from the host CPU
+  setpriority(PRIO_PROCESS, syscall(SYS_gettid), FAKE_PROC_NICE);
+
+  fakeOsLock();
+  while(pRunning != pSelf)
+    fakeOsWait(&pSelf->run, 0);
+  fakeOsUnlock();
+
+  pSelf->pProc(pSelf->pParam);
+  osDeleteProcess();
+  return NULL;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Watches the running process. When it makes no OS call and charges no
+ *    time for FAKE_SPIN_US of real time it polls (or computes), and the
+ *    clock is moved to the next tick so that the tick can end the loop.
+ *
+ ****************************************************************************/
+static void*
+spinWatch(void* pArg)
+{
+  tU32 seen = 0;
+
+  for(;;)
+  {
+    usleep(FAKE_SPIN_US);
+
+    fakeOsLock();
+    if (pRunning != NULL && busyWaits == 0 && progress == seen)
+    {
+      //a polling process waits like a sleeping one, its frame is done
+      fakeBusFrame(fakeOsRunning());
+      fakeOsAdvance(nextTick());
+    }
+    seen = progress;
+    fakeOsUnlock();
+  }
+  return NULL;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    osapi.h
+ *
+ ****************************************************************************/
+void
+osInit(void)
+{
+  tU8 i;
+
+  for(i=0; i<MAX_NUM_PROC; i++)
+  {
+    procs[i].state = PROC_FREE;
+    pthread_cond_init(&procs[i].run, NULL);
+  }
+}
+
+void
+osStart(void)
+{
+  fakeOsLock();
+  started = TRUE;
+  pthread_create(&spinThread, NULL, spinWatch, NULL);
+  schedule();
+
+  //the calling thread is not a process
+  for(;;)
+    fakeOsWait(&startCond, 0);
+}
+
+void
+osCreateProcess(void (*pProc)(void* arg), tU8* pStk, tU16 stkSize, tU8* pPid,
+                tU8 prio, void* pParam, tU8* pError)
+{
+  tU8 i;
+
+  if (prio >= NUM_PRIO)
+  {
+    *pError = OS_ERROR_PRIO;
+    return;
+  }
+
+  fakeOsLock();
+  for(i=0; i<MAX_NUM_PROC; i++)
+    if (procs[i].state == PROC_FREE)
+      break;
+
+  if (i == MAX_NUM_PROC)
+    *pError = OS_ERROR_ALLOCATE;
+  else
+  {
+    tFakeProc* p = &procs[i];
+
+    p->pProc    = pProc;
+    p->pParam   = pParam;
+    p->prio     = prio;
+    p->state    = PROC_CREATED;
+    p->wakeTick = 0;
+    p->pSem     = NULL;
+    pthread_create(&p->thread, NULL, procThread, p);
+    pthread_detach(p->thread);
+    *pPid   = i;
+    *pError = OS_OK;
+  }
+  fakeOsUnlock();
+}
+
+void
+osStartProcess(tU8 pid, tU8* pError)
+{
+  if (pid >= MAX_NUM_PROC || procs[pid].state != PROC_CREATED)
+  {
+    *pError = OS_ERROR_PID;
+    return;
+  }
+
+  fakeOsLock();
+  procs[pid].state   = PROC_READY;
+  procs[pid].readyAt = now;
+  *pError = OS_OK;
+  preempt(&procs[pid]);
+  fakeOsUnlock();
+}
+
+void
+osDeleteProcess(void)
+{
+  fakeOsLock();
+  pSelf->state = PROC_FREE;
+  pRunning     = NULL;
+  schedule();
+  fakeOsUnlock();
+  pthread_exit(NULL);
+}
+
+tU8
+osPid(tU8* pError)
+{
+  if (pSelf == NULL)
+  {
+    *pError = OS_ERROR_ISR;
+    return 0;
+  }
+  *pError = OS_OK;
+  return (tU8)(pSelf - procs);
+}
+
+void
+osSleep(tU32 ticksToSleep)
+{
+  fakeOsLock();
+  fakeBusFrame(fakeOsRunning());
+
+  if (ticksToSleep == 0)
+    pSelf->readyAt = now;
+  else
+  {
+    pSelf->state    = PROC_SLEEP;
+    pSelf->wakeTick = ticks + ticksToSleep;
+  }
+  yield();
+  pSelf->wakeTick = 0;
+  fakeOsUnlock();
+}
+
+void
+osISREnter(void)
+{
+}
+
+void
+osISRExit(void)
+{
+}
+
+void
+osSemInit(tCntSem* pSem, tU16 initial)
+{
+  pSem->cnt = initial;
+}
+
+tBool
+osSemTake(tCntSem* pSem, tU32 timeout, tU8* pError)
+{
+  tBool taken = TRUE;
+
+  fakeOsLock();
+  progress++;
+
+  if (pSem->cnt > 0)
+    pSem->cnt--;
+
+  //not possible to wait in an ISR, or before the OS is started
+  else if (pSelf == NULL || isrDepth > 0)
+    taken = FALSE;
+
+  else
+  {
+    pSelf->state    = PROC_SEM;
+    pSelf->pSem     = pSem;
+    pSelf->semTaken = FALSE;
+    pSelf->wakeTick = (timeout == 0) ? 0 : ticks + timeout;
+    yield();
+    taken = pSelf->semTaken;
+    pSelf->pSem     = NULL;
+    pSelf->wakeTick = 0;
+  }
+
+  if (taken == TRUE)
+    *pError = OS_OK;
+  else if (pSelf == NULL || isrDepth > 0)
+    *pError = OS_ERROR_ISR;
+  else
+    *pError = OS_ERROR_TIMEOUT;
+  fakeOsUnlock();
+  return taken;
+}
+
+tU8
+osSemTryTake(tCntSem* pSem, tU8* pError)
+{
+  tU8 taken = FALSE;
+
+  fakeOsLock();
+  if (pSem->cnt > 0)
+  {
+    pSem->cnt--;
+    taken = TRUE;
+  }
+  *pError = OS_OK;
+  fakeOsUnlock();
+  return taken;
+}
+
+void
+osSemGive(tCntSem* pSem, tU8* pError)
+{
+  tFakeProc* pWaiter = NULL;
+  tU8 i;
+
+  fakeOsLock();
+  progress++;
+
+  for(i=0; i<MAX_NUM_PROC; i++)
+  {
+    tFakeProc* p = &procs[i];
+
+    if (p->state == PROC_SEM && p->pSem == pSem &&
+        (pWaiter == NULL || p->prio < pWaiter->prio))
+      pWaiter = p;
+  }
+
+  *pError = OS_OK;
+  if (pWaiter == NULL)
+    pSem->cnt++;
+  else
+  {
+    pWaiter->state    = PROC_READY;
+    pWaiter->semTaken = TRUE;
+    pWaiter->readyAt  = (isrThread == TRUE) ? isrTime : now;
+    preempt(pWaiter);
+  }
+  fakeOsUnlock();
+}
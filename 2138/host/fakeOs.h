@@ -0,0 +1,50 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeOs.h
+ *
+ * Description:
+ *    The operating system (osapi.h) on pthreads for the host build of the
+ *    firmware, with a virtual clock that only moves when modelled time is
+ *    charged (host/fakeBus.c) or when all processes wait.
+ *
+ *****************************************************************************/
+#ifndef _FAKE_OS_H_
+#define _FAKE_OS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <pthread.h>
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+typedef unsigned long long tFakeTime;   //nanoseconds of the virtual clock
+
+#define FAKE_TIME_US   1000ULL
+#define FAKE_TIME_MS   1000000ULL
+#define FAKE_TIME_MAX  (~0ULL)
+
+#define FAKE_TICK_MS   10      //one timer tick of the OS
+#define FAKE_SPIN_US   2000    //real time without progress before the clock moves
+#define FAKE_NO_PID    0xff
+#define FAKE_PROC_NICE 19      //host scheduling of the process threads
+
+
+void      fakeOsLock(void);
+void      fakeOsUnlock(void);
+tBool     fakeOsWait(pthread_cond_t* pCond, tU32 timeoutUs);
+void      fakeOsIsrTime(tFakeTime time);
+
+tFakeTime fakeOsNow(void);
+void      fakeOsAdvance(tFakeTime time);
+tU8       fakeOsRunning(void);
+void      fakeOsEnd(tFakeTime time, void (*pEnd)(void));
+
+#endif
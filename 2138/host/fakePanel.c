@@ -0,0 +1,132 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakePanel.c
+ *
+ * Description:
+ *    In-memory model of the 130x130 LCD for host builds. Replaces lcd.c:
+ *    lcdRect(), lcdIcon() and lcdFlush() draw directly in a pixel array
+ *    and count windows and pixels, so that what a module sends to the
+ *    LCD can be checked pixel by pixel.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "fakePanel.h"
+#include "../lcd.h"
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tFakePanel panel;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Clear the panel to a color and reset the counters.
+ *
+ ****************************************************************************/
+void
+fakePanelReset(tU8 color)
+{
+  tU32 x, y;
+
+  for(y=0; y<FAKE_PANEL_SIZE; y++)
+    for(x=0; x<FAKE_PANEL_SIZE; x++)
+      panel.pixel[y][x] = color;
+
+  panel.windows = 0;
+  panel.pixels  = 0;
+  panel.flushes = 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the panel contents and counters.
+ *
+ ****************************************************************************/
+const tFakePanel*
+fakePanel(void)
+{
+  return &panel;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write one pixel in the current window order (pixels outside the
+ *    panel are counted but not stored).
+ *
+ ****************************************************************************/
+static void
+putPixel(tU32 x, tU32 y, tU8 color)
+{
+  panel.pixels++;
+  if ((x < FAKE_PANEL_SIZE) && (y < FAKE_PANEL_SIZE))
+    panel.pixel[y][x] = color;
+}
+
+
+void
+lcdRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color)
+{
+  tU32 i, j;
+
+  panel.windows++;
+  for(j=0; j<yLen; j++)
+    for(i=0; i<xLen; i++)
+      putPixel(x + i, y + j, color);
+}
+
+
+void
+lcdIcon(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData)
+{
+  tU32 i, j;
+  tU8  runLeft = 0;
+  tU8  color   = 0;
+
+  panel.windows++;
+  for(j=0; j<yLen; j++)
+    for(i=0; i<xLen; i++)
+    {
+      if (compressionOn == FALSE)
+        color = *pData++;
+      else
+      {
+        while(runLeft == 0)
+        {
+          if (*pData == escapeChar)
+          {
+            runLeft = pData[1];
+            color   = pData[2];
+            pData  += 3;
+          }
+          else
+          {
+            runLeft = 1;
+            color   = *pData++;
+          }
+        }
+        runLeft--;
+      }
+      putPixel(x + i, y + j, color);
+    }
+}
+
+
+void
+lcdFlush(void)
+{
+  panel.flushes++;
+}
@@ -0,0 +1,40 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakePanel.h
+ *
+ * Description:
+ *    In-memory model of the 130x130 LCD for host builds. Implements the
+ *    lcd.c drawing functions used by the compositor.
+ *
+ *****************************************************************************/
+#ifndef _FAKE_PANEL_H_
+#define _FAKE_PANEL_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define FAKE_PANEL_SIZE 130
+
+typedef struct
+{
+  tU32 windows;             //number of windows (drawing calls)
+  tU32 pixels;              //number of pixels written
+  tU32 flushes;             //number of lcdFlush() calls
+  tU8  pixel[FAKE_PANEL_SIZE][FAKE_PANEL_SIZE];   //[y][x]
+} tFakePanel;
+
+
+void fakePanelReset(tU8 color);
+const tFakePanel* fakePanel(void);
+
+#endif
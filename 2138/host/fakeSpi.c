@@ -0,0 +1,171 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeSpi.c
+ *
+ * Description:
+ *    Model of the SPI0 block that drives the LCD display list (lcdList.c)
+ *    in the host build of the firmware, and the registers of
+ *    host/include/lpc2xxx.h.
+ *
+ *    A thread plays the SPI0 interrupt: when the interrupt is enabled
+ *    (SPIE) and a frame was written to SPI_SPDR, the frame is queued on
+ *    the SPI time line (8 bits at PCLK / SPI_SPCCR) and the LCD bus ISR
+ *    is called, with the OS lock held, at the virtual time the frame is
+ *    shifted out. The thread runs ahead of the virtual clock; the clock
+ *    waits for it (fakeSpiSync) before it passes a frame.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <sched.h>
+#include <lpc2xxx.h>
+#include "fakeSpi.h"
+#include "fakeBus.h"
+#include "../irq_code/irqLcd.h"
+
+
+/*****************************************************************************
+ * Public variables
+ ****************************************************************************/
+volatile tFakeRegs fakeRegs = { .spiSpdr = FAKE_SPI_EMPTY };
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static pthread_t      spiThread;
+static pthread_cond_t kickCond = PTHREAD_COND_INITIALIZER;   //bus checked
+static pthread_cond_t syncCond = PTHREAD_COND_INITIALIZER;   //bus moved
+static tFakeTime      syncUntil = FAKE_TIME_MAX;             //earliest wait
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Bit time programmed in SPI_SPCCR (which must be at least 8)
+ *
+ ****************************************************************************/
+tFakeTime
+fakeSpiBitTime(void)
+{
+  tU32 div = fakeRegs.spiSpccr;
+
+  if (div < 8)
+    div = 8;
+  return fakeBusBitTime(div);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check if the SPI interrupt is pending
+ *
+ ****************************************************************************/
+static tBool
+framePending(void)
+{
+  return (fakeRegs.spiSpcr & 0x80) != 0 && fakeRegs.spiSpdr != FAKE_SPI_EMPTY;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The SPI0 interrupt
+ *
+ ****************************************************************************/
+static void*
+spiIsr(void* pArg)
+{
+  tFakeTime end;
+
+  fakeOsLock();
+  for(;;)
+  {
+    if (framePending() == TRUE)
+    {
+      end = fakeBusQueue(FAKE_BUS_SPI, 8, fakeSpiBitTime());
+      fakeRegs.spiSpdr  = FAKE_SPI_EMPTY;
+      fakeRegs.spiSpsr |= 0x80;     //SPIF
+      fakeOsIsrTime(end);
+      lcdISR();
+    }
+    else
+      fakeOsWait(&kickCond, FAKE_SPI_POLL_US);
+
+    //wake the waiting clock only when the bus has reached its time
+    if (framePending() == FALSE || fakeBusFree(FAKE_BUS_SPI) >= syncUntil)
+    {
+      syncUntil = FAKE_TIME_MAX;
+      pthread_cond_broadcast(&syncCond);
+    }
+
+    //let the processes and the clock in between frames
+    fakeOsUnlock();
+    sched_yield();
+    fakeOsLock();
+  }
+  return NULL;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start the SPI0 interrupt thread
+ *
+ ****************************************************************************/
+void
+fakeSpiStart(void)
+{
+  pthread_create(&spiThread, NULL, spiIsr, NULL);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait (in real time) until the LCD bus has shifted out everything
+ *    before a virtual time, or has nothing left to send. Not possible with disabled
+ *    interrupts, since the ISR needs the OS lock.
+ *
+ ****************************************************************************/
+void
+fakeSpiSync(tFakeTime time)
+{
+  fakeOsLock();
+  while(framePending() == TRUE && fakeBusFree(FAKE_BUS_SPI) < time)
+  {
+    if (time < syncUntil)
+      syncUntil = time;
+    pthread_cond_signal(&kickCond);
+    if (fakeOsWait(&syncCond, 0) == FALSE)
+      break;
+  }
+  fakeOsUnlock();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check if the LCD bus has nothing left to send
+ *
+ ****************************************************************************/
+tBool
+fakeSpiIdle(void)
+{
+  tBool idle;
+
+  fakeOsLock();
+  idle = (framePending() == FALSE);
+  fakeOsUnlock();
+  return idle;
+}
@@ -0,0 +1,36 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeSpi.h
+ *
+ * Description:
+ *    Model of the SPI0 block that drives the LCD display list (lcdList.c)
+ *    in the host build of the firmware.
+ *
+ *****************************************************************************/
+#ifndef _FAKE_SPI_H_
+#define _FAKE_SPI_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "fakeOs.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define FAKE_SPI_EMPTY    0x100    //SPI_SPDR: no frame written
+#define FAKE_SPI_POLL_US  1000     //real time between checks of an idle bus
+
+
+void      fakeSpiStart(void);
+tFakeTime fakeSpiBitTime(void);
+void      fakeSpiSync(tFakeTime time);
+tBool     fakeSpiIdle(void);
+
+#endif
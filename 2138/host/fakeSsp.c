@@ -0,0 +1,197 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeSsp.c
+ *
+ * Description:
+ *    Register level model of the LPC213x SSP block for host builds.
+ *
+ *    The model has an 8-deep transmit and receive FIFO and a shift
+ *    register. Time advances one frame for every FAKE_SSP_READS_PER_FRAME
+ *    reads of SSPSR (a polling driver reads the status once per loop, and
+ *    the CPU is much faster than the serial bus) or explicitly with
+ *    fakeSspStep(). Every frame shifted out is stored in a log together
+ *    with statistics that show if the driver keeps the FIFO filled.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <string.h>
+#include "fakeSsp.h"
+#include "../ssp.h"
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tU32 cr0;
+static tU32 cr1;
+static tU32 cpsr;
+static tU32 imsc;
+static tU32 ris;
+
+static tU16 txFifo[SSP_FIFO_DEPTH];
+static tU8  txCnt;
+static tU16 rxFifo[SSP_FIFO_DEPTH];
+static tU8  rxCnt;
+static tBool shifting;
+static tU32  statusReads;
+
+static tFakeSspStat stat;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Reset the model (all registers to reset values, empty FIFOs and log)
+ *
+ ****************************************************************************/
+void
+fakeSspReset(void)
+{
+  cr0 = cr1 = cpsr = imsc = ris = 0;
+  txCnt = rxCnt = 0;
+  shifting = FALSE;
+  statusReads = 0;
+  memset(&stat, 0, sizeof(stat));
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Advance time a number of frame times. For each frame time the frame
+ *    in the shift register is completed (and received) and the next frame
+ *    is moved from the transmit FIFO into the shift register.
+ *
+ ****************************************************************************/
+void
+fakeSspStep(tU32 frameTimes)
+{
+  tU8 i;
+
+  while(frameTimes-- > 0)
+  {
+    if ((cr1 & 0x02) == 0 || txCnt == 0)
+    {
+      shifting = FALSE;
+      stat.idleCycles++;
+      continue;
+    }
+
+    if (stat.frames < FAKE_SSP_LOG_SIZE)
+      stat.log[stat.frames] = txFifo[0];
+    stat.frames++;
+
+    //receive one frame (the LCD controller drives nothing, read as zero)
+    if (rxCnt < SSP_FIFO_DEPTH)
+      rxFifo[rxCnt++] = 0;
+    else
+    {
+      stat.rxOverruns++;
+      ris |= 0x01;
+    }
+
+    for(i=1; i<txCnt; i++)
+      txFifo[i-1] = txFifo[i];
+    txCnt--;
+    shifting = (txCnt > 0);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write an SSP register
+ *
+ ****************************************************************************/
+void
+fakeSspWrite(tU32 reg, tU32 value)
+{
+  switch(reg)
+  {
+    case SSPCR0:  cr0  = value & 0xffff; break;
+    case SSPCR1:  cr1  = value & 0x0f;   break;
+    case SSPCPSR: cpsr = value & 0xfe;   break;
+    case SSPIMSC: imsc = value & 0x0f;   break;
+    case SSPICR:  ris &= ~(value & 0x03); break;
+    case SSPDR:
+      if (txCnt < SSP_FIFO_DEPTH)
+      {
+        txFifo[txCnt++] = value & ((1 << ((cr0 & 0x0f) + 1)) - 1);
+        if (txCnt > stat.maxTxLevel)
+          stat.maxTxLevel = txCnt;
+        shifting = TRUE;
+      }
+      else
+        stat.lostFrames++;
+      break;
+    default: break;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read an SSP register. Reading SSPSR advances time one frame.
+ *
+ ****************************************************************************/
+tU32
+fakeSspRead(tU32 reg)
+{
+  tU32 value = 0;
+  tU8  i;
+
+  switch(reg)
+  {
+    case SSPCR0:  value = cr0;  break;
+    case SSPCR1:  value = cr1;  break;
+    case SSPCPSR: value = cpsr; break;
+    case SSPIMSC: value = imsc; break;
+    case SSPRIS:  value = ris;  break;
+    case SSPMIS:  value = ris & imsc; break;
+    case SSPSR:
+      if (++statusReads >= FAKE_SSP_READS_PER_FRAME)
+      {
+        statusReads = 0;
+        fakeSspStep(1);
+      }
+      if (txCnt == 0)             value |= SSPSR_TFE;
+      if (txCnt < SSP_FIFO_DEPTH) value |= SSPSR_TNF;
+      if (rxCnt > 0)              value |= SSPSR_RNE;
+      if (rxCnt == SSP_FIFO_DEPTH) value |= SSPSR_RFF;
+      if (shifting || txCnt > 0)  value |= SSPSR_BSY;
+      break;
+    case SSPDR:
+      if (rxCnt > 0)
+      {
+        value = rxFifo[0];
+        for(i=1; i<rxCnt; i++)
+          rxFifo[i-1] = rxFifo[i];
+        rxCnt--;
+      }
+      break;
+    default: break;
+  }
+  return value;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get statistics and log of transmitted frames
+ *
+ ****************************************************************************/
+const tFakeSspStat*
+fakeSspStat(void)
+{
+  return &stat;
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeSsp.h
+ *
+ * Description:
+ *    Register level model of the LPC213x SSP block for host builds.
+ *    ssp.c is compiled unchanged against it (with HOST_BUILD defined).
+ *
+ *****************************************************************************/
+#ifndef _FAKE_SSP_H_
+#define _FAKE_SSP_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+//register identifiers (offset from SSP base address)
+#define SSPCR0   0x00
+#define SSPCR1   0x04
+#define SSPDR    0x08
+#define SSPSR    0x0C
+#define SSPCPSR  0x10
+#define SSPIMSC  0x14
+#define SSPRIS   0x18
+#define SSPMIS   0x1C
+#define SSPICR   0x20
+
+#define SSP_WRITE(reg, value) fakeSspWrite((reg), (value))
+#define SSP_READ(reg)         fakeSspRead(reg)
+
+#define FAKE_SSP_LOG_SIZE        20000
+#define FAKE_SSP_READS_PER_FRAME 16   //status polls during one 9-bit frame
+
+typedef struct
+{
+  tU32 frames;              //number of frames shifted out
+  tU32 lostFrames;          //writes to SSPDR while transmit FIFO was full
+  tU32 rxOverruns;          //frames received while receive FIFO was full
+  tU32 idleCycles;          //frame times where nothing was shifted out
+  tU32 maxTxLevel;          //highest transmit FIFO level seen
+  tU16 log[FAKE_SSP_LOG_SIZE];
+} tFakeSspStat;
+
+
+void  fakeSspReset(void);
+void  fakeSspWrite(tU32 reg, tU32 value);
+tU32  fakeSspRead(tU32 reg);
+void  fakeSspStep(tU32 frameTimes);
+const tFakeSspStat* fakeSspStat(void);
+
+#endif
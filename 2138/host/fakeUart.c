@@ -0,0 +1,185 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fakeUart.c
+ *
+ * Description:
+ *    Stand-in for uart.c and the console of the startup library in the
+ *    host build of the firmware.
+ *
+ *    UART #1 (Bluetooth module) shifts out its characters in the
+ *    background, as the interrupt driven driver does; the CPU only waits
+ *    when the transmit buffer is full. No module answers, nothing is
+ *    ever received. The console (UART #0) is polled, the CPU waits for
+ *    every character, which is also written to stdout.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdarg.h>
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include "../uart.h"
+#include "../perf.h"
+#include "config.h"
+#include "consol.h"
+#include "fakeBus.h"
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tFakeTime uart1CharTime;    //start, data, parity and stop bits
+static tFakeTime uart1BitTime;
+static tU32      uart1Bits = 10;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize UART #1: the bit time and the bits of a character
+ *
+ ****************************************************************************/
+void
+initUart1(tU16 div_factor, tU8 mode, tU8 fifo_mode)
+{
+  uart1Bits = 1 + 5 + (mode & 0x03) + ((mode & 0x04) ? 2 : 1) +
+              ((mode & 0x08) ? 1 : 0);
+  uart1BitTime  = fakeBusBitTime(16 * (tU32)div_factor);
+  uart1CharTime = uart1Bits * uart1BitTime;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send a character to UART #1. The CPU waits while the transmit
+ *    buffer is full.
+ *
+ ****************************************************************************/
+void
+uart1SendChar(tU8 charToSend)
+{
+  tFakeTime end = fakeBusQueue(FAKE_BUS_UART1, uart1Bits, uart1BitTime);
+
+  PERF_UART1_BYTE();
+
+  if (end > fakeOsNow() + TX_BUFFER_SIZE * uart1CharTime)
+    fakeOsAdvance(end - TX_BUFFER_SIZE * uart1CharTime);
+}
+
+void
+uart1SendCh(tU8 charToSend)
+{
+  if(charToSend == '\n')
+    uart1SendChar('\r');
+
+  uart1SendChar(charToSend);
+}
+
+void
+uart1SendString(tU8 *pString)
+{
+  while(*pString)
+    uart1SendCh(*pString++);
+}
+
+void
+uart1SendChars(char *pBuff, tU16 count)
+{
+  while (count--)
+    uart1SendChar(*pBuff++);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Receive from UART #1: nothing is ever received
+ *
+ ****************************************************************************/
+tU8
+uart1GetChar(tU8 *pRxChar)
+{
+  return FALSE;
+}
+
+tU8
+uart1GetCh(void)
+{
+  for(;;)
+    osSleep(1);
+  return 0;
+}
+
+tU8
+uart1GetChSem(void)
+{
+  return uart1GetCh();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Console (UART #0, polled)
+ *
+ ****************************************************************************/
+void
+consolInit(void)
+{
+}
+
+void
+consolSendChar(char charToSend)
+{
+  fakeBusCharge(FAKE_BUS_UART0, 10, fakeBusBitTime(FAKE_PCLK / CONSOL_BITRATE));
+  if (charToSend != '\r')
+    putchar(charToSend);
+}
+
+void
+consolSendCh(char charToSend)
+{
+  if(charToSend == '\n')
+    consolSendChar('\r');
+
+  consolSendChar(charToSend);
+}
+
+void
+consolSendString(char *pString)
+{
+  while(*pString)
+    consolSendCh(*pString++);
+}
+
+void
+simplePrintf(const char * fmt, ...)
+{
+  char    buf[256];
+  va_list ap;
+
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  consolSendString(buf);
+}
+
+char
+consolGetChar(char *pChar)
+{
+  return 0;
+}
+
+void
+eaInit(void)
+{
+  consolInit();
+}
@@ -0,0 +1,14 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    M6502.h
+ *
+ * Description:
+ *    chess/chess.c and chess/m6502.c include M6502.h, the file is named
+ *    m6502.h. Makes the host build work on a case sensitive file system.
+ *
+ *****************************************************************************/
+#include "../../chess/m6502.h"
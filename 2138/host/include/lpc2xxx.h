@@ -0,0 +1,63 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lpc2xxx.h
+ *
+ * Description:
+ *    Stand-in for startup/lpc2xxx.h in the host build of the firmware.
+ *    Only the registers used by the sources that are compiled unchanged
+ *    (lcdList.c, irq_code/irqLcd.c, chess/chess.c) exist. They are plain variables
+ *    (host/fakeSpi.c), the SPI0 model shifts out what is written to
+ *    SPI_SPDR and calls the LCD bus ISR. The other startup headers
+ *    (printf_P.h, consol.h, ea_init.h) are used as they are.
+ *
+ *****************************************************************************/
+
+#ifndef __lpc2xxx_h
+#define __lpc2xxx_h
+
+typedef struct
+{
+  unsigned long vicIntSelect;
+  unsigned long vicIntEnable;
+  unsigned long vicVectAddr;
+  unsigned long vicVectAddr8;
+  unsigned long vicVectCntl8;
+  unsigned long pinsel0;
+  unsigned long pinsel1;
+  unsigned long spiSpcr;
+  unsigned long spiSpsr;
+  unsigned long spiSpdr;
+  unsigned long spiSpccr;
+  unsigned long spiSpint;
+  unsigned long t0tc;
+} tFakeRegs;
+
+extern volatile tFakeRegs fakeRegs;
+
+/* Vectored Interrupt Controller (VIC) */
+#define VICIntSelect   (fakeRegs.vicIntSelect)
+#define VICIntEnable   (fakeRegs.vicIntEnable)
+#define VICVectAddr    (fakeRegs.vicVectAddr)
+#define VICVectAddr8   (fakeRegs.vicVectAddr8)
+#define VICVectCntl8   (fakeRegs.vicVectCntl8)
+
+/* Pin Connect Block */
+#define PINSEL0        (fakeRegs.pinsel0)
+#define PINSEL1        (fakeRegs.pinsel1)
+
+/* SPI0 (Serial Peripheral Interface 0) */
+#define SPI_SPCR       (fakeRegs.spiSpcr)
+#define SPI_SPSR       (fakeRegs.spiSpsr)
+#define SPI_SPDR       (fakeRegs.spiSpdr)
+#define SPI_SPCCR      (fakeRegs.spiSpccr)
+#define SPI_SPINT      (fakeRegs.spiSpint)
+
+/* Timer 0, the counter is never incremented: the chess program, which
+   uses it as random value, plays the same moves in every run */
+#define T0TC           (fakeRegs.t0tc)
+
+#endif  // __lpc2xxx_h
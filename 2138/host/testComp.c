@@ -0,0 +1,273 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    testComp.c
+ *
+ * Description:
+ *    Host test of the compositor (make test): comp.c draws on the
+ *    in-memory panel of host/fakePanel.c. After every compPresent() the
+ *    panel must be equal to a reference image drawn pixel by pixel, and
+ *    only the dirty tiles may have been sent. The test is built twice,
+ *    with a strip buffer (LPC2104, host/testComp) and with a full screen
+ *    buffer (LPC2138, host/testCompFull).
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include "../pre_emptive_os/api/general.h"
+#include "../comp.h"
+#include "fakePanel.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define SIZE      130
+#define BKG       0x03
+#define BOX_SIZE  5
+#define BOX_COLOR 0xe0
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+//8x4 icon, compressed with escape value 0xff
+static const tU8 iconRle[] =
+{
+  0xff, 12, 0x1c,  0x10, 0x11, 0x12, 0x13,  0xff, 8, 0x49,  0x20, 0x21,
+  0xff, 6, 0xfc
+};
+
+//7x3 icon, not compressed
+static const tU8 iconRaw[] =
+{
+  0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+  0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+  0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27
+};
+
+static tU8 ref[SIZE][SIZE];
+static tU8 boxX;
+static tU8 boxY;
+static int failures;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Count and report a failed check
+ *
+ ****************************************************************************/
+static void
+check(int cond, const char* pText, int line)
+{
+  if (!cond)
+  {
+    printf("testComp.c:%d: check failed: %s\n", line, pText);
+    failures++;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Reference drawing, pixel by pixel with clipping at the screen edge
+ *
+ ****************************************************************************/
+static void
+refRect(tU32 x, tU32 y, tU32 xLen, tU32 yLen, tU8 color)
+{
+  tU32 i, j;
+
+  for(j=y; (j < y + yLen) && (j < SIZE); j++)
+    for(i=x; (i < x + xLen) && (i < SIZE); i++)
+      ref[j][i] = color;
+}
+
+static void
+refIcon(tU32 x, tU32 y, tU32 xLen, tU32 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData)
+{
+  tU32 i, j;
+  tU8  runLeft = 0;
+  tU8  color   = 0;
+
+  for(j=0; j<yLen; j++)
+    for(i=0; i<xLen; i++)
+    {
+      if (compressionOn == FALSE)
+        color = *pData++;
+      else
+      {
+        if (runLeft == 0)
+        {
+          if (*pData == escapeChar)
+          {
+            runLeft = pData[1];
+            color   = pData[2];
+            pData  += 3;
+          }
+          else
+          {
+            runLeft = 1;
+            color   = *pData++;
+          }
+        }
+        runLeft--;
+      }
+      if ((x + i < SIZE) && (y + j < SIZE))
+        ref[y + j][x + i] = color;
+    }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    The scene, drawn with the compositor and in the reference image
+ *
+ ****************************************************************************/
+static void
+paint(void)
+{
+  compRect(30, 40, 50, 20, 0x1c);
+  compIcon(35, 45, 8, 4, TRUE, 0xff, iconRle);
+  compIcon(125, 128, 7, 3, FALSE, 0, iconRaw);    //clipped at both edges
+  compRect(120, 0, 20, 12, 0x92);
+  compRect(boxX, boxY, BOX_SIZE, BOX_SIZE, BOX_COLOR);
+}
+
+static void
+refScene(void)
+{
+  refRect(0, 0, SIZE, SIZE, BKG);
+  refRect(30, 40, 50, 20, 0x1c);
+  refIcon(35, 45, 8, 4, TRUE, 0xff, iconRle);
+  refIcon(125, 128, 7, 3, FALSE, 0, iconRaw);
+  refRect(120, 0, 20, 12, 0x92);
+  refRect(boxX, boxY, BOX_SIZE, BOX_SIZE, BOX_COLOR);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Compare the panel with the reference image
+ *
+ ****************************************************************************/
+static void
+checkPanel(const char* pStep)
+{
+  const tFakePanel* pPanel = fakePanel();
+  tU32 x, y;
+
+  for(y=0; y<SIZE; y++)
+    for(x=0; x<SIZE; x++)
+      if (pPanel->pixel[y][x] != ref[y][x])
+      {
+        printf("%s: pixel %u,%u is 0x%02x, expected 0x%02x\n", pStep,
+               (unsigned)x, (unsigned)y, pPanel->pixel[y][x], ref[y][x]);
+        failures++;
+        return;
+      }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Move the box. With a full screen buffer the old position is
+ *    cleared in the buffer, with a strip buffer both positions are only
+ *    marked and the paint function draws the scene.
+ *
+ ****************************************************************************/
+static void
+moveBox(tU8 x, tU8 y)
+{
+#ifdef COMP_FULL_BUFFER
+  compRect(boxX, boxY, BOX_SIZE, BOX_SIZE, BKG);
+  boxX = x;
+  boxY = y;
+  compRect(boxX, boxY, BOX_SIZE, BOX_SIZE, BOX_COLOR);
+#else
+  compInvalidate(boxX, boxY, BOX_SIZE, BOX_SIZE);
+  boxX = x;
+  boxY = y;
+  compInvalidate(boxX, boxY, BOX_SIZE, BOX_SIZE);
+#endif
+  refScene();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw the scene, move the box within a tile, to the next tile, across
+ *    a tile corner and to a strip further down
+ *
+ ****************************************************************************/
+int
+main(void)
+{
+  const tFakePanel* pPanel = fakePanel();
+  tU32 windows;
+
+  fakePanelReset(0x00);
+  boxX = 12;
+  boxY = 12;
+
+  //first frame: every tile
+  compInit(BKG);
+  paint();
+  refScene();
+  compPresent(paint);
+  CHECK(pPanel->windows == COMP_TILES * COMP_TILES);
+  CHECK(pPanel->pixels == SIZE * SIZE);
+  checkPanel("first frame");
+
+  //nothing changed, nothing sent
+  windows = pPanel->windows;
+  compPresent(paint);
+  CHECK(pPanel->windows == windows);
+
+  //within tile 1,1
+  windows = pPanel->windows;
+  moveBox(14, 13);
+  compPresent(paint);
+  CHECK(pPanel->windows == windows + 1);
+  checkPanel("move in tile");
+
+  //to tile 2,1
+  windows = pPanel->windows;
+  moveBox(22, 13);
+  compPresent(paint);
+  CHECK(pPanel->windows == windows + 2);
+  checkPanel("move to next tile");
+
+  //across the corner of tiles 2,2 to 3,3
+  windows = pPanel->windows;
+  moveBox(28, 28);
+  compPresent(paint);
+  CHECK(pPanel->windows == windows + 5);
+  checkPanel("move across corner");
+
+  //down to another strip of tiles
+  windows = pPanel->windows;
+  moveBox(100, 95);
+  compPresent(paint);
+  CHECK(pPanel->windows == windows + 4 + 1);
+  checkPanel("move to other strip");
+
+  printf("testComp (%u tile rows in RAM): %u windows, %s\n",
+         (unsigned)COMP_BAND_ROWS, (unsigned)pPanel->windows,
+         failures ? "FAILED" : "ok");
+  return failures ? 1 : 0;
+}
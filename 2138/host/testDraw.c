@@ -0,0 +1,363 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    testDraw.c
+ *
+ * Description:
+ *    Host test of the vector drawing functions (make test): draw.c draws
+ *    random lines, circles and polygons, partly outside the screen, on
+ *    the in-memory panel of host/fakePanel.c. Every shape is compared
+ *    pixel by pixel with a brute-force reference rasterizer that tests
+ *    each pixel of the screen on its own. A few shapes with a known
+ *    number of spans check that spans are merged into few windows.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "../pre_emptive_os/api/general.h"
+#include "../draw.h"
+#include "fakePanel.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define SIZE   130
+#define COLOR  0xe0
+#define ROUNDS 2000
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tU8 ref[SIZE][SIZE];
+static int failures;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Count and report a failed check
+ *
+ ****************************************************************************/
+static void
+check(int cond, const char* pText, int line)
+{
+  if (!cond)
+  {
+    printf("testDraw.c:%d: check failed: %s\n", line, pText);
+    failures++;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Random coordinate, mostly on the screen
+ *
+ ****************************************************************************/
+static tS16
+randCoord(void)
+{
+  return (rand() % (SIZE + 120)) - 60;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Reference line: for the major axis position i, the minor axis has
+ *    moved by the smallest n with d/2 - i * dMinor + n * d >= 0
+ *    (d = length along the major axis)
+ *
+ ****************************************************************************/
+static void
+refLine(tS32 x0, tS32 y0, tS32 x1, tS32 y1)
+{
+  tS32 dx = labs(x1 - x0);
+  tS32 dy = labs(y1 - y0);
+  tBool horizontal = (dx >= dy);
+  tS32 x, y, i, n, d, dMinor, step;
+
+  //start at the left end (mostly horizontal) or the top end
+  if ((horizontal && x0 > x1) || (!horizontal && y0 > y1))
+  {
+    tS32 t;
+    t = x0; x0 = x1; x1 = t;
+    t = y0; y0 = y1; y1 = t;
+  }
+  d      = horizontal ? dx : dy;
+  dMinor = horizontal ? dy : dx;
+  step   = horizontal ? ((y1 > y0) ? 1 : -1) : ((x1 > x0) ? 1 : -1);
+
+  for(i=0; i<=d; i++)
+  {
+    n = 0;
+    while (d / 2 - i * dMinor + n * d < 0)
+      n++;
+
+    x = horizontal ? x0 + i : x0 + step * n;
+    y = horizontal ? y0 + step * n : y0 + i;
+    if (x >= 0 && x < SIZE && y >= 0 && y < SIZE)
+      ref[y][x] = COLOR;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Reference circle: the disc is dx*dx + dy*dy <= r*r + r, the outline
+ *    is the pixels of the disc with a horizontal or vertical neighbour
+ *    outside the disc
+ *
+ ****************************************************************************/
+static tBool
+inDisc(tS32 dx, tS32 dy, tS32 r)
+{
+  return (dx * dx + dy * dy <= r * r + r);
+}
+
+static void
+refCircle(tS32 xc, tS32 yc, tS32 r, tBool fill)
+{
+  tS32 x, y;
+
+  for(y=0; y<SIZE; y++)
+    for(x=0; x<SIZE; x++)
+    {
+      tS32 dx = x - xc;
+      tS32 dy = y - yc;
+
+      if (inDisc(dx, dy, r) &&
+          (fill || !inDisc(dx - 1, dy, r) || !inDisc(dx + 1, dy, r) ||
+                   !inDisc(dx, dy - 1, r) || !inDisc(dx, dy + 1, r)))
+        ref[y][x] = COLOR;
+    }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Reference filled polygon: pixel x,y is inside if an odd number of
+ *    edges (covering the rows ya <= y < yb) cross row y at or left of x
+ *
+ ****************************************************************************/
+static void
+refFillPolygon(const tPoint* pPoints, tU8 count)
+{
+  tS32 x, y;
+  tU8  i;
+
+  for(y=0; y<SIZE; y++)
+    for(x=0; x<SIZE; x++)
+    {
+      tU8 crossings = 0;
+
+      for(i=0; i<count; i++)
+      {
+        const tPoint* pA = &pPoints[i];
+        const tPoint* pB = &pPoints[(i + 1) % count];
+
+        if (pA->y > pB->y)
+        {
+          const tPoint* pT = pA;
+          pA = pB;
+          pB = pT;
+        }
+        if (y >= pA->y && y < pB->y &&
+            (tS32)(y - pA->y) * (pB->x - pA->x) <= (x - pA->x) * (tS32)(pB->y - pA->y))
+          crossings++;
+      }
+      if (crossings & 1)
+        ref[y][x] = COLOR;
+    }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Clear panel and reference image before a shape
+ *
+ ****************************************************************************/
+static void
+clear(void)
+{
+  tU32 x, y;
+
+  fakePanelReset(0x00);
+  for(y=0; y<SIZE; y++)
+    for(x=0; x<SIZE; x++)
+      ref[y][x] = 0x00;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Compare the panel with the reference image
+ *
+ * Returns:
+ *    TRUE if equal
+ *
+ ****************************************************************************/
+static tBool
+same(const char* pShape)
+{
+  const tFakePanel* pPanel = fakePanel();
+  tU32 x, y;
+
+  for(y=0; y<SIZE; y++)
+    for(x=0; x<SIZE; x++)
+      if (pPanel->pixel[y][x] != ref[y][x])
+      {
+        printf("%s: pixel %u,%u is 0x%02x, expected 0x%02x\n", pShape,
+               (unsigned)x, (unsigned)y, pPanel->pixel[y][x], ref[y][x]);
+        failures++;
+        return FALSE;
+      }
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Random shapes against the reference rasterizers, then the number of
+ *    windows of a few simple shapes
+ *
+ ****************************************************************************/
+int
+main(void)
+{
+  const tFakePanel* pPanel = fakePanel();
+  tPoint points[DRAW_MAX_VERTICES];
+  tU32 round;
+  tU8  i;
+
+  srand(2138);
+
+  for(round=0; round<ROUNDS; round++)
+  {
+    tS16 x0 = randCoord();
+    tS16 y0 = randCoord();
+    tS16 x1 = randCoord();
+    tS16 y1 = randCoord();
+    tU8  r  = rand() % 80;
+    tU8  count = 3 + rand() % (DRAW_MAX_VERTICES - 2);
+
+    clear();
+    drawLine(x0, y0, x1, y1, COLOR);
+    refLine(x0, y0, x1, y1);
+    if (!same("line"))
+    {
+      printf("  drawLine(%d, %d, %d, %d)\n", x0, y0, x1, y1);
+      break;
+    }
+
+    //the pixels do not depend on the direction
+    clear();
+    drawLine(x1, y1, x0, y0, COLOR);
+    refLine(x0, y0, x1, y1);
+    if (!same("reversed line"))
+      break;
+
+    clear();
+    drawCircle(x0, y0, r, COLOR);
+    refCircle(x0, y0, r, FALSE);
+    if (!same("circle"))
+    {
+      printf("  drawCircle(%d, %d, %u)\n", x0, y0, r);
+      break;
+    }
+
+    clear();
+    drawFillCircle(x0, y0, r, COLOR);
+    refCircle(x0, y0, r, TRUE);
+    if (!same("filled circle"))
+    {
+      printf("  drawFillCircle(%d, %d, %u)\n", x0, y0, r);
+      break;
+    }
+
+    for(i=0; i<count; i++)
+    {
+      points[i].x = randCoord();
+      points[i].y = randCoord();
+    }
+
+    clear();
+    drawPolygon(points, count, COLOR);
+    for(i=0; i<count; i++)
+      refLine(points[i].x, points[i].y, points[(i + 1) % count].x, points[(i + 1) % count].y);
+    if (!same("polygon"))
+      break;
+
+    clear();
+    drawFillPolygon(points, count, COLOR);
+    refFillPolygon(points, count);
+    if (!same("filled polygon"))
+    {
+      for(i=0; i<count; i++)
+        printf("  %d,%d\n", points[i].x, points[i].y);
+      break;
+    }
+  }
+
+  //a rectangle is one window
+  points[0].x = 10; points[0].y = 10;
+  points[1].x = 60; points[1].y = 10;
+  points[2].x = 60; points[2].y = 40;
+  points[3].x = 10; points[3].y = 40;
+  clear();
+  drawFillPolygon(points, 4, COLOR);
+  CHECK(pPanel->windows == 1);
+  CHECK(pPanel->pixels == 50 * 30);
+
+  //horizontal, vertical and 45 degree lines: one window, one per pixel
+  clear();
+  drawLine(5, 7, 120, 7, COLOR);
+  CHECK(pPanel->windows == 1);
+  clear();
+  drawLine(7, 5, 7, 120, COLOR);
+  CHECK(pPanel->windows == 1);
+  clear();
+  drawLine(0, 0, 99, 99, COLOR);
+  CHECK(pPanel->windows == 100);
+
+  //a shallow line: one window per row
+  clear();
+  drawLine(0, 0, 120, 3, COLOR);
+  CHECK(pPanel->windows == 4);
+
+  //every pixel is sent once
+  clear();
+  drawFillCircle(65, 65, 40, COLOR);
+  refCircle(65, 65, 40, TRUE);
+  same("filled circle r=40");
+  CHECK(pPanel->windows < 2 * 40 + 1);
+  {
+    tU32 x, y, n = 0;
+
+    for(y=0; y<SIZE; y++)
+      for(x=0; x<SIZE; x++)
+        n += (ref[y][x] == COLOR);
+    CHECK(pPanel->pixels == n);
+  }
+
+  printf("testDraw: %u rounds of lines, circles and polygons, %s\n",
+         (unsigned)round, failures ? "FAILED" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,322 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    testSprite.c
+ *
+ * Description:
+ *    Host test of the sprite layer (make test): sprite.c draws on the
+ *    in-memory panel of host/fakePanel.c over a compressed background
+ *    image. After every sprUpdate() the panel must be equal to a
+ *    reference image (background, then the visible sprites in z-order
+ *    without the colour key), and the number of windows must show that
+ *    overlapping old and new rectangles are sent as one window.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include "../pre_emptive_os/api/general.h"
+#include "../sprite.h"
+#include "../lcd.h"
+#include "fakePanel.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define SIZE    130
+#define BKG     0x03
+#define KEY     0x00
+#define ESCAPE  0xfe
+#define IMG_W   40
+#define IMG_H   30
+#define NUM_SPR 2
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+typedef struct
+{
+  const tU8* pImage;
+  tU8   x;
+  tU8   y;
+  tU8   z;
+  tBool visible;
+  tBool used;
+} tRefSprite;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tU8 bkgImage[4 + IMG_W * IMG_H * 3];
+
+//8x8, not compressed, transparent corners
+static tU8 imageA[4 + 64] = { 8, 8, FALSE, 0 };
+static tU8 imageA2[4 + 64] = { 8, 8, FALSE, 0 };
+
+//6x6, compressed: a frame of 0xe0 around a transparent centre
+static const tU8 imageB[] =
+{
+  6, 6, TRUE, ESCAPE,
+  ESCAPE, 7, 0xe0,  KEY, KEY, KEY, KEY,  0xe0, 0xe0,  KEY, KEY, KEY, KEY,
+  0xe0, 0xe0,  KEY, KEY, KEY, KEY,  0xe0, 0xe0,  KEY, KEY, KEY, KEY,
+  ESCAPE, 7, 0xe0
+};
+
+static tU8 saveA[64];
+static tU8 saveB[36];
+
+static tRefSprite refSpr[NUM_SPR];
+static tU8 ids[NUM_SPR];
+static tU8 ref[SIZE][SIZE];
+static int failures;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Count and report a failed check
+ *
+ ****************************************************************************/
+static void
+check(int cond, const char* pText, int line)
+{
+  if (!cond)
+  {
+    printf("testSprite.c:%d: check failed: %s\n", line, pText);
+    failures++;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Build the background image (runs of three or more pixels are
+ *    compressed) and the sprite images
+ *
+ ****************************************************************************/
+static void
+makeImages(void)
+{
+  tU32 i, x, y;
+  tU32 run;
+  tU8* pData = &bkgImage[4];
+  tU8  pixels[IMG_W * IMG_H];
+
+  for(y=0; y<IMG_H; y++)
+    for(x=0; x<IMG_W; x++)
+      pixels[y * IMG_W + x] = 0x20 + ((x / 6 + y / 4) & 0x07) * 0x11;
+
+  bkgImage[0] = IMG_W;
+  bkgImage[1] = IMG_H;
+  bkgImage[2] = TRUE;
+  bkgImage[3] = ESCAPE;
+  for(i=0; i<IMG_W * IMG_H; i+=run)
+  {
+    for(run=1; (i + run < IMG_W * IMG_H) && (run < 255) &&
+               (pixels[i + run] == pixels[i]); run++)
+      ;
+    if (run >= 3)
+    {
+      *pData++ = ESCAPE;
+      *pData++ = run;
+      *pData++ = pixels[i];
+    }
+    else
+    {
+      run = 1;
+      *pData++ = pixels[i];
+    }
+  }
+
+  for(i=0; i<64; i++)
+  {
+    x = i % 8;
+    y = i / 8;
+    imageA[4 + i]  = (((x == 0) || (x == 7)) && ((y == 0) || (y == 7))) ? KEY : 0x40 + i;
+    imageA2[4 + i] = (x == y) ? KEY : 0x80 + i;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get pixel x,y of an image in the normal image format
+ *
+ ****************************************************************************/
+static tU8
+imagePixel(const tU8* pImage, tU32 x, tU32 y)
+{
+  const tU8* pData = &pImage[4];
+  tU32 n = y * pImage[0] + x;
+
+  if (pImage[2] == FALSE)
+    return pData[n];
+
+  for(;;)
+  {
+    tU32 run   = (*pData == pImage[3]) ? pData[1] : 1;
+    tU8  color = (*pData == pImage[3]) ? pData[2] : *pData;
+
+    if (n < run)
+      return color;
+    n    -= run;
+    pData += (*pData == pImage[3]) ? 3 : 1;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw the reference image: background, then the sprites in z-order
+ *
+ ****************************************************************************/
+static void
+refScene(void)
+{
+  tU32 x, y;
+  tU8  z, i;
+
+  for(y=0; y<SIZE; y++)
+    for(x=0; x<SIZE; x++)
+      ref[y][x] = ((x < IMG_W) && (y < IMG_H)) ? imagePixel(bkgImage, x, y) : BKG;
+
+  for(z=0; z<=NUM_SPR; z++)
+    for(i=0; i<NUM_SPR; i++)
+    {
+      tRefSprite* pSpr = &refSpr[i];
+
+      if ((pSpr->used == FALSE) || (pSpr->visible == FALSE) || (pSpr->z != z))
+        continue;
+
+      for(y=0; y<pSpr->pImage[1]; y++)
+        for(x=0; x<pSpr->pImage[0]; x++)
+        {
+          tU8 color = imagePixel(pSpr->pImage, x, y);
+
+          if ((color != KEY) && (pSpr->x + x < SIZE) && (pSpr->y + y < SIZE))
+            ref[pSpr->y + y][pSpr->x + x] = color;
+        }
+    }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw all changes and compare the panel with the reference image
+ *
+ ****************************************************************************/
+static void
+update(const char* pStep, tU32 expectedWindows)
+{
+  const tFakePanel* pPanel = fakePanel();
+  tU32 windows = pPanel->windows;
+  tU32 x, y;
+
+  sprUpdate();
+  refScene();
+
+  if (pPanel->windows - windows != expectedWindows)
+  {
+    printf("%s: %u windows, expected %u\n", pStep,
+           (unsigned)(pPanel->windows - windows), (unsigned)expectedWindows);
+    failures++;
+  }
+
+  for(y=0; y<SIZE; y++)
+    for(x=0; x<SIZE; x++)
+      if (pPanel->pixel[y][x] != ref[y][x])
+      {
+        printf("%s: pixel %u,%u is 0x%02x, expected 0x%02x\n", pStep,
+               (unsigned)x, (unsigned)y, pPanel->pixel[y][x], ref[y][x]);
+        failures++;
+        return;
+      }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Move, overlap, clip, change and hide two sprites
+ *
+ ****************************************************************************/
+static void
+move(tU8 i, tU8 x, tU8 y)
+{
+  refSpr[i].x = x;
+  refSpr[i].y = y;
+  sprMove(ids[i], x, y);
+}
+
+int
+main(void)
+{
+  makeImages();
+
+  //the caller draws the background
+  fakePanelReset(BKG);
+  lcdIcon(0, 0, IMG_W, IMG_H, TRUE, ESCAPE, &bkgImage[4]);
+  sprInit();
+  sprBackground(BKG, bkgImage);
+
+  refSpr[0].pImage = imageA;
+  refSpr[0].z      = 1;
+  refSpr[0].used   = TRUE;
+  refSpr[1].pImage = imageB;
+  refSpr[1].z      = 2;
+  refSpr[1].used   = TRUE;
+  ids[0] = sprCreate(imageA, KEY, 1, saveA);
+  ids[1] = sprCreate(imageB, KEY, 2, saveB);
+  CHECK(ids[0] != SPRITE_NONE);
+  CHECK(ids[1] != SPRITE_NONE);
+
+  update("hidden", 0);
+
+  move(0, 10, 10);
+  move(1, 60, 60);
+  refSpr[0].visible = refSpr[1].visible = TRUE;
+  sprShow(ids[0], TRUE);
+  sprShow(ids[1], TRUE);
+  update("show", 2);
+
+  move(0, 12, 11);
+  update("small move on background image", 1);
+
+  move(0, 80, 20);
+  update("jump", 2);
+
+  move(1, 78, 18);
+  update("on top of other sprite", 2);
+
+  move(0, 82, 22);
+  update("under other sprite", 1);
+
+  move(0, 126, 125);
+  update("clipped at screen edge", 2);
+
+  refSpr[0].pImage = imageA2;
+  sprImage(ids[0], imageA2);
+  update("new image", 1);
+
+  refSpr[1].visible = FALSE;
+  sprShow(ids[1], FALSE);
+  update("hide", 1);
+
+  refSpr[0].used = FALSE;
+  sprDelete(ids[0]);
+  update("delete", 0);
+
+  printf("testSprite: %u windows, %s\n", (unsigned)fakePanel()->windows,
+         failures ? "FAILED" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    testSsp.c
+ *
+ * Description:
+ *    Host test of the SSP LCD bus (make test): ssp.c runs on the register
+ *    model of host/fakeSsp.c. The frames shifted out must match the words
+ *    queued, no frame may be lost, the transmit FIFO must be kept filled
+ *    while a block is sent and the receive FIFO must be empty when the bus
+ *    is idle.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include "../pre_emptive_os/api/general.h"
+#include "../ssp.h"
+#include "fakeSsp.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define BLOCK_LEN   1000
+#define REPEAT_CNT  300
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tU8  block[BLOCK_LEN];
+static tU16 expected[1 + BLOCK_LEN + REPEAT_CNT + 1];
+static int  failures;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Count and report a failed check
+ *
+ ****************************************************************************/
+static void
+check(int cond, const char* pText, int line)
+{
+  if (!cond)
+  {
+    printf("testSsp.c:%d: check failed: %s\n", line, pText);
+    failures++;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a command, a data block, a repeated data byte and a command,
+ *    then compare the frame log and the FIFO statistics
+ *
+ ****************************************************************************/
+int
+main(void)
+{
+  const tFakeSspStat* pStat = fakeSspStat();
+  tU32 n = 0;
+  tU32 i;
+
+  fakeSspReset();
+  sspInit();
+  CHECK((fakeSspRead(SSPCR0) & 0x0f) == 8);       //9-bit frames
+  CHECK((fakeSspRead(SSPCR1) & 0x02) != 0);       //enabled
+
+  for(i=0; i<BLOCK_LEN; i++)
+    block[i] = (tU8)(i * 7 + 3);
+
+  sspSendWord(0x02c);                             //command RAMWR
+  expected[n++] = 0x02c;
+
+  sspSendBlock(1, block, BLOCK_LEN);
+  for(i=0; i<BLOCK_LEN; i++)
+    expected[n++] = 0x100 | block[i];
+
+  //the block is queued, not waited for: the FIFO still holds frames
+  CHECK(pStat->frames < n);
+  CHECK(pStat->frames + SSP_FIFO_DEPTH >= n);
+
+  sspSendRepeat(1, 0xe0, REPEAT_CNT);
+  for(i=0; i<REPEAT_CNT; i++)
+    expected[n++] = 0x1e0;
+
+  sspSendWord(0x1ff | 0x200);                     //bits above 8 are dropped
+  expected[n++] = 0x1ff;
+
+  //the transmitter never ran dry while words were queued
+  CHECK(pStat->idleCycles == 0);
+  CHECK(pStat->maxTxLevel == SSP_FIFO_DEPTH);
+
+  sspWaitIdle();
+
+  CHECK(pStat->frames == n);
+  CHECK(pStat->lostFrames == 0);
+  CHECK(pStat->rxOverruns == 0);
+  CHECK((fakeSspRead(SSPSR) & (SSPSR_BSY | SSPSR_RNE)) == 0);
+  CHECK((fakeSspRead(SSPSR) & SSPSR_TFE) != 0);
+
+  for(i=0; i<n && i<pStat->frames; i++)
+  {
+    if (pStat->log[i] != expected[i])
+    {
+      printf("frame %u: 0x%03x, expected 0x%03x\n",
+             (unsigned)i, pStat->log[i], expected[i]);
+      failures++;
+      break;
+    }
+  }
+
+  printf("testSsp: %u frames, max FIFO level %u, %s\n",
+         (unsigned)pStat->frames, (unsigned)pStat->maxTxLevel,
+         failures ? "FAILED" : "ok");
+  return failures ? 1 : 0;
+}
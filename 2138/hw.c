@@ -22,10 +22,26 @@
 #include "key.h"
 #include "pins.h"
 #include "eeprom.h"
+#include "lcdCapture.h"
+#include "perf.h"
+#include "irq_code/irqTimer.h"
+#include "config.h"
+#ifdef LCD_SSP
+#include "ssp.h"
+#endif
 
 /******************************************************************************
  * Typedefs and defines
  *****************************************************************************/
+#define LCD_BURST_WORDS  8    //number of 9-bit words in one packed group
+#define LCD_BURST_FRAMES 9    //number of 8-bit SPI frames in one packed group
+
+//TIMER1 counts PCLK / 9 = 1.6384 MHz (at 14.7456 MHz), one count is
+//625/1024 us, and is reset once per second
+#define TIMEBASE_PRESCALE    9
+#define TIMEBASE_HZ          ((CORE_FREQ / PBSD) / TIMEBASE_PRESCALE)
+#define TIMEBASE_US_MUL      ((1000000 << 10) / TIMEBASE_HZ)
+#define TIMEBASE_VIC_CHANNEL 5    //TIMER1
 
 
 /*****************************************************************************
@@ -40,9 +56,21 @@ tBool ver1_1;
 static tU8 greenLedShadow;
 static tU8 btResetShadow;
 
+static volatile tU32 timebaseSeconds;
+
+#ifndef LCD_SSP
+static tU8 lcdBurstBuf[LCD_BURST_WORDS];
+static tU8 lcdBurstCnt;
+#endif
+
 /*****************************************************************************
  * Local prototypes
  ****************************************************************************/
+#ifndef LCD_SSP
+static void sendNineBits(tU8 firstBit, tU8 data);
+static void packBurst(const tU8* pData, tU8* pFrame);
+static void sendBurstFrames(const tU8* pFrame);
+#endif
 
 
 /*****************************************************************************
@@ -266,6 +294,7 @@ getKeys(void)
   //HW is ver 1.1
   else
   {
+    //blocks on the I2C lock while an EEPROM transfer is running
     pca9532(commandReadKeys, sizeof(commandReadKeys), &keySample, 1);
     if ((keySample & 0x01) == 0) readKeys |= KEY_CENTER;
     if ((keySample & 0x04) == 0) readKeys |= KEY_UP;
@@ -287,6 +316,10 @@ getKeys(void)
 void
 selectLCD(tBool select)
 {
+  //queued data words must go out before deselect
+  if (FALSE == select)
+    flushBurstToLCD();
+
   //check if ver 1.0 of HW
   if (TRUE == ver1_0)
   {
@@ -315,6 +348,34 @@ selectLCD(tBool select)
  ****************************************************************************/
 void
 sendToLCD(tU8 firstBit, tU8 data)
+{
+  LCD_CAPTURE_WORD(((tU16)firstBit << 8) | data);
+  PERF_LCD_WORDS(1);
+
+#ifdef LCD_SSP
+  sspSendWord(((tU16)firstBit << 8) | data);
+#else
+  //keep word order if a burst is pending
+  if (lcdBurstCnt > 0)
+    flushBurstToLCD();
+
+  sendNineBits(firstBit, data);
+#endif
+}
+
+#ifndef LCD_SSP
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send one 9-bit word to the LCD controller. The first bit is clocked
+ *    out with the SPI block disconnected from the pins and the remaining
+ *    8 bits are sent with the SPI block.
+ *
+ ****************************************************************************/
+static void
+sendNineBits(tU8 firstBit, tU8 data)
 {
   //disable SPI
   IOCLR = LCD_CLK;
@@ -348,6 +409,196 @@ sendToLCD(tU8 firstBit, tU8 data)
 }
 
 
+/*****************************************************************************
+ *
+ * Description:
+ *    Pack eight 9-bit data words (first bit = 1) into nine 8-bit SPI frames.
+ *    The controller only counts clocks while selected, so the words can
+ *    be sent back-to-back without touching the pins in between.
+ *
+ * Params:
+ *    [in]  pData  - 8 data bytes
+ *    [out] pFrame - 9 SPI frames
+ *
+ ****************************************************************************/
+static void
+packBurst(const tU8* pData, tU8* pFrame)
+{
+  tU32 acc  = 0;
+  tU8  bits = 0;
+  tU8  i;
+
+  for(i=0; i<LCD_BURST_WORDS; i++)
+  {
+    acc   = (acc << 9) | 0x100 | pData[i];
+    bits += 9;
+    while(bits >= 8)
+    {
+      bits -= 8;
+      *pFrame++ = (tU8)(acc >> bits);
+    }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send one packed group (nine frames) over the SPI block, which must
+ *    already be connected to the pins.
+ *
+ ****************************************************************************/
+static void
+sendBurstFrames(const tU8* pFrame)
+{
+  tU8 i;
+
+  for(i=0; i<LCD_BURST_FRAMES; i++)
+  {
+    SPI_SPDR = pFrame[i];
+    while((SPI_SPSR & 0x80) == 0)
+      ;
+  }
+}
+#endif
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send a block of data bytes to the LCD controller. Complete groups of
+ *    eight words are packed and sent without reconnecting the SPI block,
+ *    a remaining partial group is kept until more data arrives or until
+ *    the burst is flushed (by flushBurstToLCD(), sendToLCD() or when the
+ *    controller is deselected).
+ *
+ * Params:
+ *    [in] pData - data bytes
+ *    [in] len   - number of data bytes
+ *
+ ****************************************************************************/
+void
+sendBurstToLCD(const tU8* pData, tU32 len)
+{
+#ifndef LCD_SSP
+  tU8 frame[LCD_BURST_FRAMES];
+#endif
+
+  LCD_CAPTURE_DATA(pData, len);
+  PERF_LCD_WORDS(len);
+
+#ifdef LCD_SSP
+  sspSendBlock(1, pData, len);
+#else
+  //complete a pending group first
+  while((lcdBurstCnt > 0) && (len > 0))
+  {
+    lcdBurstBuf[lcdBurstCnt++] = *pData++;
+    len--;
+    if (lcdBurstCnt == LCD_BURST_WORDS)
+    {
+      packBurst(lcdBurstBuf, frame);
+      sendBurstFrames(frame);
+      lcdBurstCnt = 0;
+    }
+  }
+
+  while(len >= LCD_BURST_WORDS)
+  {
+    packBurst(pData, frame);
+    sendBurstFrames(frame);
+    pData += LCD_BURST_WORDS;
+    len   -= LCD_BURST_WORDS;
+  }
+
+  while(len > 0)
+  {
+    lcdBurstBuf[lcdBurstCnt++] = *pData++;
+    len--;
+  }
+#endif
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send the same data byte a number of times to the LCD controller.
+ *    The packed group is only calculated once.
+ *
+ * Params:
+ *    [in] data  - data byte
+ *    [in] count - number of times to send it
+ *
+ ****************************************************************************/
+void
+sendFillToLCD(tU8 data, tU32 count)
+{
+#ifndef LCD_SSP
+  tU8 frame[LCD_BURST_FRAMES];
+  tU8 i;
+#endif
+
+#ifdef LCD_SSP
+  LCD_CAPTURE_FILL(0x100 | data, count);
+  PERF_LCD_WORDS(count);
+  sspSendRepeat(1, data, count);
+#else
+  //complete a pending group first
+  while((lcdBurstCnt > 0) && (count > 0))
+  {
+    sendBurstToLCD(&data, 1);
+    count--;
+  }
+  LCD_CAPTURE_FILL(0x100 | data, count);
+  PERF_LCD_WORDS(count);
+
+  if (count >= LCD_BURST_WORDS)
+  {
+    for(i=0; i<LCD_BURST_WORDS; i++)
+      lcdBurstBuf[i] = data;
+    packBurst(lcdBurstBuf, frame);
+
+    while(count >= LCD_BURST_WORDS)
+    {
+      sendBurstFrames(frame);
+      count -= LCD_BURST_WORDS;
+    }
+  }
+
+  while(count > 0)
+  {
+    lcdBurstBuf[lcdBurstCnt++] = data;
+    count--;
+  }
+#endif
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send data words that are waiting for a complete packed group
+ *    (one 9-bit word at a time). With the SSP bus, wait until the
+ *    transmit FIFO has been emptied.
+ *
+ ****************************************************************************/
+void
+flushBurstToLCD(void)
+{
+#ifdef LCD_SSP
+  sspWaitIdle();
+#else
+  tU8 i;
+  tU8 cnt = lcdBurstCnt;
+
+  lcdBurstCnt = 0;
+  for(i=0; i<cnt; i++)
+    sendNineBits(1, lcdBurstBuf[i]);
+#endif
+}
+
+
 /*****************************************************************************
  *
  * Description:
@@ -359,6 +610,25 @@ initSpiForLcd(void)
 {
   //make SPI slave chip select an output and set signal high
   //check if ver 1.0 of HW
+#ifdef LCD_SSP
+  if (TRUE == ver1_0)
+    IODIR |= LCD_CS_V1_0;
+
+  //HW is ver 1.1
+  else
+    IODIR |= LCD_CS_V1_1;
+
+  //connect SSP bus to IO-pins (P0.17 = SCK1, P0.18 = MISO1, P0.19 = MOSI1)
+  //the stock board has the LCD on P0.4/P0.6 (SPI0), LCD_SSP needs the
+  //LCD clock and data lines rewired to P0.17 and P0.19
+  PINSEL1 = (PINSEL1 & ~0x000000fc) | 0x000000a8;
+
+  //initialize SSP interface (9-bit frames)
+  sspInit();
+
+  //deselect controller
+  selectLCD(FALSE);
+#else
   if (TRUE == ver1_0)
   {
     IODIR |= (LCD_CS_V1_0 | LCD_CLK | LCD_MOSI);
@@ -379,5 +649,76 @@ initSpiForLcd(void)
   //initialize SPI interface
   SPI_SPCCR = 0x08;    
   SPI_SPCR  = 0x20;
+#endif
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start the microsecond timebase on TIMER1. The counter is reset by
+ *    match register 0 once per second, and the interrupt counts seconds.
+ *
+ ****************************************************************************/
+void
+initTimebase(void)
+{
+  timebaseSeconds = 0;
+
+  TIMER1_TCR = 0x02;                        //stop and reset timer
+  TIMER1_PR  = TIMEBASE_PRESCALE - 1;
+  TIMER1_MR0 = TIMEBASE_HZ - 1;
+  TIMER1_IR  = 0xff;                        //reset all interrupt flags
+  TIMER1_MCR = 0x03;                        //interrupt and reset on match 0
+
+  //initialize the interrupt vector
+  VICIntSelect &= ~(1 << TIMEBASE_VIC_CHANNEL);         // selected as IRQ
+  VICVectCntl9  =  0x00000020 | TIMEBASE_VIC_CHANNEL;
+  VICVectAddr9  =  (tU32)timer1ISR;                    // address of the ISR
+  VICIntEnable |=  (1 << TIMEBASE_VIC_CHANNEL);         // interrupt enabled
+
+  TIMER1_TCR = 0x01;                        //start timer
 }
 
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Count a second (called by the TIMER1 ISR)
+ *
+ ****************************************************************************/
+void
+timebaseIsr(void)
+{
+  TIMER1_IR = 0x01;
+  timebaseSeconds++;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Microseconds since initTimebase(). The value wraps after about 71
+ *    minutes, so intervals are computed as differences.
+ *
+ ****************************************************************************/
+tU32
+nowUs(void)
+{
+  tU32 seconds;
+  tU32 count;
+  tU32 pending;
+
+  do
+  {
+    seconds = timebaseSeconds;
+    count   = TIMER1_TC;
+    pending = TIMER1_IR & 0x01;
+  } while(seconds != timebaseSeconds);
+
+  //the counter was reset, but the interrupt is not served yet (disabled)
+  if (pending != 0 && count < TIMEBASE_HZ / 2)
+    seconds++;
+
+  return seconds * 1000000 + ((count * TIMEBASE_US_MUL) >> 10);
+}
@@ -41,6 +41,13 @@ void resetBT(tBool resetFlag);
 tU8  getKeys(void);
 void selectLCD(tBool select);
 void sendToLCD(tU8 firstBit, tU8 data);
+void sendBurstToLCD(const tU8* pData, tU32 len);
+void sendFillToLCD(tU8 data, tU32 count);
+void flushBurstToLCD(void);
 void initSpiForLcd(void);
 
+void initTimebase(void);
+tU32 nowUs(void);
+void timebaseIsr(void);
+
 #endif
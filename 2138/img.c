@@ -0,0 +1,211 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    img.c
+ *
+ * Description:
+ *    Streaming decoder for the image container described in img.h.
+ *    Pixels are decoded one by one directly from flash; only the copy
+ *    history (IMG_WINDOW palette indexes) is kept in RAM, never a frame.
+ *
+ *    The decoder is also linked into the host tool, which checks every
+ *    container it writes by decoding it again.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "img.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define IMG_TOKEN_RUN    0x80
+#define IMG_TOKEN_COPY   0xc0
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Image size and number of frames.
+ *
+ ****************************************************************************/
+tU16
+imgWidth(const tU8* pImg)
+{
+  return pImg[2] | (pImg[3] << 8);
+}
+
+tU16
+imgHeight(const tU8* pImg)
+{
+  return pImg[4] | (pImg[5] << 8);
+}
+
+tU8
+imgFrames(const tU8* pImg)
+{
+  return pImg[6];
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check if the container is an animation, i.e., has delta frames.
+ *
+ ****************************************************************************/
+tBool
+imgIsDelta(const tU8* pImg)
+{
+  return (pImg[1] & IMG_FLAG_DELTA) ? TRUE : FALSE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the data of a frame.
+ *
+ ****************************************************************************/
+const tU8*
+imgFrameData(const tU8* pImg, tU8 frame)
+{
+  const tU8* pOffset = pImg + IMG_HEADER_SIZE + pImg[7] + 1 + 4*frame;
+
+  return pImg + (pOffset[0] | (pOffset[1] << 8) |
+                (pOffset[2] << 16) | ((tU32)pOffset[3] << 24));
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Quick check of the header (magic and bits per pixel).
+ *
+ ****************************************************************************/
+tBool
+imgValid(const tU8* pImg)
+{
+  tU8 bpp;
+
+  if (pImg == NULL || pImg[0] != IMG_MAGIC)
+    return FALSE;
+
+  bpp = pImg[1] & IMG_BPP_MASK;
+  return (bpp >= 1 && bpp <= 8);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Full check of a container, including the checksum. Reads all data
+ *    of the container, so it is meant for load/debug time, not per blit.
+ *
+ ****************************************************************************/
+tBool
+imgCheck(const tU8* pImg)
+{
+  const tU8* pData;
+  const tU8* pEnd;
+  tU16 sum1 = 0;
+  tU16 sum2 = 0;
+
+  if (imgValid(pImg) == FALSE || imgFrames(pImg) == 0)
+    return FALSE;
+
+  pEnd = pImg + (pImg[10] | (pImg[11] << 8) | (pImg[12] << 16) | ((tU32)pImg[13] << 24));
+  for(pData = pImg + IMG_HEADER_SIZE; pData < pEnd; pData++)
+  {
+    sum1 = (sum1 + *pData) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+
+  return ((sum1 | (sum2 << 8)) == (pImg[8] | (pImg[9] << 8)));
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Prepare decoding of coded pixels (a full frame from imgFrameData()
+ *    or a rectangle of a delta frame) with the palette of the container.
+ *
+ ****************************************************************************/
+void
+imgDecodeStart(tImgDecoder* pDec, const tU8* pImg, const tU8* pData)
+{
+  pDec->pPalette = pImg + IMG_HEADER_SIZE;
+  pDec->pData    = pData;
+  pDec->bpp      = pImg[1] & IMG_BPP_MASK;
+  pDec->left     = 0;
+  pDec->bitsLeft = 0;
+  pDec->histPos  = 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Decode next pixel of the frame.
+ *
+ * Returns:
+ *    The pixel color (RRRGGGBB).
+ *
+ ****************************************************************************/
+tU8
+imgDecodePixel(tImgDecoder* pDec)
+{
+  tU8 index;
+
+  if (pDec->left == 0)
+  {
+    pDec->token = *pDec->pData++;
+
+    if (pDec->token < IMG_TOKEN_RUN)
+    {
+      pDec->left     = pDec->token + 1;
+      pDec->bits     = 0;
+      pDec->bitsLeft = 0;
+    }
+    else if (pDec->token < IMG_TOKEN_COPY)
+    {
+      pDec->left     = pDec->token - IMG_TOKEN_RUN + IMG_RUN_MIN;
+      pDec->runIndex = *pDec->pData++;
+    }
+    else
+    {
+      pDec->left    = pDec->token - IMG_TOKEN_COPY + IMG_COPY_MIN;
+      pDec->copyPos = pDec->histPos - 1 - (pDec->pData[0] | (pDec->pData[1] << 8));
+      pDec->pData  += 2;
+    }
+  }
+
+  if (pDec->token < IMG_TOKEN_RUN)
+  {
+    //an index may continue in the next byte
+    if (pDec->bitsLeft < pDec->bpp)
+    {
+      pDec->bits     |= *pDec->pData++ << (8 - pDec->bitsLeft);
+      pDec->bitsLeft += 8;
+    }
+    index = pDec->bits >> (16 - pDec->bpp);
+    pDec->bits    <<= pDec->bpp;
+    pDec->bitsLeft -= pDec->bpp;
+  }
+  else if (pDec->token < IMG_TOKEN_COPY)
+    index = pDec->runIndex;
+  else
+    index = pDec->hist[pDec->copyPos++ & (IMG_WINDOW - 1)];
+
+  pDec->left--;
+  pDec->hist[pDec->histPos++ & (IMG_WINDOW - 1)] = index;
+  return pDec->pPalette[index];
+}
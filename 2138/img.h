@@ -0,0 +1,106 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    img.h
+ *
+ * Description:
+ *    Expose the palettized, compressed image container and its streaming
+ *    decoder. Containers are generated by the host tool tools/imgc.
+ *
+ *    Container layout (16/32-bit values are little endian):
+ *      0  magic (IMG_MAGIC)
+ *      1  bits per pixel, 1 - 8, or'ed with IMG_FLAG_DELTA for an
+ *         animation
+ *      2  width (16 bits)
+ *      4  height (16 bits)
+ *      6  number of frames
+ *      7  number of palette colors - 1
+ *      8  Fletcher-16 checksum of all bytes after the header
+ *      10 size of container (32 bits)
+ *      14 palette, one RRRGGGBB byte per color
+ *      -  offset of every frame from start of container (32 bits each),
+ *         animations have one more frame, see below
+ *      -  frames, each coded separately with the tokens:
+ *           0x00 - 0x7f  literal, (t + 1) palette indexes follow, packed
+ *                        MSB first with bits per pixel, padded to a byte
+ *           0x80 - 0xbf  run, (t - 0x80 + 2) times the index that follows
+ *           0xc0 - 0xff  copy (t - 0xc0 + 3) pixels from distance d
+ *                        pixels back in the frame, d - 1 follows (16 bits,
+ *                        d <= IMG_WINDOW)
+ *
+ *    In an animation (IMG_FLAG_DELTA) only frame 0 is a full frame. Frame
+ *    n (1 <= n <= number of frames) holds the changes from frame n - 1 to
+ *    frame n, where the last one goes back to frame 0 for looping:
+ *      0  number of rectangles (16 bits)
+ *      2  the rectangles, x, y, width, height (8 bits each, relative to
+ *         the image)
+ *      -  the pixels of all rectangles (row by row, rectangle after
+ *         rectangle), coded with the tokens above as one stream
+ *
+ *    Wire format image (imgc -w), drawn by lcdWireImage():
+ *      0  magic (IMG_WIRE_MAGIC)
+ *      1  x, y, width, height (8 bits each)
+ *      5  number of bytes that follow (32 bits, multiple of 9)
+ *      9  the LCD bus words CASET, PASET, RAMWR with parameters and all
+ *         pixels, padded with NOP to groups of 8 words, packed MSB first
+ *         into 9 bytes per group (the SPI0 frames of the display list)
+ *
+ *****************************************************************************/
+#ifndef _IMG_H_
+#define _IMG_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define IMG_MAGIC        0x49
+#define IMG_HEADER_SIZE  14
+#define IMG_BPP_MASK     0x0f
+#define IMG_FLAG_DELTA   0x80
+#define IMG_RECT_SIZE    4
+#define IMG_WINDOW       512   //copy distance limit, power of 2
+
+#define IMG_WIRE_MAGIC   0x57
+#define IMG_WIRE_HEADER  9
+
+#define IMG_LITERAL_MAX  128
+#define IMG_RUN_MIN      2
+#define IMG_RUN_MAX      (IMG_RUN_MIN + 0x3f)
+#define IMG_COPY_MIN     3
+#define IMG_COPY_MAX     (IMG_COPY_MIN + 0x3f)
+
+typedef struct
+{
+  const tU8* pPalette;
+  const tU8* pData;            //next byte of the frame
+  tU8  bpp;
+  tU8  token;                  //token being decoded
+  tU8  left;                   //pixels left of token
+  tU8  runIndex;
+  tU16 copyPos;                //source of a copy in history
+  tU16 bits;                   //literal bits not yet used, left aligned
+  tU8  bitsLeft;
+  tU16 histPos;
+  tU8  hist[IMG_WINDOW];       //last decoded palette indexes
+} tImgDecoder;
+
+
+tBool imgValid(const tU8* pImg);
+tBool imgCheck(const tU8* pImg);
+tU16  imgWidth(const tU8* pImg);
+tU16  imgHeight(const tU8* pImg);
+tU8   imgFrames(const tU8* pImg);
+tBool imgIsDelta(const tU8* pImg);
+const tU8* imgFrameData(const tU8* pImg, tU8 frame);
+void  imgDecodeStart(tImgDecoder* pDec, const tU8* pImg, const tU8* pData);
+tU8   imgDecodePixel(tImgDecoder* pDec);
+
+#endif
@@ -0,0 +1,38 @@
+/******************************************************************************
+ *
+ * File:
+ *    irqLcd.c
+ *
+ * Description:
+ *    LCD bus irq code (SPI0 or SSP), that must be compiled in ARM code.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include <lpc2xxx.h>
+#include "irqLcd.h"
+#include "../lcdList.h"
+
+
+/*****************************************************************************
+ * Implementation of public functions
+ ****************************************************************************/
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Actual LCD bus ISR that is called whenever the SPI0 block has shifted
+ *    out a frame (or the SSP transmit FIFO is half empty). The display
+ *    list is fed from lcdList.c.
+ *
+ ****************************************************************************/
+void
+lcdISR(void)
+{
+  lcdListIsr();
+
+  VICVectAddr = 0x00000000;    //dummy write to VIC to signal end of interrupt
+}
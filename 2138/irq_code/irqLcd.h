@@ -0,0 +1,19 @@
+/******************************************************************************
+ *
+ * File:
+ *    irqLcd.h
+ *
+ * Description:
+ *    Contains interface definitions for the LCD bus interrupt routine
+ *
+ *****************************************************************************/
+#ifndef _IRQLCD_H_
+#define _IRQLCD_H_
+
+/*****************************************************************************
+ * Public function prototypes
+ ****************************************************************************/
+void lcdISR(void);
+
+
+#endif
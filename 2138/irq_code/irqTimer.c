@@ -0,0 +1,37 @@
+/******************************************************************************
+ *
+ * File:
+ *    irqTimer.c
+ *
+ * Description:
+ *    Timebase irq code (TIMER1), that must be compiled in ARM code.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include <lpc2xxx.h>
+#include "irqTimer.h"
+#include "../hw.h"
+
+
+/*****************************************************************************
+ * Implementation of public functions
+ ****************************************************************************/
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Actual timebase ISR that is called once per second, when TIMER1 is
+ *    reset by its match register. The seconds are counted in hw.c.
+ *
+ ****************************************************************************/
+void
+timer1ISR(void)
+{
+  timebaseIsr();
+
+  VICVectAddr = 0x00000000;    //dummy write to VIC to signal end of interrupt
+}
@@ -0,0 +1,19 @@
+/******************************************************************************
+ *
+ * File:
+ *    irqTimer.h
+ *
+ * Description:
+ *    Contains interface definitions for the timebase interrupt routine
+ *
+ *****************************************************************************/
+#ifndef _IRQTIMER_H_
+#define _IRQTIMER_H_
+
+/*****************************************************************************
+ * Public function prototypes
+ ****************************************************************************/
+void timer1ISR(void);
+
+
+#endif
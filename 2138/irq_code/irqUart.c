@@ -15,6 +15,7 @@
 #include <lpc2xxx.h>
 #include "irqUart.h"
 #include "../uart.h"
+#include "../perf.h"
 
 extern tCntSem receiveSem;
 
@@ -65,6 +66,7 @@ uart1ISR(void)
         else
         {
           uart1RxBuf[tmpHead] = U1RBR;  //will reset IRQ flag
+          PERF_UART1_BYTE();
 
 uart1RxInBuff++;
 if(uart1RxInBuff > (RX_BUFFER_SIZE - RX_BUFFER_LIMIT))
@@ -99,6 +101,7 @@ osSemGive(&receiveSem, &error);
 
           uart1TxTail = tmpTail;
           U1THR = uart1TxBuf[tmpTail]; 
+          PERF_UART1_BYTE();
         } while((uart1TxHead != uart1TxTail) && --bytesToSend);
       }
 
@@ -129,6 +132,7 @@ osSemGive(&receiveSem, &error);
 
             uart1TxTail = tmpTail;
             U1THR = uart1TxBuf[tmpTail]; 
+            PERF_UART1_BYTE();
             uart1TxRunning = TRUE;
             U1IER = 0x0f;          /* enable TX IRQ, and RX IRQ still enabled (and modem) */
           }
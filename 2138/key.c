@@ -19,45 +19,207 @@
 #include <printf_P.h>
 #include "key.h"
 #include "hw.h"
+#include "perf.h"
+#include "replay.h"
 
 
 /******************************************************************************
  * Typedefs and defines
  *****************************************************************************/
-#define FIRST_REPEAT  4
-#define SECOND_REPEAT 3
+#define KEY_COUNT     5       //KEY_UP (bit 0) to KEY_CENTER (bit 4)
+
+#define FIRST_REPEAT  4       //samples until the first repeat
+#define SECOND_REPEAT 3       //samples between the following repeats
+
+#define KEY_TICK_MS        10 //ms per OS tick (appTick)
+#define KEY_SAMPLE_TICKS   5  //50 ms between samples
+#define PROC_KEY_STACK_SIZE 400
+#define PROC_KEY_PRIO      4  //lowest (NUM_PRIO-1), below the menus and games
+
+
+/*****************************************************************************
+ * External variables
+ ****************************************************************************/
+extern volatile tU32 ms;
 
 
 /*****************************************************************************
  * Local variables
  ****************************************************************************/
-static tU8 centerReleased = TRUE;
-static tU8 keyUpReleased = TRUE;
-static tU8 keyDownReleased = TRUE;
-static tU8 keyLeftReleased = TRUE;
-static tU8 keyRightReleased = TRUE;
-static tU8 centerKeyCnt;
-static tU8 upKeyCnt;
-static tU8 downKeyCnt;
-static tU8 leftKeyCnt;
-static tU8 rightKeyCnt;
-
-static volatile tU8 activeKey = KEY_NOTHING;
-static volatile tU8 activeKey2 = KEY_NOTHING;
+static tU8 lastKeys = KEY_NOTHING;        //keys held at the last sample
+static tU8 repeatCnt[KEY_COUNT];
+
+//event queue, written by the key process (procKey) and read by one
+//other process
+static volatile tKeyEvent keyQueue[KEY_QUEUE_SIZE];
+static volatile tU8 queueHead = 0;        //next entry written
+static volatile tU8 queueTail = 0;        //next entry read
+
+static volatile tU8 activeKey2 = KEY_NOTHING;  //key of the last press or repeat
+
+//given by the key process when a process waits in waitKeyMask()
+static tCntSem keySem;
+static volatile tBool keyWaiting = FALSE;
+
+static tU8 procKeyStack[PROC_KEY_STACK_SIZE];
+static tU8 pidKey;
 
 
 /*****************************************************************************
  *
  * Description:
- *    Function to check if any key press has been detected
+ *    Add an event to the queue. The oldest events are kept if the queue
+ *    is full.
+ *
+ ****************************************************************************/
+static void
+putEvent(tU8 type, tU8 key, tU8 held)
+{
+  tU8 head = queueHead;
+  volatile tKeyEvent* pEvent = &keyQueue[head];
+  tU8 error;
+
+  if (((head + 1) & KEY_QUEUE_MASK) == queueTail)
+    return;
+
+  pEvent->ms   = ms;
+  pEvent->type = type;
+  pEvent->key  = key;
+  pEvent->held = held;
+
+  //the event must be complete before it is visible to the reader
+  queueHead = (head + 1) & KEY_QUEUE_MASK;
+  REPLAY_RECORD(type, key, held);
+
+  if (type != KEY_EVENT_RELEASE && keyWaiting == TRUE)
+  {
+    keyWaiting = FALSE;
+    osSemGive(&keySem, &error);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the next key event from the queue.
+ *
+ * Returns:
+ *    TRUE if an event was returned, FALSE if the queue is empty.
+ *
+ ****************************************************************************/
+tBool
+getKeyEvent(tKeyEvent* pEvent)
+{
+  tU8 tail = queueTail;
+
+  if (tail == queueHead)
+    return FALSE;
+
+  pEvent->ms   = keyQueue[tail].ms;
+  pEvent->type = keyQueue[tail].type;
+  pEvent->key  = keyQueue[tail].key;
+  pEvent->held = keyQueue[tail].held;
+  queueTail = (tail + 1) & KEY_QUEUE_MASK;
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Function to check if any key press has been detected. Returns the
+ *    key of the next press or repeat event, release events are skipped.
  *
  ****************************************************************************/
 tU8
 checkKey(void)
 {
-  tU8 retVal = activeKey;
-  activeKey = KEY_NOTHING;
-  return retVal;
+  tKeyEvent event;
+
+  while(getKeyEvent(&event) == TRUE)
+    if (event.type != KEY_EVENT_RELEASE)
+      return event.key;
+  return KEY_NOTHING;
+}
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Discard all queued key events.
+ *
+ ****************************************************************************/
+void
+keyFlush(void)
+{
+  tKeyEvent event;
+
+  while(getKeyEvent(&event) == TRUE)
+    ;
+}
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait for a press or repeat event of one of the keys in a mask, events
+ *    of other keys are discarded. The calling process sleeps on a
+ *    semaphore that the key process gives when it adds an event.
+ *
+ * Params:
+ *    [in] mask    - The keys to wait for (KEY_ bits).
+ *    [in] timeout - Ticks to wait at most, 0 waits forever.
+ *
+ * Returns:
+ *    The key, or KEY_NOTHING if the timeout elapsed.
+ *
+ ****************************************************************************/
+tU8
+waitKeyMask(tU8 mask, tU32 timeout)
+{
+  tU32 start = ms;
+  tU32 waited = 0;
+  tU8  key;
+  tU8  error;
+
+  for(;;)
+  {
+    //a give after the timeout of the last wait leaves the semaphore
+    //taken once too often, the queue is checked again then
+    keyWaiting = TRUE;
+    key = checkKey();
+    if ((key & mask) != 0)
+      break;
+    if (key != KEY_NOTHING)
+      continue;
+
+    if (timeout != 0)
+    {
+      waited = (ms - start) / KEY_TICK_MS;
+      if (waited >= timeout)
+        break;
+    }
+    osSemTake(&keySem, timeout - waited, &error);
+  }
+  keyWaiting = FALSE;
+  return key;
+}
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait for a press or repeat event of any key.
+ *
+ * Params:
+ *    [in] timeout - Ticks to wait at most, 0 waits forever.
+ *
+ * Returns:
+ *    The key, or KEY_NOTHING if the timeout elapsed.
+ *
+ ****************************************************************************/
+tU8
+waitKey(tU32 timeout)
+{
+  return waitKeyMask(KEY_ALL, timeout);
 }
 
 /*****************************************************************************
@@ -75,171 +237,130 @@ checkKey2(void)
 /*****************************************************************************
  *
  * Description:
- *    Sample key states
+ *    Sample key states. All keys go through the same press, auto repeat
+ *    and release handling, the events are added to the queue.
  *
  ****************************************************************************/
-void
+static void
 sampleKey(void)
 {
-  tBool nothing = TRUE;
-  tU8   readKeys;
-  
+  tU8 readKeys;
+  tU8 pressed;
+  tU8 released;
+  tU8 key;
+  tU8 i;
+
   //get sample
-  readKeys = getKeys();
-  
+  readKeys = getKeys() & KEY_ALL;
 
-  //check center key
-  if (readKeys & KEY_CENTER)
-  {
-    nothing = FALSE;
-  	if (centerReleased == TRUE)
-  	{
-  		centerReleased = FALSE;
-  		centerKeyCnt = 0;
-  		activeKey = KEY_CENTER;
-  		activeKey2 = KEY_CENTER;
-  	}
-  	else
-  	{
-  	  centerKeyCnt++;
-  	  if (centerKeyCnt == FIRST_REPEAT)
-  	  {
-  		  activeKey = KEY_CENTER;
-  		  activeKey2 = KEY_CENTER;
-  	  }
-  	  else if (centerKeyCnt >= FIRST_REPEAT + SECOND_REPEAT)
-  	  {
-  		  centerKeyCnt = FIRST_REPEAT;
-  		  activeKey = KEY_CENTER;
-  		  activeKey2 = KEY_CENTER;
-  	  }
-  	}
-  }
-  else
-  	centerReleased = TRUE;
+  //the chords of the performance readout and of the replay are not key
+  //presses
+  if (PERF_KEYS(readKeys) == TRUE || REPLAY_KEYS(readKeys) == TRUE)
+    return;
 
-  //check up key
-  if (readKeys & KEY_UP)
-  {
-    nothing = FALSE;
-  	if (keyUpReleased == TRUE)
-  	{
-  		keyUpReleased = FALSE;
-  		upKeyCnt = 0;
-  		activeKey = KEY_UP;
-  		activeKey2 = KEY_UP;
-  	}
-  	else
-  	{
-  	  upKeyCnt++;
-  	  if (upKeyCnt == FIRST_REPEAT)
-  	  {
-  		  activeKey = KEY_UP;
-  		  activeKey2 = KEY_UP;
-  	  }
-  	  else if (upKeyCnt >= FIRST_REPEAT + SECOND_REPEAT)
-  	  {
-  		  upKeyCnt = FIRST_REPEAT;
-  		  activeKey = KEY_UP;
-  		  activeKey2 = KEY_UP;
-  	  }
-  	}
-  }
-  else
-  	keyUpReleased = TRUE;
+  pressed  = readKeys & ~lastKeys;
+  released = lastKeys & ~readKeys;
 
-  //check down key
-  if (readKeys & KEY_DOWN)
+  for(i=0, key=0x01; i<KEY_COUNT; i++, key<<=1)
   {
-    nothing = FALSE;
-  	if (keyDownReleased == TRUE)
-  	{
-  		keyDownReleased = FALSE;
-  		downKeyCnt = 0;
-  		activeKey = KEY_DOWN;
-  		activeKey2 = KEY_DOWN;
-  	}
-  	else
-  	{
-  	  downKeyCnt++;
-  	  if (downKeyCnt == FIRST_REPEAT)
-  	  {
-  		  activeKey = KEY_DOWN;
-  		  activeKey2 = KEY_DOWN;
-  	  }
-  	  else if (downKeyCnt >= FIRST_REPEAT + SECOND_REPEAT)
-  	  {
-  		  downKeyCnt = FIRST_REPEAT;
-  		  activeKey = KEY_DOWN;
-  		  activeKey2 = KEY_DOWN;
-  	  }
-  	}
+    if (pressed & key)
+    {
+      repeatCnt[i] = 0;
+      activeKey2   = key;
+      putEvent(KEY_EVENT_PRESS, key, readKeys);
+    }
+    else if (readKeys & key)
+    {
+      repeatCnt[i]++;
+      if (repeatCnt[i] >= FIRST_REPEAT + SECOND_REPEAT)
+        repeatCnt[i] = FIRST_REPEAT;
+      if (repeatCnt[i] == FIRST_REPEAT)
+      {
+        activeKey2 = key;
+        putEvent(KEY_EVENT_REPEAT, key, readKeys);
+      }
+    }
+    else if (released & key)
+      putEvent(KEY_EVENT_RELEASE, key, readKeys);
   }
-  else
-  	keyDownReleased = TRUE;
 
-  //check left key
-  if (readKeys & KEY_LEFT)
-  {
-    nothing = FALSE;
-  	if (keyLeftReleased == TRUE)
-  	{
-  		keyLeftReleased = FALSE;
-  		leftKeyCnt = 0;
-  		activeKey = KEY_LEFT;
-  		activeKey2 = KEY_LEFT;
-  	}
-  	else
-  	{
-  	  leftKeyCnt++;
-  	  if (leftKeyCnt == FIRST_REPEAT)
-  	  {
-  		  activeKey = KEY_LEFT;
-  		  activeKey2 = KEY_LEFT;
-  	  }
-  	  else if (leftKeyCnt >= FIRST_REPEAT + SECOND_REPEAT)
-  	  {
-  		  leftKeyCnt = FIRST_REPEAT;
-  		  activeKey = KEY_LEFT;
-  		  activeKey2 = KEY_LEFT;
-  	  }
-  	}
-  }
-  else
-  	keyLeftReleased = TRUE;
-
-  //check right key
-  if (readKeys & KEY_RIGHT)
-  {
-    nothing = FALSE;
-  	if (keyRightReleased == TRUE)
-  	{
-  		keyRightReleased = FALSE;
-  		rightKeyCnt = 0;
-  		activeKey = KEY_RIGHT;
-  		activeKey2 = KEY_RIGHT;
-  	}
-  	else
-  	{
-  	  rightKeyCnt++;
-  	  if (rightKeyCnt == FIRST_REPEAT)
-  	  {
-  		  activeKey = KEY_RIGHT;
-  		  activeKey2 = KEY_RIGHT;
-  	  }
-  	  else if (rightKeyCnt >= FIRST_REPEAT + SECOND_REPEAT)
-  	  {
-  		  rightKeyCnt = FIRST_REPEAT;
-  		  activeKey = KEY_RIGHT;
-  		  activeKey2 = KEY_RIGHT;
-  	  }
-  	}
-  }
-  else
-  	keyRightReleased = TRUE;
-  
-  if (nothing == TRUE)
+  lastKeys = readKeys;
+  if (readKeys == KEY_NOTHING)
     activeKey2 = KEY_NOTHING;
 }
 
 
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue the events of a replayed session that are due, and follow
+ *    them with the instantaneous key state.
+ *
+ ****************************************************************************/
+static void
+playKeys(void)
+{
+  tKeyEvent event;
+
+  while(REPLAY_NEXT(&event) == TRUE)
+  {
+    putEvent(event.type, event.key, event.held);
+    if (event.type != KEY_EVENT_RELEASE)
+      activeKey2 = event.key;
+    else if (event.held == KEY_NOTHING)
+      activeKey2 = KEY_NOTHING;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    A process entry function - samples the keys every 50 ms, or plays a
+ *    replayed session at the recorded ticks. On hardware
+ *    1.1 the keys are read from the PCA9532 over I2C, which must not be
+ *    done in the timer tick interrupt: the transfer takes the I2C lock
+ *    and waits for the bus.
+ *    The PCA9532 shares the bus with the EEPROM and the read takes the
+ *    same lock as eeprom.c. The process runs below the other processes,
+ *    so it never takes the bus ahead of an EEPROM transfer of a game; it
+ *    samples whenever they sleep or wait.
+ *
+ * Params:
+ *    [in] arg - This parameter is not used in this application.
+ *
+ ****************************************************************************/
+static void
+procKey(void* arg)
+{
+  for(;;)
+  {
+    if (REPLAY_PLAYING() == TRUE)
+    {
+      playKeys();
+      osSleep(1);
+    }
+    else
+    {
+      sampleKey();
+      osSleep(KEY_SAMPLE_TICKS);
+    }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize and start the key sampling process.
+ *
+ ****************************************************************************/
+void
+initKeyProc(void)
+{
+  tU8 error;
+
+  osSemInit(&keySem, 0);
+  osCreateProcess(procKey, procKeyStack, PROC_KEY_STACK_SIZE, &pidKey, PROC_KEY_PRIO, NULL, &error);
+  osStartProcess(pidKey, &error);
+}
@@ -28,11 +28,31 @@
 #define KEY_DOWN    0x04
 #define KEY_LEFT    0x08
 #define KEY_CENTER  0x10
+#define KEY_ALL     0x1f
 
+#define KEY_EVENT_PRESS   0
+#define KEY_EVENT_REPEAT  1     //key held, auto repeat
+#define KEY_EVENT_RELEASE 2
 
-tU8 checkKey(void);
-tU8 checkKey2(void);
+#define KEY_QUEUE_SIZE    32    //events, must be a power of 2
+#define KEY_QUEUE_MASK    (KEY_QUEUE_SIZE - 1)
 
-void sampleKey(void);
+typedef struct
+{
+  tU32 ms;                  //time of the sample (ms counter)
+  tU8  type;                //KEY_EVENT_
+  tU8  key;                 //the key of the event (one KEY_ bit)
+  tU8  held;                //all keys held at the sample (chords)
+} tKeyEvent;
+
+
+tU8   checkKey(void);
+tU8   checkKey2(void);
+tBool getKeyEvent(tKeyEvent* pEvent);
+void  keyFlush(void);
+tU8   waitKey(tU32 timeout);
+tU8   waitKeyMask(tU8 mask, tU32 timeout);
+
+void initKeyProc(void);
 
 #endif
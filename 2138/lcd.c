@@ -19,27 +19,11 @@
 #include "lcd.h"
 #include "ascii.h"
 #include "hw.h"
-
-
-/******************************************************************************
- * Typedefs and defines
- *****************************************************************************/
-#define LCD_CMD_SWRESET   0x01
-#define LCD_CMD_BSTRON    0x03
-#define LCD_CMD_SLEEPIN   0x10
-#define LCD_CMD_SLEEPOUT  0x11
-#define LCD_CMD_INVON     0x21
-#define LCD_CMD_SETCON    0x25
-#define LCD_CMD_DISPON    0x29
-#define LCD_CMD_CASET     0x2A
-#define LCD_CMD_PASET     0x2B
-#define LCD_CMD_RAMWR     0x2C
-#define LCD_CMD_RGBSET    0x2D
-#define LCD_CMD_MADCTL    0x36
-#define LCD_CMD_COLMOD    0x3A
-
-#define MADCTL_HORIZ      0x48
-#define MADCTL_VERT       0x68
+#include "lcdList.h"
+#include "lcdCache.h"
+#include "lcdPalette.h"
+#include "img.h"
+#include "font.h"
 
 
 /*****************************************************************************
@@ -51,10 +35,17 @@ static tU8 bkgColor;
 static tU8 textColor;
 static tU8 setcolmark;
 
+//characters collected for one text run (same line and colors)
+static tU8 runText[LCD_TEXT_RUN];
+static tU8 runLen;
+static tU8 runX;
+
 /*****************************************************************************
  * Local prototypes
  ****************************************************************************/
 static void lcdWindow1(tU8 xp, tU8 yp, tU8 xe, tU8 ye);
+static void lcdRunFlush(void);
+static void lcdPutchar1(tU8 data);
 
 
 /*****************************************************************************
@@ -68,6 +59,8 @@ static void lcdWindow1(tU8 xp, tU8 yp, tU8 xe, tU8 ye);
 void
 lcdInit(void)
 {
+  lcdFlush();
+
   bkgColor  = 0;
   textColor = 0;
   
@@ -78,6 +71,7 @@ lcdInit(void)
   selectLCD(TRUE);
 
 	lcdWrcmd(LCD_CMD_SWRESET);
+  lcdCacheReset();
 
 	osSleep(1);
 	lcdWrcmd(LCD_CMD_SLEEPOUT);
@@ -87,37 +81,20 @@ lcdInit(void)
 		
 	lcdWrcmd(LCD_CMD_MADCTL);   //Memory data acces control
 	lcdWrdata(MADCTL_HORIZ);    //X Mirror and BGR format
+  lcdCacheMadctl(MADCTL_HORIZ);
 	lcdWrcmd(LCD_CMD_COLMOD);   //Colour mode
 	lcdWrdata(0x02);            //256 colour mode select
 	lcdWrcmd(LCD_CMD_INVON);    //Non Invert mode
 
-	lcdWrcmd(LCD_CMD_RGBSET);   //LUT write
-  lcdWrdata(0);               //Red
-  lcdWrdata(2);
-  lcdWrdata(4);
-  lcdWrdata(6);
-  lcdWrdata(9);
-  lcdWrdata(11);
-  lcdWrdata(13);
-  lcdWrdata(15);
-  lcdWrdata(0);               //Green
-  lcdWrdata(2);
-  lcdWrdata(4);
-  lcdWrdata(6);
-  lcdWrdata(9);
-  lcdWrdata(11);
-  lcdWrdata(13);
-  lcdWrdata(15);
-  lcdWrdata(0);               //Blue
-  lcdWrdata(6);
-	lcdWrdata(10);
-	lcdWrdata(15);
-
   //deselect controller
   selectLCD(FALSE);
 
+  lcdPaletteSet(&lcdPaletteNormal);
 	lcdContrast(56);
 
+  //drawing is done by the display list from now on
+  lcdListInit();
+
 	lcdClrscr();
 }
 
@@ -126,28 +103,17 @@ lcdInit(void)
  *
  * Description:
  *    Clear screen (with current background color)
+ *    The whole 130x130 controller memory is cleared (window starts at
+ *    255,255 = column/row 1 in the controller).
  *
  ****************************************************************************/
 void
 lcdClrscr(void)
 {
-  tU32 i;
-
 	lcd_x = 0;
   lcd_y = 0;
 
-  //select controller
-  selectLCD(TRUE);   
-
-  lcdWindow1(255,255,128,128);
-  
-  lcdWrcmd(LCD_CMD_RAMWR);    //write memory
-  
-  for(i=0; i<16900; i++)
-    lcdWrdata(bkgColor);
-
-  //deselect controller
-  selectLCD(FALSE);
+  lcdListRect(255, 255, 130, 130, bkgColor);
 }
 
 
@@ -161,6 +127,7 @@ void
 lcdOff(void)
 {
   lcdClrscr();
+  lcdFlush();
 
   //select controller
   selectLCD(TRUE);   
@@ -195,6 +162,8 @@ lcdColor(tU8 bkg, tU8 text)
 void
 lcdContrast(tU8 cont) //vary between 0 - 127
 {
+  lcdFlush();
+
   //select controller
   selectLCD(TRUE);
 
@@ -211,27 +180,13 @@ lcdContrast(tU8 cont) //vary between 0 - 127
  *
  * Description:
  *    Draw a rectangular area with specified color.
+ *    Queued in the display list, returns before the area is drawn.
  *
  ****************************************************************************/
 void
 lcdRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color)
 {
-  tU32 i;
-  tU32 len;
-
-  //select controller
-  selectLCD(TRUE);   
-
-  lcdWindow1(x,y,x+xLen-1,y+yLen-1);
-  
-  lcdWrcmd(LCD_CMD_RAMWR);    //write memory
-  
-  len = xLen*yLen;
-  for(i=0; i<len; i++)
-    lcdWrdata(color);
-
-  //deselect controller
-  selectLCD(FALSE);
+  lcdListRect(x, y, xLen, yLen, color);
 }
 
 
@@ -245,7 +200,9 @@ lcdRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color)
 void
 lcdRectBrd(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color1, tU8 color2, tU8 color3)
 {
-  tU32 i,j;
+  tU32 j;
+
+  lcdFlush();
 
   //select controller
   selectLCD(TRUE);   
@@ -254,17 +211,14 @@ lcdRectBrd(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color1, tU8 color2, tU8 color3)
   
   lcdWrcmd(LCD_CMD_RAMWR);    //write memory
   
-  for(i=0; i<xLen; i++)
-    lcdWrdata(color2);
+  lcdFill(color2, xLen);
   for(j=1; j<(yLen-2); j++)
   {
-    lcdWrdata(color2);
-    for(i=0; i<(xLen-2); i++)
-      lcdWrdata(color1);
-    lcdWrdata(color3);
+    lcdFill(color2, 1);
+    lcdFill(color1, xLen-2);
+    lcdFill(color3, 1);
   }
-  for(i=0; i<xLen; i++)
-    lcdWrdata(color3);
+  lcdFill(color3, xLen);
 
   //deselect controller
   selectLCD(FALSE);
@@ -284,54 +238,102 @@ lcdRectBrd(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color1, tU8 color2, tU8 color3)
  *    Note that is is still possible to specify the color value that
  *    equals the escape value in a compressed string.
  *
+ *    Queued in the display list, returns before the bitmap is drawn.
+ *
  ****************************************************************************/
 void
 lcdIcon(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData)
 {
-  tU32 i,j;
-  tS32 len;
-
-  //select controller
-  selectLCD(TRUE);   
-
-  lcdWindow1(x,y,x+xLen-1,y+yLen-1);
-  
-  lcdWrcmd(LCD_CMD_RAMWR);    //write memory
-  
-  len = xLen*yLen;
-  if (compressionOn == FALSE)
-  {
-    for(i=0; i<len; i++)
-      lcdWrdata(*pData++);
-  }
-  else
-    while(len > 0)
-    {
-      if(*pData == escapeChar)
-      {
-        pData++;
-        j = *pData++;
-        for(i=0;i<j;i++)
-          lcdWrdata(*pData);
-        pData++;
-        len -= j;
-      }
-      else
-      {
-        lcdWrdata(*pData++);
-        len--;
-      }
-    }
-
-  //deselect controller
-  selectLCD(FALSE);
+  lcdListIcon(x, y, xLen, yLen, compressionOn, escapeChar, pData);
 }
 
 
 /*****************************************************************************
  *
  * Description:
- *    Update xy-position (by also creating a window).
+ *    Draw a bitmap (same format as lcdIcon()) rotated and/or mirrored.
+ *    The controller does the transformation: the bitmap is sent in its
+ *    stored order with another MADCTL value and a matching window, so
+ *    one bitmap serves all orientations without any per-pixel cost.
+ *
+ *    With LCD_ORIENT_SWAP the area on the screen is yLen wide and xLen
+ *    high, at xy-position.
+ *
+ * Params:
+ *    [in] orient - LCD_ORIENT_xxx, e.g. LCD_ORIENT_ROT_90
+ *
+ ****************************************************************************/
+void
+lcdIconOrient(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData, tU8 orient)
+{
+  lcdListIconOrient(x, y, xLen, yLen, compressionOn, escapeChar, pData, orient);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw one frame of an image container (see img.h) at xy-position.
+ *    The frame is decoded while it is sent to the controller, there is
+ *    no copy of it in RAM. Containers with a bad header are ignored.
+ *    Only frame 0 of an animation is a full frame (see anim.c).
+ *
+ *    Queued in the display list, returns before the image is drawn.
+ *
+ ****************************************************************************/
+void
+lcdImage(tU8 x, tU8 y, const tU8* pImg, tU8 frame)
+{
+  if (imgValid(pImg) == TRUE && frame < imgFrames(pImg) &&
+      (imgIsDelta(pImg) == FALSE || frame == 0))
+    lcdListImage(x, y, imgWidth(pImg), imgHeight(pImg), pImg, imgFrameData(pImg, frame),
+                 LCD_ORIENT_NORMAL);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a rectangle of coded pixels (see img.h) with the palette of an
+ *    image container, e.g. the changes of an animation frame. With pData
+ *    NULL the pixels that follow the previous rectangle are used, so
+ *    the rectangles of one coded stream must be drawn without any other
+ *    image in between.
+ *
+ *    Queued in the display list, returns before the pixels are drawn.
+ *
+ ****************************************************************************/
+void
+lcdImageRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, const tU8* pImg, const tU8* pData)
+{
+  lcdListImage(x, y, xLen, yLen, pImg, pData, LCD_ORIENT_NORMAL);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a wire format image (see img.h). The image is stored as the
+ *    LCD bus frames, including the window commands, so the position is
+ *    fixed when the image is generated and the frames are copied to the
+ *    bus without any decoding.
+ *
+ *    Queued in the display list, returns before the image is drawn.
+ *
+ ****************************************************************************/
+void
+lcdWireImage(const tU8* pImg)
+{
+  if (pImg != NULL && pImg[0] == IMG_WIRE_MAGIC)
+    lcdListWire(pImg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Update xy-position. No window is created, every character sets
+ *    its own window.
  *
  ****************************************************************************/
 void
@@ -339,7 +341,6 @@ lcdGotoxy(tU8 x, tU8 y)
 {
   lcd_x = x;
   lcd_y = y;
-  lcdWindow(x, y, 129, 129);
 }
 
 
@@ -354,6 +355,8 @@ lcdGotoxy(tU8 x, tU8 y)
 void
 lcdWindow(tU8 xp, tU8 yp, tU8 xe, tU8 ye)
 {
+  lcdFlush();
+
   //select controller
   selectLCD(TRUE);
 
@@ -370,18 +373,25 @@ lcdWindow(tU8 xp, tU8 yp, tU8 xe, tU8 ye)
  *    Initialize LCD controller for a window (to write in).
  *    Set start xy-position and xy-length
  *    No select/deselect of LCD controller.
+ *    CASET/PASET are skipped if the controller already has the values.
+ *    Restores the normal MADCTL after an oriented bitmap.
  *
  ****************************************************************************/
 static void
 lcdWindow1(tU8 xp, tU8 yp, tU8 xe, tU8 ye)
 {
-  lcdWrcmd(LCD_CMD_CASET);    //set X
-  lcdWrdata(xp+2);
-	lcdWrdata(xe+2);
+  tU16 words[LCD_WINDOW_WORDS];
+  tU8  n, i;
 
-	lcdWrcmd(LCD_CMD_PASET);    //set Y
-	lcdWrdata(yp+2);
-	lcdWrdata(ye+2);
+  if (lcdCacheMadctl(MADCTL_HORIZ) == TRUE)
+  {
+    sendToLCD(0, LCD_CMD_MADCTL);
+    sendToLCD(1, MADCTL_HORIZ);
+  }
+
+  n = lcdCacheWindow(xp+2, xe+2, yp+2, ye+2, words);
+  for(i=0; i<n; i++)
+    sendToLCD((tU8)(words[i] >> 8), (tU8)words[i]);
 }
 
 
@@ -394,6 +404,8 @@ lcdWindow1(tU8 xp, tU8 yp, tU8 xe, tU8 ye)
 static void
 lcdNewline(void)
 {
+  lcdRunFlush();
+
   lcd_x  = 0;
   lcd_y	+= 14;
   if (lcd_y >= 126)
@@ -401,65 +413,61 @@ lcdNewline(void)
 }
 
 
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue the collected text run (if any) in the display list.
+ *
+ ****************************************************************************/
+static void
+lcdRunFlush(void)
+{
+  if (runLen > 0)
+  {
+    lcdListText(runX, lcd_y, bkgColor, textColor, runText, runLen);
+    runLen = 0;
+  }
+}
+
+
 /*****************************************************************************
  *
  * Description:
  *    Draw one character withc current foreground and background color
  *    at current xy position on display. Update x-position (+8).
+ *    The character is added to the current text run, which is drawn
+ *    by lcdRunFlush().
  *
  ****************************************************************************/
 void
 lcdData(tU8 data)
 {
-  //select controller
-  selectLCD(TRUE);
-  
   if (data <= 127)
   {
-    tU32 mapOffset;
-    tU8 i,j,byteToShift;
-
-    data -= 30;
-    mapOffset = 14*data;
-
-    lcdWrcmd(LCD_CMD_CASET);
-    lcdWrdata(lcd_x+2);
-    lcdWrdata(lcd_x+9);
-    lcdWrcmd(LCD_CMD_PASET);
-    lcdWrdata(lcd_y+2);
-    lcdWrdata(lcd_y+15);
-    lcdWrcmd(LCD_CMD_RAMWR);
-    
-    for(i=0; i<14; i++)
-    {
-      byteToShift = charMap[mapOffset++];
-      for(j=0; j<8; j++)
-      {
-        if (byteToShift & 0x80)
-          lcdWrdata(textColor);
-        else
-          lcdWrdata(bkgColor);
-        byteToShift <<= 1;
-      }
-    }
+    if (runLen == 0)
+      runX = lcd_x;
+    runText[runLen++] = data;
+    if (runLen == LCD_TEXT_RUN)
+      lcdRunFlush();
   }
 
-  //deselect controller
-  selectLCD(FALSE);
+  //characters above 127 are not drawn, so the run cannot continue
+  else
+    lcdRunFlush();
 
   lcd_x += 8;
 }
 
 
-/*****************************************************************************
- *
- * Description:
- *    Write/draw one character at current xy-position.
- *    The xy-position is updated afterwards
- *
- ****************************************************************************/
-void
-lcdPutchar(tU8 data)
+/*****************************************************************************
+ *
+ * Description:
+ *    Write/draw one character at current xy-position, as part of a
+ *    text run. The xy-position is updated afterwards
+ *
+ ****************************************************************************/
+static void
+lcdPutchar1(tU8 data)
 {
   if (data == '\n')
     lcdNewline();
@@ -467,6 +475,8 @@ lcdPutchar(tU8 data)
   {
     if (setcolmark == TRUE)
     {
+      //text drawn so far uses the old color
+      lcdRunFlush();
       textColor = data;
       setcolmark = FALSE;
     }
@@ -479,17 +489,122 @@ lcdPutchar(tU8 data)
   }
 }
 
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write/draw one character at current xy-position.
+ *    The xy-position is updated afterwards
+ *
+ ****************************************************************************/
+void
+lcdPutchar(tU8 data)
+{
+  lcdPutchar1(data);
+  lcdRunFlush();
+}
+
 /*****************************************************************************
  *
  * Description:
  *    Write/draw (null-terminated) string of character at current xy-position
+ *    Each line (and each color change) is drawn in one window.
  *
  ****************************************************************************/
 void
-lcdPuts(char *s)
+lcdPuts(const char *s)
+{
+  while(*s != '\0')
+    lcdPutchar1(*s++);
+  lcdRunFlush();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a (null-terminated) string with a compiled font (see font.h) in
+ *    the current colors, clipped at the right edge of the screen. The
+ *    xy-position of lcdPuts() is not used or changed.
+ *
+ *    Queued in the display list, returns before the text is drawn.
+ *
+ * Returns:
+ *    The x-position after the text, where more text can be appended.
+ *
+ ****************************************************************************/
+tU8
+lcdText(tU8 x, tU8 y, const tU8* pFont, const char* s)
+{
+  tU16 runWidth;
+  tU8  len;
+
+  if (fontValid(pFont) == FALSE)
+    return x;
+
+  //text drawn with lcdPuts() must be queued first
+  lcdRunFlush();
+
+  while(*s != '\0' && x < 130)
+  {
+    for(len=0; len<LCD_TEXT_RUN && s[len] != '\0'; len++)
+      ;
+
+    runWidth = fontMeasure(pFont, s, len);
+    if (runWidth > 0)
+      lcdListFont(x, y, (x + runWidth > 130) ? 130 - x : runWidth,
+                  bkgColor, textColor, pFont, (const tU8*)s, len);
+
+    //the kerning between this run and the next one moves the next run
+    if (s[len] != '\0')
+      runWidth += fontKern(pFont, s[len - 1], s[len]);
+    x  = (x + runWidth > 130) ? 130 : x + runWidth;
+    s += len;
+  }
+  return x;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the width of a (null-terminated) string drawn with lcdText(),
+ *    e.g. to center or right align it.
+ *
+ ****************************************************************************/
+tU16
+lcdTextWidth(const tU8* pFont, const char* s)
 {
+  tU16 width = 0;
+
   while(*s != '\0')
-    lcdPutchar(*s++);
+  {
+    tU8 len;
+
+    for(len=0; len<LCD_TEXT_RUN && s[len] != '\0'; len++)
+      ;
+    width += fontMeasure(pFont, s, len);
+    if (s[len] != '\0')
+      width += fontKern(pFont, s[len - 1], s[len]);
+    s += len;
+  }
+  return width;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait until all queued drawing (lcdRect, lcdIcon and characters) has
+ *    been sent to the LCD controller. Must be called before the LCD
+ *    controller is accessed directly, and is called by all functions in
+ *    this file that do so.
+ *
+ ****************************************************************************/
+void
+lcdFlush(void)
+{
+  lcdListWait();
 }
 
 
@@ -519,3 +634,34 @@ lcdWrdata(tU8 data)
 }
 
 
+/*****************************************************************************
+ *
+ * Description:
+ *    Send a block of data bytes to LCD controller. The bytes are packed
+ *    into a continuous SPI stream (eight 9-bit words in nine 8-bit frames),
+ *    or queued as 9-bit frames when the SSP bus is used. Words that do not
+ *    fill a complete group are sent at the latest when the controller is
+ *    deselected.
+ *
+ ****************************************************************************/
+void
+lcdWrdataBurst(const tU8* pData, tU32 len)
+{
+  sendBurstToLCD(pData, len);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send the same data byte (typically a color) count times to LCD
+ *    controller, using the packed SPI stream.
+ *
+ ****************************************************************************/
+void
+lcdFill(tU8 data, tU32 count)
+{
+  sendFillToLCD(data, count);
+}
+
+
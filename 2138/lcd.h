@@ -13,20 +13,66 @@
 #ifndef _LCD_H_
 #define _LCD_H_
 
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LCD_CMD_NOP       0x00
+#define LCD_CMD_SWRESET   0x01
+#define LCD_CMD_BSTRON    0x03
+#define LCD_CMD_SLEEPIN   0x10
+#define LCD_CMD_SLEEPOUT  0x11
+#define LCD_CMD_NORON     0x13
+#define LCD_CMD_INVON     0x21
+#define LCD_CMD_SETCON    0x25
+#define LCD_CMD_DISPON    0x29
+#define LCD_CMD_CASET     0x2A
+#define LCD_CMD_PASET     0x2B
+#define LCD_CMD_RAMWR     0x2C
+#define LCD_CMD_RGBSET    0x2D
+#define LCD_CMD_VSCRDEF   0x33
+#define LCD_CMD_MADCTL    0x36
+#define LCD_CMD_VSCSAD    0x37
+#define LCD_CMD_COLMOD    0x3A
+
+#define MADCTL_MY         0x80      //mirror y
+#define MADCTL_MX         0x40      //mirror x
+#define MADCTL_V          0x20      //vertical addressing, rows written first
+#define MADCTL_HORIZ      0x48
+#define MADCTL_VERT       (MADCTL_HORIZ | MADCTL_V)
+
+//bitmap orientations for lcdIconOrient()
+#define LCD_ORIENT_NORMAL   0x00
+#define LCD_ORIENT_MIRROR_X 0x01    //bitmap rows drawn right to left
+#define LCD_ORIENT_MIRROR_Y 0x02    //bitmap drawn bottom to top
+#define LCD_ORIENT_SWAP     0x04    //bitmap rows drawn as columns
+#define LCD_ORIENT_ROT_90   (LCD_ORIENT_SWAP | LCD_ORIENT_MIRROR_X)    //clockwise
+#define LCD_ORIENT_ROT_180  (LCD_ORIENT_MIRROR_X | LCD_ORIENT_MIRROR_Y)
+#define LCD_ORIENT_ROT_270  (LCD_ORIENT_SWAP | LCD_ORIENT_MIRROR_Y)
+
+
 void lcdInit(void);
 void lcdOff(void);
 void lcdContrast(tU8 contr);
 void lcdClrscr(void);
 void lcdPutchar(tU8 data);
-void lcdPuts(char s[]);
+void lcdPuts(const char s[]);
 void lcdGotoxy(tU8 x, tU8 y);
 void lcdWindow(tU8 xp, tU8 yp, tU8 xe, tU8 ye);
 void lcdColor(tU8 bkg, tU8 text);
 void lcdRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color);
 void lcdRectBrd(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color1, tU8 color2, tU8 color3);
 void lcdIcon(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData);
+void lcdIconOrient(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData, tU8 orient);
+void lcdImage(tU8 x, tU8 y, const tU8* pImg, tU8 frame);
+void lcdImageRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, const tU8* pImg, const tU8* pData);
+void lcdWireImage(const tU8* pImg);
+tU8  lcdText(tU8 x, tU8 y, const tU8* pFont, const char* s);
+tU16 lcdTextWidth(const tU8* pFont, const char* s);
+void lcdFlush(void);
 
 void lcdWrdata(tU8 data);
 void lcdWrcmd(tU8 cmd);
+void lcdWrdataBurst(const tU8* pData, tU32 len);
+void lcdFill(tU8 data, tU32 count);
 
 #endif
@@ -0,0 +1,144 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdCache.c
+ *
+ * Description:
+ *    Keeps track of the column/page window and memory access mode that the
+ *    LCD controller currently has, so that a command setting the same
+ *    value again can be skipped. RAMWR is never skipped since it is what
+ *    resets the controller's write pointer to the window start.
+ *
+ *    The state is only touched by the one that owns the LCD bus, i.e. the
+ *    display list ISR, or a process after lcdFlush().
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "lcdCache.h"
+#include "lcd.h"
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tBool colValid = FALSE;
+static tU8   colStart;
+static tU8   colEnd;
+static tBool pageValid = FALSE;
+static tU8   pageStart;
+static tU8   pageEnd;
+static tBool madctlValid = FALSE;
+static tU8   madctl;
+
+static tLcdCacheStat stat;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Forget the controller state, must be called when the controller
+ *    is reset.
+ *
+ ****************************************************************************/
+void
+lcdCacheReset(void)
+{
+  colValid    = FALSE;
+  pageValid   = FALSE;
+  madctlValid = FALSE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the CASET/PASET words needed to set a window, leaving out the
+ *    ones that would set the value the controller already has.
+ *
+ * Params:
+ *    [in]  xs, xe, ys, ye - window in controller coordinates (offset 2)
+ *    [out] pWords         - 9-bit words to send, room for
+ *                           LCD_WINDOW_WORDS words
+ *
+ * Returns:
+ *    Number of words to send (0, 3 or 6).
+ *
+ ****************************************************************************/
+tU8
+lcdCacheWindow(tU8 xs, tU8 xe, tU8 ys, tU8 ye, tU16* pWords)
+{
+  tU8 n = 0;
+
+  if ((colValid == TRUE) && (colStart == xs) && (colEnd == xe))
+    stat.savedBytes += 3;
+  else
+  {
+    pWords[n++] = LCD_CMD_CASET;
+    pWords[n++] = 0x100 | xs;
+    pWords[n++] = 0x100 | xe;
+    colValid = TRUE;
+    colStart = xs;
+    colEnd   = xe;
+    stat.windowCmds++;
+  }
+
+  if ((pageValid == TRUE) && (pageStart == ys) && (pageEnd == ye))
+    stat.savedBytes += 3;
+  else
+  {
+    pWords[n++] = LCD_CMD_PASET;
+    pWords[n++] = 0x100 | ys;
+    pWords[n++] = 0x100 | ye;
+    pageValid = TRUE;
+    pageStart = ys;
+    pageEnd   = ye;
+    stat.windowCmds++;
+  }
+
+  return n;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check if the memory access mode must be sent.
+ *
+ * Returns:
+ *    TRUE if MADCTL with the value must be sent.
+ *
+ ****************************************************************************/
+tBool
+lcdCacheMadctl(tU8 value)
+{
+  if ((madctlValid == TRUE) && (madctl == value))
+  {
+    stat.savedBytes += 2;
+    return FALSE;
+  }
+
+  madctlValid = TRUE;
+  madctl      = value;
+  stat.modeCmds++;
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the command statistics.
+ *
+ ****************************************************************************/
+const tLcdCacheStat*
+lcdCacheStat(void)
+{
+  return &stat;
+}
@@ -0,0 +1,41 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdCache.h
+ *
+ * Description:
+ *    Expose the cache of LCD controller state (window and memory access
+ *    mode) used to skip redundant commands.
+ *
+ *****************************************************************************/
+#ifndef _LCD_CACHE_H_
+#define _LCD_CACHE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LCD_WINDOW_WORDS  6   //max number of words from lcdCacheWindow()
+
+typedef struct
+{
+  tU32 windowCmds;          //CASET/PASET commands sent
+  tU32 modeCmds;            //MADCTL commands sent
+  tU32 savedBytes;          //command and parameter bytes not sent
+} tLcdCacheStat;
+
+
+void lcdCacheReset(void);
+tU8  lcdCacheWindow(tU8 xs, tU8 xe, tU8 ys, tU8 ye, tU16* pWords);
+tBool lcdCacheMadctl(tU8 value);
+const tLcdCacheStat* lcdCacheStat(void);
+
+#endif
@@ -0,0 +1,184 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdCapture.c
+ *
+ * Description:
+ *    Capture of the words sent on the LCD bus, for regression checks of
+ *    what is drawn and what it costs. Between lcdCaptureBegin() and
+ *    lcdCaptureStop() every 9-bit word (commands, parameters and pixels,
+ *    from the display list as well as from direct writes) is sent to the
+ *    console UART, equal words as runs. The host tool tools/lcdreplay
+ *    interprets the stream into images and bus byte counts.
+ *
+ *    The UART is polled, also from the LCD bus interrupt, so drawing is
+ *    much slower while a capture runs. Nothing else may be printed on
+ *    the console during a capture.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include <consol.h>
+#include "lcdCapture.h"
+#include "lcdCache.h"
+#include "lcd.h"
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static volatile tBool capturing = FALSE;
+static tU16 runWord;
+static tU16 runCount = 0;
+
+//bits of the SPI frames of a wire format image
+static tU32 frameAcc;
+static tU8  frameBits = 0;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send one 16-bit unit of the stream.
+ *
+ ****************************************************************************/
+static void
+putUnit(tU16 unit)
+{
+  consolSendChar((char)unit);
+  consolSendChar((char)(unit >> 8));
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send the collected run of equal words.
+ *
+ ****************************************************************************/
+static void
+flushRun(void)
+{
+  if (runCount > 1)
+    putUnit(LCD_CAPTURE_REPEAT | runCount);
+  if (runCount > 0)
+    putUnit(runWord);
+  runCount = 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start a capture. Everything queued before is drawn first, and the
+ *    window and mode caches are cleared so that the capture starts with
+ *    complete window commands.
+ *
+ * Params:
+ *    [in] pName - name of the capture, e.g. the screen
+ *
+ ****************************************************************************/
+void
+lcdCaptureBegin(const char* pName)
+{
+  lcdFlush();
+  lcdCacheReset();
+
+  consolSendChar('L');
+  consolSendChar('C');
+  consolSendChar('D');
+  consolSendChar('C');
+  while(*pName != '\0')
+    consolSendChar(*pName++);
+  consolSendChar('\0');
+
+  runCount  = 0;
+  frameBits = 0;
+  capturing = TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    End a capture when everything queued has been drawn.
+ *
+ ****************************************************************************/
+void
+lcdCaptureStop(void)
+{
+  lcdFlush();
+  capturing = FALSE;
+
+  flushRun();
+  putUnit(LCD_CAPTURE_END);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Capture a word sent a number of times.
+ *
+ ****************************************************************************/
+void
+lcdCaptureFill(tU16 word, tU32 count)
+{
+  if (capturing == FALSE)
+    return;
+
+  while(count > 0)
+  {
+    tU32 n;
+
+    if (runCount > 0 && (runWord != word || runCount == LCD_CAPTURE_MAX_RUN))
+      flushRun();
+
+    n = LCD_CAPTURE_MAX_RUN - runCount;
+    if (n > count)
+      n = count;
+    runWord   = word;
+    runCount += n;
+    count    -= n;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Capture a block of data words.
+ *
+ ****************************************************************************/
+void
+lcdCaptureData(const tU8* pData, tU32 len)
+{
+  while(len-- > 0)
+    lcdCaptureFill(0x100 | *pData++, 1);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Capture an 8-bit SPI frame of packed 9-bit words (wire format images
+ *    sent as they are stored).
+ *
+ ****************************************************************************/
+void
+lcdCaptureFrame(tU8 frame)
+{
+  frameAcc   = (frameAcc << 8) | frame;
+  frameBits += 8;
+  if (frameBits >= 9)
+  {
+    frameBits -= 9;
+    lcdCaptureFill((frameAcc >> frameBits) & 0x1ff, 1);
+  }
+}
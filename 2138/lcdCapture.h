@@ -0,0 +1,63 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdCapture.h
+ *
+ * Description:
+ *    Expose the capture of the LCD bus words (build with LCD_CAPTURE).
+ *    Without LCD_CAPTURE all capture macros are empty.
+ *
+ *    Capture stream (sent to the console UART), 16-bit units are little
+ *    endian:
+ *      'L' 'C' 'D' 'C', name of the capture, '\0'
+ *      units: 0x0000 - 0x01ff  one 9-bit word (bit 8 set for data)
+ *             0x8000 | n       the next unit is repeated n times
+ *             LCD_CAPTURE_END  end of the capture
+ *
+ *****************************************************************************/
+#ifndef _LCD_CAPTURE_H_
+#define _LCD_CAPTURE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LCD_CAPTURE_REPEAT  0x8000
+#define LCD_CAPTURE_MAX_RUN 0x7fff
+#define LCD_CAPTURE_END     0xffff
+
+#ifdef LCD_CAPTURE
+
+#define LCD_CAPTURE_BEGIN(name)          lcdCaptureBegin(name)
+#define LCD_CAPTURE_STOP()               lcdCaptureStop()
+#define LCD_CAPTURE_WORD(word)           lcdCaptureFill((word), 1)
+#define LCD_CAPTURE_FILL(word, count)    lcdCaptureFill((word), (count))
+#define LCD_CAPTURE_DATA(pData, len)     lcdCaptureData((pData), (len))
+#define LCD_CAPTURE_FRAME(frame)         lcdCaptureFrame(frame)
+
+void lcdCaptureBegin(const char* pName);
+void lcdCaptureStop(void);
+void lcdCaptureFill(tU16 word, tU32 count);
+void lcdCaptureData(const tU8* pData, tU32 len);
+void lcdCaptureFrame(tU8 frame);
+
+#else
+
+#define LCD_CAPTURE_BEGIN(name)
+#define LCD_CAPTURE_STOP()
+#define LCD_CAPTURE_WORD(word)
+#define LCD_CAPTURE_FILL(word, count)
+#define LCD_CAPTURE_DATA(pData, len)
+#define LCD_CAPTURE_FRAME(frame)
+
+#endif
+
+#endif
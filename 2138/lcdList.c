@@ -0,0 +1,1038 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdList.c
+ *
+ * Description:
+ *    Interrupt driven display list for the LCD. Drawing calls only store a
+ *    small entry (window, color and a pointer to bitmap/glyph data) in a
+ *    ring buffer. The LCD bus interrupt expands the entries to 9-bit words
+ *    (window commands followed by pixels) and sends them in the
+ *    background, so the calling process can continue with game logic.
+ *
+ *    SPI0 (LPC2104): the words are packed eight by eight into nine 8-bit
+ *    frames and one frame is sent per SPI interrupt. A group that cannot
+ *    be filled when the list runs empty is padded with NOP commands.
+ *    SSP (LPC213x): the transmit FIFO is refilled with 9-bit frames every
+ *    time it is half empty.
+ *
+ *    Bitmap data referenced by an entry must stay valid until the entry
+ *    has been sent, which is always the case for the const images.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include <lpc2xxx.h>
+#include "lcdList.h"
+#include "lcdCache.h"
+#include "img.h"
+#include "font.h"
+#include "lcd.h"
+#include "lcdCapture.h"
+#include "perf.h"
+#include "prof.h"
+#include "hw.h"
+#include "irq_code/irqUart.h"
+#include "irq_code/irqLcd.h"
+#ifdef LCD_SSP
+#include "ssp.h"
+#endif
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LIST_RECT       0
+#define LIST_ICON       1
+#define LIST_ICON_RLE   2
+#define LIST_TEXT       3
+#define LIST_CMD        4
+#define LIST_IMAGE      5
+#define LIST_WIRE       6
+#define LIST_FONT       7
+
+#define GLYPH_ROWS      14    //8x14 characters in charMap
+#define LINE_BYTES      34    //bits of one scanline of a font run, 255 pixels + one glyph
+
+#define HEADER_WORDS    (2 + LCD_WINDOW_WORDS + 1)  //MADCTL, window commands and RAMWR
+
+#define LAST_ADDRESS    131   //last row/column in display memory
+
+#define GROUP_WORDS     8     //number of 9-bit words in one packed group
+#define GROUP_FRAMES    9     //number of 8-bit SPI frames in one packed group
+
+#ifdef LCD_SSP
+#define LCD_VIC_CHANNEL 11    //SPI1/SSP
+#else
+#define LCD_VIC_CHANNEL 10    //SPI0
+#endif
+
+typedef struct
+{
+  tU8 type;
+  tU8 x;
+  tU8 y;
+  tU8 xLen;
+  tU8 yLen;
+  tU8 color;          //fill color, or background color for text
+  tU8 textColor;
+  tU8 escapeChar;
+  tU8 orient;         //LCD_ORIENT_xxx, bitmaps only
+  const tU8* pImg;    //image container (palette) of coded pixels, or font
+  const tU8* pData;   //bitmap data
+  tU8 text[LCD_TEXT_RUN];
+} tListEntry;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tListEntry list[LCD_LIST_SIZE];
+static volatile tU32 listHead = 0;       //written by process
+static volatile tU32 listTail = 0;       //written by ISR
+static volatile tBool listBusy = FALSE;  //bus owned by the ISR
+static volatile tU8 listWaiters = 0;
+static tCntSem listIdleSem;
+static volatile tU8 freeWaiters = 0;    //processes waiting for a free entry
+static tCntSem listFreeSem;
+
+//state of the entry being sent (only accessed by the ISR)
+static tListEntry cur;
+static tU16 header[HEADER_WORDS];
+static tU8  headerLen = 0;
+static tU8  headerPos = 0;
+static tU32 pixelsLeft = 0;
+static tU8  runLeft;
+static tU8  runColor;
+
+static tU8  textChar;
+static tU8  textRow;
+
+static tBool iconTimed = FALSE;  //PROF_LCD_ICON runs for the entry
+
+//glyphs of a font run and the bits of the current scanline
+static const tU8* glyphBits[LCD_TEXT_RUN];
+static tU8  glyphX[LCD_TEXT_RUN];
+static tU8  glyphBytes[LCD_TEXT_RUN];
+static tU8  glyphCount;
+static tU8  lineBits[LINE_BYTES];
+static tU8  lineX;
+
+static tImgDecoder imgDecoder;
+
+//pre-encoded bus frames of a wire format image
+static const tU8* pWire;
+static volatile tU32 wireLeft = 0;
+static tBool wireNext = FALSE;
+#ifdef LCD_SSP
+static tU32 wireAcc;
+static tU8  wireBits = 0;
+#endif
+
+//glyph row patterns: 4 pixels for every value of a half glyph row
+static tU32  pattern[16];
+static tU8   patternBkg;
+static tU8   patternText;
+static tBool patternValid = FALSE;
+static tU32  rowPixels[2];
+
+#ifndef LCD_SSP
+static tU8 frame[GROUP_FRAMES];
+static tU8 framePos = GROUP_FRAMES;
+#endif
+
+/*****************************************************************************
+ * External variables
+ ****************************************************************************/
+extern const tU8 charMap[];
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static void  buildPatterns(tU8 bkg, tU8 text);
+static void  startFont(void);
+static void  buildFontLine(void);
+static tU8   nextPixel(void);
+static tBool nextWord(tU16* pWord);
+static void  feedBus(void);
+static void  startBus(void);
+static void  stopBus(void);
+static tListEntry* allocEntry(tU32* pCpsr);
+static void  commitEntry(tU32 cpsrReg);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize the display list and install the LCD bus interrupt.
+ *    The LCD controller must be initialized and deselected.
+ *
+ ****************************************************************************/
+void
+lcdListInit(void)
+{
+  osSemInit(&listIdleSem, 0);
+  osSemInit(&listFreeSem, 0);
+
+  listHead    = 0;
+  listTail    = 0;
+  listBusy    = FALSE;
+  listWaiters = 0;
+  freeWaiters = 0;
+
+  //initialize the interrupt vector
+  VICIntSelect &= ~(1 << LCD_VIC_CHANNEL);            // selected as IRQ
+  VICVectCntl8  =  0x00000020 | LCD_VIC_CHANNEL;
+  VICVectAddr8  =  (tU32)lcdISR;                     // address of the ISR
+  VICIntEnable |=  (1 << LCD_VIC_CHANNEL);            // interrupt enabled
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get a free entry in the display list. If the list is full the calling
+ *    process blocks (on a semaphore) until the ISR has taken an entry.
+ *    Returns with IRQ disabled, so that no other process can take the same
+ *    entry before it has been filled and committed with commitEntry().
+ *
+ ****************************************************************************/
+static tListEntry*
+allocEntry(tU32* pCpsr)
+{
+  tU8 error;
+
+  //disable IRQ
+  *pCpsr = disIrq();
+
+  while(((listHead + 1) & LCD_LIST_MASK) == listTail)
+  {
+    freeWaiters++;
+
+    //enable IRQ
+    restoreIrq(*pCpsr);
+    osSemTake(&listFreeSem, 0, &error);
+
+    //disable IRQ
+    *pCpsr = disIrq();
+  }
+
+  return &list[listHead];
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Make the entry returned by allocEntry() visible to the ISR, start
+ *    the LCD bus if it is idle and enable IRQ again.
+ *
+ ****************************************************************************/
+static void
+commitEntry(tU32 cpsrReg)
+{
+  listHead = (listHead + 1) & LCD_LIST_MASK;
+  if (listBusy == FALSE)
+  {
+    listBusy = TRUE;
+    startBus();
+  }
+
+  //enable IRQ
+  restoreIrq(cpsrReg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a rectangular area with specified color.
+ *
+ ****************************************************************************/
+void
+lcdListRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color)
+{
+  tU32 cpsrReg;
+  tListEntry* pEntry = allocEntry(&cpsrReg);
+
+  pEntry->type  = LIST_RECT;
+  pEntry->orient = LCD_ORIENT_NORMAL;
+  pEntry->x     = x;
+  pEntry->y     = y;
+  pEntry->xLen  = xLen;
+  pEntry->yLen  = yLen;
+  pEntry->color = color;
+  commitEntry(cpsrReg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a bitmap, in the same (optionally compressed) format as lcdIcon().
+ *
+ ****************************************************************************/
+void
+lcdListIcon(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData)
+{
+  lcdListIconOrient(x, y, xLen, yLen, compressionOn, escapeChar, pData, LCD_ORIENT_NORMAL);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a bitmap drawn with another orientation, see lcdIconOrient().
+ *    The entry holds the area on the screen, i.e., xLen and yLen are
+ *    exchanged for LCD_ORIENT_SWAP.
+ *
+ ****************************************************************************/
+void
+lcdListIconOrient(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData, tU8 orient)
+{
+  tU32 cpsrReg;
+  tListEntry* pEntry = allocEntry(&cpsrReg);
+
+  pEntry->type       = (compressionOn == FALSE) ? LIST_ICON : LIST_ICON_RLE;
+  pEntry->x          = x;
+  pEntry->y          = y;
+  pEntry->xLen       = (orient & LCD_ORIENT_SWAP) ? yLen : xLen;
+  pEntry->yLen       = (orient & LCD_ORIENT_SWAP) ? xLen : yLen;
+  pEntry->escapeChar = escapeChar;
+  pEntry->orient     = orient;
+  pEntry->pData      = pData;
+  commitEntry(cpsrReg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue coded pixels of an image container (see img.h), a full frame
+ *    or a rectangle of a delta frame. The pixels are decoded one by one
+ *    by the ISR while they are sent.
+ *
+ * Params:
+ *    [in] pImg  - image container, for the palette
+ *    [in] pData - coded pixels, or NULL to continue with the pixels after
+ *                 the previous image entry (must be queued right after it)
+ *
+ ****************************************************************************/
+void
+lcdListImage(tU8 x, tU8 y, tU8 xLen, tU8 yLen, const tU8* pImg, const tU8* pData, tU8 orient)
+{
+  tU32 cpsrReg;
+  tListEntry* pEntry = allocEntry(&cpsrReg);
+
+  pEntry->type   = LIST_IMAGE;
+  pEntry->x      = x;
+  pEntry->y      = y;
+  pEntry->xLen   = (orient & LCD_ORIENT_SWAP) ? yLen : xLen;
+  pEntry->yLen   = (orient & LCD_ORIENT_SWAP) ? xLen : yLen;
+  pEntry->pImg   = pImg;
+  pEntry->pData  = pData;
+  pEntry->orient = orient;
+  commitEntry(cpsrReg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a wire format image (see img.h), i.e., LCD bus frames that are
+ *    copied to the bus without any decoding.
+ *
+ ****************************************************************************/
+void
+lcdListWire(const tU8* pImg)
+{
+  tU32 cpsrReg;
+  tListEntry* pEntry = allocEntry(&cpsrReg);
+
+  pEntry->type  = LIST_WIRE;
+  pEntry->x     = pImg[1];
+  pEntry->y     = pImg[2];
+  pEntry->xLen  = pImg[3];
+  pEntry->yLen  = pImg[4];
+  pEntry->pData = pImg;
+  commitEntry(cpsrReg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a run of 8x14 characters (30 - 127) in one window. The run is
+ *    sent scanline by scanline over all characters.
+ *
+ * Params:
+ *    [in] pText - characters, copied to the display list
+ *    [in] len   - number of characters, 1 - LCD_TEXT_RUN
+ *
+ ****************************************************************************/
+void
+lcdListText(tU8 x, tU8 y, tU8 bkg, tU8 text, const tU8* pText, tU8 len)
+{
+  tU32 cpsrReg;
+  tListEntry* pEntry = allocEntry(&cpsrReg);
+  tU8 i;
+
+  pEntry->type      = LIST_TEXT;
+  pEntry->orient    = LCD_ORIENT_NORMAL;
+  pEntry->x         = x;
+  pEntry->y         = y;
+  pEntry->xLen      = 8*len;
+  pEntry->yLen      = GLYPH_ROWS;
+  pEntry->color     = bkg;
+  pEntry->textColor = text;
+  for(i=0; i<len; i++)
+    pEntry->text[i] = pText[i];
+  commitEntry(cpsrReg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a run of characters of a compiled font (see font.h) in one
+ *    window. The glyphs are placed and merged scanline by scanline by
+ *    the ISR, the window is xLen pixels wide and as high as the font.
+ *
+ * Params:
+ *    [in] pFont - font, must stay valid until the run has been sent
+ *    [in] pText - characters, copied to the display list
+ *    [in] len   - number of characters, 1 - LCD_TEXT_RUN
+ *
+ ****************************************************************************/
+void
+lcdListFont(tU8 x, tU8 y, tU8 xLen, tU8 bkg, tU8 text, const tU8* pFont, const tU8* pText, tU8 len)
+{
+  tU32 cpsrReg;
+  tListEntry* pEntry = allocEntry(&cpsrReg);
+  tU8 i;
+
+  pEntry->type      = LIST_FONT;
+  pEntry->orient    = LCD_ORIENT_NORMAL;
+  pEntry->x         = x;
+  pEntry->y         = y;
+  pEntry->xLen      = xLen;
+  pEntry->yLen      = fontHeight(pFont);
+  pEntry->color     = bkg;
+  pEntry->textColor = text;
+  pEntry->pImg      = pFont;
+  for(i=0; i<len; i++)
+    pEntry->text[i] = pText[i];
+  if (len < LCD_TEXT_RUN)
+    pEntry->text[len] = '\0';
+  commitEntry(cpsrReg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a controller command with parameters, e.g. a scroll command
+ *    that must be sent in order with the drawing before and after it.
+ *
+ * Params:
+ *    [in] pParams - parameter bytes, copied to the display list
+ *    [in] len     - number of parameters, 0 - LCD_CMD_PARAMS
+ *
+ ****************************************************************************/
+void
+lcdListCmd(tU8 cmd, const tU8* pParams, tU8 len)
+{
+  tU32 cpsrReg;
+  tListEntry* pEntry = allocEntry(&cpsrReg);
+  tU8 i;
+
+  if (len > LCD_CMD_PARAMS)
+    len = LCD_CMD_PARAMS;
+
+  pEntry->type  = LIST_CMD;
+  pEntry->color = cmd;
+  pEntry->xLen  = len;
+  for(i=0; i<len; i++)
+    pEntry->text[i] = pParams[i];
+  commitEntry(cpsrReg);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait until everything in the display list has been sent to the LCD
+ *    controller and the bus has been released. Blocks the calling process
+ *    (on a semaphore) instead of polling.
+ *
+ ****************************************************************************/
+void
+lcdListWait(void)
+{
+  volatile tU32 cpsrReg;
+  tBool wait = FALSE;
+  tU8   error;
+
+  //disable IRQ
+  cpsrReg = disIrq();
+
+  if (listBusy == TRUE)
+  {
+    listWaiters++;
+    wait = TRUE;
+  }
+
+  //enable IRQ
+  restoreIrq(cpsrReg);
+
+  if (wait == TRUE)
+    osSemTake(&listIdleSem, 0, &error);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Expand all 16 values of a half glyph row into 4 pixels each.
+ *    Rebuilt only when the color pair changes.
+ *
+ ****************************************************************************/
+static void
+buildPatterns(tU8 bkg, tU8 text)
+{
+  tU8 i, j;
+
+  for(i=0; i<16; i++)
+    for(j=0; j<4; j++)
+      ((tU8*)&pattern[i])[j] = (i & (0x08 >> j)) ? text : bkg;
+
+  patternBkg   = bkg;
+  patternText  = text;
+  patternValid = TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Look up the glyphs and positions of a font run (once per entry).
+ *
+ ****************************************************************************/
+static void
+startFont(void)
+{
+  tS16 x = 0;
+  tU8  width, advance;
+  tU8  i;
+
+  glyphCount = 0;
+  for(i=0; i<LCD_TEXT_RUN && cur.text[i] != '\0'; i++)
+  {
+    const tU8* pBits = fontGlyph(cur.pImg, cur.text[i], &width, &advance);
+
+    if (pBits != NULL && width > 0 && x < cur.xLen)
+    {
+      glyphBits[glyphCount]  = pBits;
+      glyphX[glyphCount]     = x;
+      glyphBytes[glyphCount] = (width + 7) >> 3;
+      glyphCount++;
+    }
+
+    x += advance;
+    if (i + 1 < LCD_TEXT_RUN && cur.text[i + 1] != '\0')
+      x += fontKern(cur.pImg, cur.text[i], cur.text[i + 1]);
+    if (x < 0)
+      x = 0;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Merge the rows of all glyphs of a font run into the bits of one
+ *    scanline, the glyph bitmaps advance to the next row.
+ *
+ ****************************************************************************/
+static void
+buildFontLine(void)
+{
+  tU8 i, j;
+
+  for(i=0; i<=(cur.xLen >> 3); i++)
+    lineBits[i] = 0;
+
+  for(i=0; i<glyphCount; i++)
+  {
+    tU8* pLine = &lineBits[glyphX[i] >> 3];
+    tU8  shift = glyphX[i] & 7;
+
+    for(j=0; j<glyphBytes[i]; j++)
+    {
+      pLine[j]     |= *glyphBits[i] >> shift;
+      pLine[j + 1] |= *glyphBits[i] << (8 - shift);
+      glyphBits[i]++;
+    }
+  }
+  lineX = 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get next pixel of the current entry.
+ *
+ ****************************************************************************/
+static tU8
+nextPixel(void)
+{
+  switch(cur.type)
+  {
+    case LIST_RECT:
+    return cur.color;
+
+    case LIST_ICON:
+    return *cur.pData++;
+
+    case LIST_ICON_RLE:
+    while(runLeft == 0)
+    {
+      if (*cur.pData == cur.escapeChar)
+      {
+        runLeft  = cur.pData[1];
+        runColor = cur.pData[2];
+        cur.pData += 3;
+      }
+      else
+      {
+        runLeft  = 1;
+        runColor = *cur.pData++;
+      }
+    }
+    runLeft--;
+    return runColor;
+
+    case LIST_IMAGE:
+    return imgDecodePixel(&imgDecoder);
+
+    case LIST_FONT:
+    if (lineX == cur.xLen)
+      buildFontLine();
+    if ((lineX & 7) == 0)
+    {
+      tU8 bits = lineBits[lineX >> 3];
+
+      rowPixels[0] = pattern[bits >> 4];
+      rowPixels[1] = pattern[bits & 0x0f];
+    }
+    return ((tU8*)rowPixels)[lineX++ & 7];
+
+    case LIST_TEXT:
+    default:
+    //runLeft counts the remaining pixels of the current glyph row
+    if (runLeft == 0)
+    {
+      tU8 bits;
+
+      if (textChar == (cur.xLen >> 3))
+      {
+        textChar = 0;
+        textRow++;
+      }
+      bits = charMap[GLYPH_ROWS*(tU8)(cur.text[textChar++] - 30) + textRow];
+      rowPixels[0] = pattern[bits >> 4];
+      rowPixels[1] = pattern[bits & 0x0f];
+      runLeft = 8;
+    }
+    return ((tU8*)rowPixels)[8 - runLeft--];
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get next 9-bit word to send (bit 8 = command/data bit). Takes a new
+ *    entry from the display list when the current one is complete.
+ *
+ *    SPI0: a wire format image is not returned as words, its frames are
+ *    sent as they are by feedBus() from the next group on.
+ *
+ * Returns:
+ *    FALSE if the display list is empty, or (SPI0) while the frames of a
+ *    wire format image are sent.
+ *
+ ****************************************************************************/
+static tBool
+nextWord(tU16* pWord)
+{
+  tU8 madctl, xs, xe, ys, ye, tmp;
+
+  for(;;)
+  {
+    if (headerPos < headerLen)
+    {
+      *pWord = header[headerPos++];
+      return TRUE;
+    }
+
+    if (wireNext == TRUE)
+    {
+      wireNext = FALSE;
+      pWire    = cur.pData + IMG_WIRE_HEADER;
+      wireLeft = cur.pData[5] | (cur.pData[6] << 8) |
+                 (cur.pData[7] << 16) | ((tU32)cur.pData[8] << 24);
+#ifndef LCD_SSP
+      PERF_LCD_WORDS(wireLeft * 8 / 9);   //frames are sent by feedBus()
+#endif
+    }
+
+#ifdef LCD_SSP
+    if (wireLeft > 0 || wireBits >= 9)
+    {
+      while(wireBits < 9)
+      {
+        wireAcc   = (wireAcc << 8) | *pWire++;
+        wireBits += 8;
+        wireLeft--;
+      }
+      wireBits -= 9;
+      *pWord = (wireAcc >> wireBits) & 0x1ff;
+      return TRUE;
+    }
+#else
+    if (wireLeft > 0)
+      return FALSE;
+#endif
+
+    if (pixelsLeft > 0)
+    {
+      pixelsLeft--;
+      *pWord = 0x100 | nextPixel();
+      return TRUE;
+    }
+
+    //all words of a bitmap entry have been handed to the bus
+    if (iconTimed == TRUE)
+    {
+      iconTimed = FALSE;
+      PROF_END(PROF_LCD_ICON);
+    }
+
+    if (listTail == listHead)
+      return FALSE;
+
+    cur      = list[listTail];
+    listTail = (listTail + 1) & LCD_LIST_MASK;
+    if (freeWaiters > 0)
+    {
+      tU8 error;
+
+      freeWaiters--;
+      osSemGive(&listFreeSem, &error);
+    }
+
+    if (cur.type == LIST_ICON || cur.type == LIST_ICON_RLE)
+    {
+      iconTimed = TRUE;
+      PROF_BEGIN(PROF_LCD_ICON);
+    }
+
+    headerPos = 0;
+    if (cur.type == LIST_CMD)
+    {
+      //command and parameters only, no window and no pixels
+      header[0] = cur.color;
+      for(headerLen=0; headerLen<cur.xLen; headerLen++)
+        header[headerLen + 1] = 0x100 | cur.text[headerLen];
+      headerLen++;
+      continue;
+    }
+
+    if (cur.type == LIST_WIRE)
+    {
+      tU16 windowCmds[LCD_WINDOW_WORDS];
+
+      //the frames hold the window commands, keep the cache up to date
+      headerLen = 0;
+      if (lcdCacheMadctl(MADCTL_HORIZ) == TRUE)
+      {
+        header[headerLen++] = LCD_CMD_MADCTL;
+        header[headerLen++] = 0x100 | MADCTL_HORIZ;
+      }
+      lcdCacheWindow(cur.x + 2, cur.x + cur.xLen + 1,
+                     cur.y + 2, cur.y + cur.yLen + 1, windowCmds);
+      wireNext = TRUE;
+      continue;
+    }
+
+    //the controller mirrors the addresses for a mirrored orientation
+    madctl = MADCTL_HORIZ;
+    xs = cur.x + 2;
+    xe = cur.x + cur.xLen + 1;
+    ys = cur.y + 2;
+    ye = cur.y + cur.yLen + 1;
+    if (cur.orient & LCD_ORIENT_SWAP)
+      madctl |= MADCTL_V;
+    if (cur.orient & LCD_ORIENT_MIRROR_X)
+    {
+      madctl ^= MADCTL_MX;
+      tmp = xs;
+      xs  = LAST_ADDRESS - xe;
+      xe  = LAST_ADDRESS - tmp;
+    }
+    if (cur.orient & LCD_ORIENT_MIRROR_Y)
+    {
+      madctl ^= MADCTL_MY;
+      tmp = ys;
+      ys  = LAST_ADDRESS - ye;
+      ye  = LAST_ADDRESS - tmp;
+    }
+
+    headerLen = 0;
+    if (lcdCacheMadctl(madctl) == TRUE)
+    {
+      header[headerLen++] = LCD_CMD_MADCTL;
+      header[headerLen++] = 0x100 | madctl;
+    }
+    headerLen += lcdCacheWindow(xs, xe, ys, ye, &header[headerLen]);
+    header[headerLen++] = LCD_CMD_RAMWR;
+    pixelsLeft = (tU32)cur.xLen * cur.yLen;
+    runLeft    = 0;
+    textChar   = 0;
+    textRow    = 0;
+
+    if ((cur.type == LIST_TEXT || cur.type == LIST_FONT) &&
+        ((patternValid == FALSE) || (patternBkg != cur.color) || (patternText != cur.textColor)))
+      buildPatterns(cur.color, cur.textColor);
+    if (cur.type == LIST_FONT)
+    {
+      startFont();
+      buildFontLine();
+    }
+    else if (cur.type == LIST_IMAGE && cur.pData != NULL)
+      imgDecodeStart(&imgDecoder, cur.pImg, cur.pData);
+  }
+}
+
+#ifdef LCD_SSP
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Take the LCD bus (called with IRQ disabled when the list goes from
+ *    idle to busy). The SSP interrupt fires directly since the transmit
+ *    FIFO is empty.
+ *
+ ****************************************************************************/
+static void
+startBus(void)
+{
+  selectLCD(TRUE);
+  SSP_WRITE(SSPIMSC, SSPIMSC_TXIM);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Refill the SSP transmit FIFO from the display list.
+ *
+ ****************************************************************************/
+static void
+feedBus(void)
+{
+  volatile tU32 dummy;
+  tU16 word;
+
+  while(SSP_READ(SSPSR) & SSPSR_TNF)
+  {
+    if (nextWord(&word) == FALSE)
+    {
+      stopBus();
+      return;
+    }
+    LCD_CAPTURE_WORD(word);
+    PERF_LCD_WORDS(1);
+    SSP_WRITE(SSPDR, word);
+
+    //nothing is received, just keep the receive FIFO from overflowing
+    if (SSP_READ(SSPSR) & SSPSR_RNE)
+      dummy = SSP_READ(SSPDR);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Release the LCD bus when the display list is empty. The remaining
+ *    (at most half a FIFO of) frames must be shifted out before chip
+ *    select is released.
+ *
+ ****************************************************************************/
+static void
+stopBus(void)
+{
+  tU8 error;
+
+  SSP_WRITE(SSPIMSC, 0x00);
+  sspWaitIdle();
+  selectLCD(FALSE);
+
+  listBusy = FALSE;
+  while(listWaiters > 0)
+  {
+    listWaiters--;
+    osSemGive(&listIdleSem, &error);
+  }
+}
+
+#else
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Take the LCD bus (called with IRQ disabled when the list goes from
+ *    idle to busy) and send the first frame. The SPI interrupt takes
+ *    over from there.
+ *
+ ****************************************************************************/
+static void
+startBus(void)
+{
+  selectLCD(TRUE);
+
+  //initialize SPI interface, with interrupt
+  SPI_SPCCR = 0x08;
+  SPI_SPCR  = 0xa0;
+
+  //connect SPI bus to IO-pins
+  PINSEL0 |= 0x00005500;
+
+  framePos = GROUP_FRAMES;
+  feedBus();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Send next SPI frame. A new group of eight words is packed into nine
+ *    frames when the previous group has been sent. The frames of a wire
+ *    format image are sent directly from flash.
+ *
+ ****************************************************************************/
+static void
+feedBus(void)
+{
+  if (framePos == GROUP_FRAMES && wireLeft == 0)
+  {
+    tU32  acc  = 0;
+    tU8   bits = 0;
+    tU8   pos  = 0;
+    tU8   i;
+    tU16  word;
+    tBool empty = TRUE;
+
+    for(i=0; i<GROUP_WORDS; i++)
+    {
+      if (nextWord(&word) == TRUE)
+        empty = FALSE;
+      else if (empty == TRUE)
+        break;
+      else
+        word = LCD_CMD_NOP;     //pad the last group
+      LCD_CAPTURE_WORD(word);
+      PERF_LCD_WORDS(1);
+
+      acc   = (acc << 9) | word;
+      bits += 9;
+      while(bits >= 8)
+      {
+        bits -= 8;
+        frame[pos++] = (tU8)(acc >> bits);
+      }
+    }
+
+    if (empty == FALSE)
+      framePos = 0;
+    else if (wireLeft == 0)
+    {
+      stopBus();
+      return;
+    }
+  }
+
+  if (framePos == GROUP_FRAMES)
+  {
+    LCD_CAPTURE_FRAME(*pWire);
+    SPI_SPDR = *pWire++;
+    wireLeft--;
+  }
+  else
+    SPI_SPDR = frame[framePos++];
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Release the LCD bus when the display list is empty.
+ *
+ ****************************************************************************/
+static void
+stopBus(void)
+{
+  volatile tU32 dummy;
+  tU8 error;
+
+  SPI_SPCR = 0x20;       //no more SPI interrupts
+  dummy    = SPI_SPDR;   //completes clearing of SPIF
+  selectLCD(FALSE);
+
+  listBusy = FALSE;
+  while(listWaiters > 0)
+  {
+    listWaiters--;
+    osSemGive(&listIdleSem, &error);
+  }
+}
+
+#endif
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Called by the LCD bus ISR (irq_code/irqLcd.c).
+ *
+ ****************************************************************************/
+void
+lcdListIsr(void)
+{
+#ifdef LCD_SSP
+  feedBus();
+#else
+  volatile tU32 dummy;
+
+  //clear SPI interrupt flag and SPIF (by reading status register)
+  SPI_SPINT = 0x01;
+  dummy     = SPI_SPSR;
+
+  if (listBusy == TRUE)
+    feedBus();
+  else
+    dummy = SPI_SPDR;
+#endif
+}
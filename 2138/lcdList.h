@@ -0,0 +1,43 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdList.h
+ *
+ * Description:
+ *    Expose the interrupt driven LCD display list.
+ *
+ *****************************************************************************/
+#ifndef _LCD_LIST_H_
+#define _LCD_LIST_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LCD_LIST_SIZE  32     //number of entries in display list, power of 2
+#define LCD_LIST_MASK  (LCD_LIST_SIZE - 1)
+#define LCD_TEXT_RUN   16     //max characters in one text run (one line)
+#define LCD_CMD_PARAMS 6      //max parameters of a queued command
+
+
+void lcdListInit(void);
+void lcdListRect(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 color);
+void lcdListIcon(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData);
+void lcdListIconOrient(tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 compressionOn, tU8 escapeChar, const tU8* pData, tU8 orient);
+void lcdListImage(tU8 x, tU8 y, tU8 xLen, tU8 yLen, const tU8* pImg, const tU8* pData, tU8 orient);
+void lcdListWire(const tU8* pImg);
+void lcdListText(tU8 x, tU8 y, tU8 bkg, tU8 text, const tU8* pText, tU8 len);
+void lcdListFont(tU8 x, tU8 y, tU8 xLen, tU8 bkg, tU8 text, const tU8* pFont, const tU8* pText, tU8 len);
+void lcdListCmd(tU8 cmd, const tU8* pParams, tU8 len);
+void lcdListWait(void);
+void lcdListIsr(void);
+
+#endif
@@ -0,0 +1,237 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdPalette.c
+ *
+ * Description:
+ *    Palette routines. In 256 color mode the controller maps the 3 red,
+ *    3 green and 2 blue bits of a pixel to 4-bit intensities through a
+ *    lookup table that is written with RGBSET (20 bytes). Changing the
+ *    table changes the whole screen at once, so fades and color cycling
+ *    cost 21 bytes per step instead of redrawing pixels.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include "lcdPalette.h"
+#include "lcd.h"
+#include "hw.h"
+
+
+/*****************************************************************************
+ * Public variables
+ ****************************************************************************/
+const tLcdPalette lcdPaletteNormal =
+{
+  {0, 2, 4, 6, 9, 11, 13, 15},
+  {0, 2, 4, 6, 9, 11, 13, 15},
+  {0, 6, 10, 15}
+};
+
+const tLcdPalette lcdPaletteBlack =
+{
+  {0, 0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0}
+};
+
+const tLcdPalette lcdPaletteWhite =
+{
+  {15, 15, 15, 15, 15, 15, 15, 15},
+  {15, 15, 15, 15, 15, 15, 15, 15},
+  {15, 15, 15, 15}
+};
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tLcdPalette current;
+
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static tU8* channelEntries(tLcdPalette* pPalette, tU8 channel, tU8* pCount);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write a palette to the controller (RGBSET).
+ *
+ ****************************************************************************/
+void
+lcdPaletteSet(const tLcdPalette* pPalette)
+{
+  lcdFlush();
+
+  //select controller
+  selectLCD(TRUE);
+
+  lcdWrcmd(LCD_CMD_RGBSET);   //LUT write
+  lcdWrdataBurst((const tU8*)pPalette, LCD_PALETTE_SIZE);
+
+  //deselect controller
+  selectLCD(FALSE);
+
+  current = *pPalette;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the palette last written to the controller.
+ *
+ ****************************************************************************/
+void
+lcdPaletteGet(tLcdPalette* pPalette)
+{
+  *pPalette = current;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Interpolate between two palettes.
+ *
+ * Params:
+ *    [in]  step  - 0 gives pFrom, steps gives pTo
+ *    [in]  steps - number of steps (> 0)
+ *    [out] pOut  - resulting palette
+ *
+ ****************************************************************************/
+void
+lcdPaletteMix(const tLcdPalette* pFrom, const tLcdPalette* pTo, tU8 step, tU8 steps, tLcdPalette* pOut)
+{
+  const tU8* pF = (const tU8*)pFrom;
+  const tU8* pT = (const tU8*)pTo;
+  tU8*       pO = (tU8*)pOut;
+  tU8 i;
+
+  for(i=0; i<LCD_PALETTE_SIZE; i++)
+    pO[i] = pF[i] + ((tS32)pT[i] - pF[i]) * step / steps;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Fade from one palette to another. Blocks the calling process
+ *    for steps * delay ticks.
+ *
+ * Params:
+ *    [in] steps - number of palettes written (last one is pTo)
+ *    [in] delay - ticks between palettes
+ *
+ ****************************************************************************/
+void
+lcdPaletteFade(const tLcdPalette* pFrom, const tLcdPalette* pTo, tU8 steps, tU8 delay)
+{
+  tLcdPalette palette;
+  tU8 step;
+
+  for(step=1; step<=steps; step++)
+  {
+    lcdPaletteMix(pFrom, pTo, step, steps, &palette);
+    lcdPaletteSet(&palette);
+    if (step < steps)
+      osSleep(delay);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Fade from the current palette to pFlash and back again.
+ *
+ ****************************************************************************/
+void
+lcdPaletteFlash(const tLcdPalette* pFlash, tU8 steps, tU8 delay)
+{
+  tLcdPalette original = current;
+
+  lcdPaletteFade(&original, pFlash, steps, delay);
+  osSleep(delay);
+  lcdPaletteFade(pFlash, &original, steps, delay);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the entries of one channel.
+ *
+ ****************************************************************************/
+static tU8*
+channelEntries(tLcdPalette* pPalette, tU8 channel, tU8* pCount)
+{
+  if (channel == LCD_PALETTE_RED)
+  {
+    *pCount = sizeof(pPalette->red);
+    return pPalette->red;
+  }
+  else if (channel == LCD_PALETTE_GREEN)
+  {
+    *pCount = sizeof(pPalette->green);
+    return pPalette->green;
+  }
+
+  *pCount = sizeof(pPalette->blue);
+  return pPalette->blue;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Set all entries of one channel to a linear ramp.
+ *
+ * Params:
+ *    [in] first - intensity (0-15) of the first entry
+ *    [in] last  - intensity (0-15) of the last entry
+ *
+ ****************************************************************************/
+void
+lcdPaletteRamp(tLcdPalette* pPalette, tU8 channel, tU8 first, tU8 last)
+{
+  tU8* pEntry;
+  tU8  count;
+  tU8  i;
+
+  pEntry = channelEntries(pPalette, channel, &count);
+  for(i=0; i<count; i++)
+    pEntry[i] = first + ((tS32)last - first) * i / (count - 1);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Rotate the entries of one channel one step (color cycling).
+ *
+ ****************************************************************************/
+void
+lcdPaletteRotate(tLcdPalette* pPalette, tU8 channel)
+{
+  tU8* pEntry;
+  tU8  count;
+  tU8  i;
+  tU8  first;
+
+  pEntry = channelEntries(pPalette, channel, &count);
+  first  = pEntry[0];
+  for(i=0; i<count-1; i++)
+    pEntry[i] = pEntry[i+1];
+  pEntry[count-1] = first;
+}
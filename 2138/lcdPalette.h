@@ -0,0 +1,52 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdPalette.h
+ *
+ * Description:
+ *    Expose palette (RGBSET lookup table) routines for the LCD.
+ *
+ *****************************************************************************/
+#ifndef _LCD_PALETTE_H_
+#define _LCD_PALETTE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LCD_PALETTE_RED    0
+#define LCD_PALETTE_GREEN  1
+#define LCD_PALETTE_BLUE   2
+
+#define LCD_PALETTE_SIZE   20     //8 red, 8 green and 4 blue entries
+
+//4-bit intensity for each value of the RRRGGGBB color bits
+typedef struct
+{
+  tU8 red[8];
+  tU8 green[8];
+  tU8 blue[4];
+} tLcdPalette;
+
+extern const tLcdPalette lcdPaletteNormal;
+extern const tLcdPalette lcdPaletteBlack;
+extern const tLcdPalette lcdPaletteWhite;
+
+
+void lcdPaletteSet(const tLcdPalette* pPalette);
+void lcdPaletteGet(tLcdPalette* pPalette);
+void lcdPaletteMix(const tLcdPalette* pFrom, const tLcdPalette* pTo, tU8 step, tU8 steps, tLcdPalette* pOut);
+void lcdPaletteFade(const tLcdPalette* pFrom, const tLcdPalette* pTo, tU8 steps, tU8 delay);
+void lcdPaletteFlash(const tLcdPalette* pFlash, tU8 steps, tU8 delay);
+void lcdPaletteRamp(tLcdPalette* pPalette, tU8 channel, tU8 first, tU8 last);
+void lcdPaletteRotate(tLcdPalette* pPalette, tU8 channel);
+
+#endif
@@ -26,18 +26,19 @@
 #include "snake.h"
 #include "pong.h"
 #include "bt.h"
+#include "term.h"
 #include "hw.h"
 #include "chess/chess.h"
 #include "startupDisplay.h"
 #include "Arrow.h"
 #include "Reflexes.h"
-#include "fire_0_100x40c.h"
-#include "fire_1_100x40c.h"
-#include "fire_2_100x40c.h"
-#include "fire_3_100x40c.h"
-#include "fire_4_100x40c.h"
-#include "fire_5_100x40c.h"
-#include "fire_6_100x40c.h"
+#include "ui.h"
+#include "replay.h"
+#include "prof.h"
+#ifdef MENU_FIRE
+#include "anim.h"
+#include "fire_100x40a.h"
+#endif
 
 /******************************************************************************
  * Typedefs and defines
@@ -45,6 +46,8 @@
 #define PROC1_STACK_SIZE 800
 #define INIT_STACK_SIZE  600
 
+#define FIRE_PERIOD_MS   100
+
 
 /*****************************************************************************
  * Global variables
@@ -60,7 +63,23 @@ static tU8 initStack[INIT_STACK_SIZE];
 static tU8 pid1;
 
 static tU8 contrast = 56;
-static tU8 cursor   = 0;
+
+static tUiWidget menuBorder;
+static tUiWidget menuPanel;
+static tUiWidget menuList;
+static const char* menuItems[] =
+{
+  "Play Example",
+  "InitApp",
+  "Play R",
+  "Play U",
+  "D",
+  "BT terminal"
+};
+
+#ifdef MENU_FIRE
+static tAnim fire;
+#endif
 
 
 /*****************************************************************************
@@ -97,35 +116,18 @@ main(void)
 /*****************************************************************************
  *
  * Description:
- *    Draw cursor in main menu
- *
- * Params:
- *    [in] cursor - Cursor position
+ *    Create the widgets of the main menu
  *
  ****************************************************************************/
 static void
-drawMenuCursor(tU8 cursor)
+initMenu(void)
 {
-  tU32 row;
-
-  for(row=0; row<5; row++)
-  {
-    lcdGotoxy(18,20+(14*row));
-    if(row == cursor)
-      lcdColor(0x00,0xe0);
-    else
-      lcdColor(0x00,0xfd);
-
-    switch(row)
-    {
-      case 0: lcdPuts("Play Example"); break;
-      case 1: lcdPuts("InitApp"); break;
-      case 2: lcdPuts("Play R"); break;
-      case 3: lcdPuts("Play U"); break;
-      case 4: lcdPuts("D"); break;
-      default: break;
-    }
-  }
+  uiFrame(&menuBorder, 14, 0, 102, 128, 0x6d);
+  uiFrameHeader(&menuBorder, "MENU", 34, 1, 0);
+  uiFrame(&menuPanel, 15, 17, 100, 110, 0);
+  uiList(&menuList, 18, 20, 12, menuItems, 6, 0x00, 0xfd, 0x00, 0xe0);
+  uiAdd(&menuBorder, &menuPanel);
+  uiAdd(&menuPanel, &menuList);
 }
 
 
@@ -141,13 +143,12 @@ drawMenu(void)
   lcdColor(0,0);
   lcdClrscr();
 
-  lcdRect(14, 0, 102, 128, 0x6d);
-  lcdRect(15, 17, 100, 110, 0);
+  uiInvalidateAll(&menuBorder);
+  uiDraw(&menuBorder);
 
-  lcdGotoxy(48,1);
-  lcdColor(0x6d,0);
-  lcdPuts("MENU");
-  drawMenuCursor(cursor);
+#ifdef MENU_FIRE
+  animStart(&fire, 15, 88, _fire_100x40a, FIRE_PERIOD_MS);
+#endif
 }
 
 
@@ -191,49 +192,50 @@ proc1(void* arg)
   displayStartupSequence();
 
   //print menu
+  initMenu();
   drawMenu();
 
   for(;;)
   {
     tU8 anyKey;
-    //static tU8 i = 0;
 
-    anyKey = checkKey();
+#ifdef MENU_FIRE
+    //the fire is animated every tick
+    anyKey = waitKey(1);
+#else
+    anyKey = waitKey(0);
+#endif
     if (anyKey != KEY_NOTHING)
     {
       //select specific function
       if (anyKey == KEY_CENTER)
       {
-        switch(cursor)
+        switch(menuList.cursor)
         {
           case 0: playSnake(); break;
           case 1: initApp(); break;
           case 2: getRightArrow(); break;
           case 3: getUpArrow(); break;
           case 4: getDownArrow(); break;
+          case 5: btTerminal(); break;
           default: break;
         }
+        REPLAY_END();
         drawMenu();
       }
 
       //move cursor up
       else if (anyKey == KEY_UP)
       {
-        if (cursor > 0)
-          cursor--;
-        else
-          cursor = 4;
-        drawMenuCursor(cursor);
+        uiListMove(&menuList, -1);
+        uiDraw(&menuList);
       }
 
       //move cursor down
       else if (anyKey == KEY_DOWN)
       {
-        if (cursor < 4)
-          cursor++;
-        else
-          cursor = 0;
-        drawMenuCursor(cursor);
+        uiListMove(&menuList, 1);
+        uiDraw(&menuList);
       }
 
       //adjust contrast
@@ -251,21 +253,10 @@ proc1(void* arg)
         lcdContrast(contrast);
       }
     }
-    /*
-    switch(i)
-    {
-      case 0: lcdIcon(15, 88, 100, 40, _fire_0_100x40c[2], _fire_0_100x40c[3], &_fire_0_100x40c[4]); i++; break;
-      case 1: lcdIcon(15, 88, 100, 40, _fire_1_100x40c[2], _fire_1_100x40c[3], &_fire_1_100x40c[4]); i++; break;
-      case 2: lcdIcon(15, 88, 100, 40, _fire_2_100x40c[2], _fire_2_100x40c[3], &_fire_2_100x40c[4]); i++; break;
-      case 3: lcdIcon(15, 88, 100, 40, _fire_3_100x40c[2], _fire_3_100x40c[3], &_fire_3_100x40c[4]); i++; break;
-      case 4: lcdIcon(15, 88, 100, 40, _fire_4_100x40c[2], _fire_4_100x40c[3], &_fire_4_100x40c[4]); i++; break;
-      case 5: lcdIcon(15, 88, 100, 40, _fire_5_100x40c[2], _fire_5_100x40c[3], &_fire_5_100x40c[4]); i++; break;
-      case 6: lcdIcon(15, 88, 100, 40, _fire_6_100x40c[2], _fire_6_100x40c[3], &_fire_6_100x40c[4]); i = 0; break;
-      default: i = 0; break;
-    }
-    //*/
-
-    osSleep(20);
+#ifdef MENU_FIRE
+    //only the changed rectangles of the next fire frame are drawn
+    animUpdate(&fire);
+#endif
   }
 }
 
@@ -285,6 +276,7 @@ initProc(void* arg)
   tU8 error;
 
   eaInit();
+  initTimebase();
   printf("\n*********************************************************");
   printf("\n*                                                       *");
   printf("\n* Welcome to Embedded Artists' summer promotion board;  *");
@@ -304,10 +296,15 @@ initProc(void* arg)
   printf("\n*                                                       *");
   printf("\n*********************************************************\n");
 
+  termInit();
   osCreateProcess(proc1, proc1Stack, PROC1_STACK_SIZE, &pid1, 3, NULL, &error);
   osStartProcess(pid1, &error);
 
+  initKeyProc();
   initBtProc();
+
+  //serve the console commands of the timing probes (does not return)
+  PROF_CONSOLE();
 
   osDeleteProcess();
 }
@@ -328,9 +325,6 @@ void
 appTick(tU32 elapsedTime)
 {
   ms += elapsedTime;
-
-  if((ms % 50) == 0)
-    sampleKey();
 }
 
 
@@ -0,0 +1,215 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    perf.c
+ *
+ * Description:
+ *    Performance counters and their on-screen readout (see perf.h).
+ *
+ *    The counters are incremented where the work is done: LCD words in
+ *    hw.c and by the display list ISR, I2C transfers in pca9532() and
+ *    UART #1 bytes in the UART ISR. A game calls PERF_FRAME() once per
+ *    frame; the readout is computed and queued there once per second,
+ *    with a fixed window width so that a shorter text needs no clearing.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "perf.h"
+#include "key.h"
+#include "lcdList.h"
+#include "font_5x8p.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define PERF_CHORD    (KEY_CENTER | KEY_UP)
+#define PERF_X        0
+#define PERF_Y        0
+#define PERF_WIDTH    80     //fixed window width of a line
+#define PERF_BKG      0x00
+#define PERF_COLOR    0x1c
+
+
+/*****************************************************************************
+ * Public variables
+ ****************************************************************************/
+volatile tU32 perfLcdWords;
+volatile tU32 perfI2cCount;
+volatile tU32 perfUart1Bytes;
+
+
+/*****************************************************************************
+ * External variables
+ ****************************************************************************/
+extern volatile tU32 ms;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static volatile tBool hudOn     = FALSE;    //toggled by the key sampling
+static tBool          chordHeld = FALSE;
+static tBool          measuring = FALSE;
+
+static tU32 windowStart;     //ms at the start of the current second
+static tU32 lastFrame;
+static tU32 frames;
+static tU32 worstMs;
+static tU32 lcdWordsStart;
+static tU32 i2cStart;
+static tU32 uart1Start;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Append a number (at most max) to a string.
+ *
+ * Returns:
+ *    Pointer after the last digit.
+ *
+ ****************************************************************************/
+static char*
+putNumber(char* p, tU32 value, tU32 max)
+{
+  char  digits[10];
+  tU8   n = 0;
+
+  if (value > max)
+    value = max;
+  do
+  {
+    digits[n++] = '0' + value % 10;
+    value /= 10;
+  } while(value > 0);
+
+  while(n > 0)
+    *p++ = digits[--n];
+  return p;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue one line of the readout as one text run.
+ *
+ ****************************************************************************/
+static void
+drawLine(tU8 y, const char* pText, char* pEnd)
+{
+  lcdListFont(PERF_X, y, PERF_WIDTH, PERF_BKG, PERF_COLOR, _font_5x8p,
+              (const tU8*)pText, pEnd - pText);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start a new second of measurements.
+ *
+ ****************************************************************************/
+static void
+startWindow(tU32 now)
+{
+  windowStart   = now;
+  frames        = 0;
+  worstMs       = 0;
+  lcdWordsStart = perfLcdWords;
+  i2cStart      = perfI2cCount;
+  uart1Start    = perfUart1Bytes;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Mark the end of a frame. Once per second the readout is drawn, if
+ *    it is switched on.
+ *
+ ****************************************************************************/
+void
+perfFrame(void)
+{
+  tU32 now = ms;
+  tU32 elapsed;
+  char line[LCD_TEXT_RUN];
+  char* p;
+
+  if (hudOn == FALSE)
+  {
+    measuring = FALSE;
+    return;
+  }
+
+  if (measuring == FALSE)
+  {
+    measuring = TRUE;
+    lastFrame = now;
+    startWindow(now);
+    return;
+  }
+
+  frames++;
+  if (now - lastFrame > worstMs)
+    worstMs = now - lastFrame;
+  lastFrame = now;
+
+  elapsed = now - windowStart;
+  if (elapsed < 1000)
+    return;
+
+  p = putNumber(line, frames * 1000 / elapsed, 99);
+  *p++ = 'f'; *p++ = 'p'; *p++ = 's'; *p++ = ' ';
+  *p++ = 'm'; *p++ = 'a'; *p++ = 'x';
+  p = putNumber(p, worstMs, 9999);
+  *p++ = 'm'; *p++ = 's';
+  drawLine(PERF_Y, line, p);
+
+  p = line;
+  *p++ = 'B';
+  p = putNumber(p, (perfLcdWords - lcdWordsStart) / frames, 9999);
+  *p++ = ' '; *p++ = 'I';
+  p = putNumber(p, (perfI2cCount - i2cStart) * 1000 / elapsed, 99);
+  *p++ = ' '; *p++ = 'U';
+  p = putNumber(p, (perfUart1Bytes - uart1Start) * 1000 / elapsed, 99999);
+  drawLine(PERF_Y + 8, line, p);
+
+  startWindow(now);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check the sampled keys for the readout chord (CENTER and UP held),
+ *    which toggles the readout. Called by the key sampling.
+ *
+ * Returns:
+ *    TRUE while the chord is held, the keys are not passed on then.
+ *
+ ****************************************************************************/
+tBool
+perfKeys(tU8 keys)
+{
+  if ((keys & PERF_CHORD) != PERF_CHORD)
+  {
+    chordHeld = FALSE;
+    return FALSE;
+  }
+
+  if (chordHeld == FALSE)
+  {
+    chordHeld = TRUE;
+    hudOn     = !hudOn;
+  }
+  return TRUE;
+}
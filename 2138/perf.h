@@ -0,0 +1,57 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    perf.h
+ *
+ * Description:
+ *    Expose the performance counters and the on-screen readout (build
+ *    with PERF_HUD). Without PERF_HUD all counter macros are empty.
+ *
+ *    The readout is switched on and off by holding CENTER and UP. It is
+ *    drawn once per second in the upper left corner, as two text runs of
+ *    one window each:
+ *      <frames per second>fps max<worst frame time>ms
+ *      B<LCD words per frame> I<I2C transfers/s> U<UART #1 bytes/s>
+ *
+ *****************************************************************************/
+#ifndef _PERF_H_
+#define _PERF_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#ifdef PERF_HUD
+
+extern volatile tU32 perfLcdWords;
+extern volatile tU32 perfI2cCount;
+extern volatile tU32 perfUart1Bytes;
+
+#define PERF_LCD_WORDS(count)   (perfLcdWords += (count))
+#define PERF_I2C()              (perfI2cCount++)
+#define PERF_UART1_BYTE()       (perfUart1Bytes++)
+#define PERF_FRAME()            perfFrame()
+#define PERF_KEYS(keys)         perfKeys(keys)
+
+void  perfFrame(void);
+tBool perfKeys(tU8 keys);
+
+#else
+
+#define PERF_LCD_WORDS(count)
+#define PERF_I2C()
+#define PERF_UART1_BYTE()
+#define PERF_FRAME()
+#define PERF_KEYS(keys)         FALSE
+
+#endif
+
+#endif
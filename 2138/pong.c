@@ -14,6 +14,7 @@
 #include "../pre_emptive_os/api/osapi.h"
 #include "../pre_emptive_os/api/general.h"
 #include "lcd.h"
+#include "lcdPalette.h"
 #include "key.h"
 #include "bt.h"
 #include "math.h"
@@ -23,6 +24,11 @@
 #include <string.h>
 #include <stdlib.h>
 #include "uart.h"
+#include "lcdCapture.h"
+#include "font_8x14p.h"
+#include "perf.h"
+#include "replay.h"
+#include "prof.h"
 
 
 /******************************************************************************
@@ -193,14 +199,15 @@ paintScore(void)
   scoreStr[2] = player1.score%10      + '0';
   scoreStr[3] = '\0';  
 
+  // proportional digits, the old score may be wider
+  lcdRect(0, 0, SCREEN_WIDTH, 14, BACKGROUND_COLOR);
+
   lcdColor(BACKGROUND_COLOR, player1.color); 
-  lcdGotoxy(1,0);
-  lcdPuts(scoreStr);
+  lcdText(1, 0, _font_8x14p, (char*)scoreStr);
 
   // name of the game
   lcdColor(BACKGROUND_COLOR, COLOR_BLUE); 
-  lcdGotoxy(46, 0);
-  lcdPuts("Pong");
+  lcdText((SCREEN_WIDTH - lcdTextWidth(_font_8x14p, "Pong")) / 2, 0, _font_8x14p, "Pong");
 
 
   // right player
@@ -210,8 +217,7 @@ paintScore(void)
   scoreStr[3] = '\0';  
 
   lcdColor(BACKGROUND_COLOR, player2.color); 
-  lcdGotoxy(102,0);
-  lcdPuts(scoreStr);
+  lcdText(SCREEN_WIDTH - 1 - lcdTextWidth(_font_8x14p, (char*)scoreStr), 0, _font_8x14p, (char*)scoreStr);
 }
 
 
@@ -225,6 +231,7 @@ static void
 paintGame(void)
 {
   //clear screen
+  LCD_CAPTURE_BEGIN("pong");
   lcdColor(BACKGROUND_COLOR, DEFAULT_TEXT_COLOR);
   lcdClrscr();
 
@@ -235,6 +242,7 @@ paintGame(void)
   // paint players
   paintPlayer(&player1);
   paintPlayer(&player2);
+  LCD_CAPTURE_STOP();
 }
 
 
@@ -310,6 +318,7 @@ moveBall(tU8 key)
 
   if (lastMove + BALL_MOVE_TIME > ms)
     return;
+  PROF_BEGIN(PROF_MOVE_BALL);
 
   // erase last position
   lcdRect((tU8)round(ball.xPos), (tU8)round(ball.yPos), ball.size, ball.size, BACKGROUND_COLOR);
@@ -409,6 +418,9 @@ moveBall(tU8 key)
   }
 
   lastMove = ms;
+  PROF_END(PROF_MOVE_BALL);
+  PERF_FRAME();
+  REPLAY_FRAME();
 }
 
 
@@ -595,7 +607,7 @@ playPong(void)
       connected = FALSE;
       while (connected == FALSE)
       {
-        key = checkKey();
+        key = waitKey(1);
 
         if (TRUE == checkIfClinetConnected(btAddress))
         {
@@ -656,7 +668,6 @@ playPong(void)
           default: break;
           }
           cnt++;
-          osSleep(1);
         }
       }
     }
@@ -664,6 +675,9 @@ playPong(void)
   default: break;
   }
 
+  //an armed recording or replay starts with the game, there is no seed
+  REPLAY_START();
+
   while (done == FALSE)
   {
     player1.score = 0;
@@ -736,6 +750,14 @@ playPong(void)
 
         gameOver = TRUE;
 
+        //flash the screen red
+        {
+          tLcdPalette flash = lcdPaletteNormal;
+
+          lcdPaletteRamp(&flash, LCD_PALETTE_RED, 15, 15);
+          lcdPaletteFlash(&flash, 4, 1);
+        }
+
         menu.xPos = 10;
         menu.yPos = 40;
         menu.xLen = 6+(12*8);
@@ -759,6 +781,9 @@ playPong(void)
         default: break;
         }
       }
+
+      //the key process runs at the lowest priority, let it sample
+      osSleep(1);
     }
   }
   
@@ -1333,7 +1358,7 @@ searchServers(tU8 *pBtAddr)
   drawBtsFound(cursorPos);
   while(done == FALSE)
   {
-    anyKey = checkKey();
+    anyKey = waitKey(0);
     if (anyKey != KEY_NOTHING)
     {
       //exit and save new name
@@ -1362,7 +1387,6 @@ searchServers(tU8 *pBtAddr)
           drawBtsFound(cursorPos);
       }
     }
-    osSleep(1);
   }
   
   if (foundBtUnits[cursorPos].active == TRUE)
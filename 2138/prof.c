@@ -0,0 +1,148 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    prof.c
+ *
+ * Description:
+ *    Timing probes and their console listing (see prof.h).
+ *
+ *    A probe keeps the start of the current run and the sums of the
+ *    finished ones; the mean is computed when the probes are listed. The
+ *    durations are microseconds of the TIMER1 timebase, so a run may be
+ *    as long as about 71 minutes.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include <printf_P.h>
+#include "prof.h"
+#include "hw.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define PROF_POLL_TICKS  10     //console polled every 100 ms
+
+typedef struct
+{
+  tU32 start;               //nowUs() at PROF_BEGIN()
+  tU32 count;
+  tU32 sumUs;
+  tU32 minUs;
+  tU32 maxUs;
+} tProbe;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tProbe probes[PROF_PROBES];
+
+static const char* const probeNames[PROF_PROBES] =
+{
+  "lcdIcon bus",
+  "moveBall"
+};
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start a run of a probe.
+ *
+ ****************************************************************************/
+void
+profBegin(tU8 id)
+{
+  probes[id].start = nowUs();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    End a run of a probe and add its duration.
+ *
+ ****************************************************************************/
+void
+profEnd(tU8 id)
+{
+  tProbe* pProbe = &probes[id];
+  tU32    us     = nowUs() - pProbe->start;
+
+  if (pProbe->count == 0 || us < pProbe->minUs)
+    pProbe->minUs = us;
+  if (us > pProbe->maxUs)
+    pProbe->maxUs = us;
+  pProbe->sumUs += us;
+  pProbe->count++;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    List the probes on the console: count, then minimum, mean and
+ *    maximum duration in microseconds.
+ *
+ ****************************************************************************/
+void
+profDump(void)
+{
+  tU8 i;
+
+  printf("\nprobe: count min mean max (us)");
+  for(i=0; i<PROF_PROBES; i++)
+  {
+    tProbe* pProbe = &probes[i];
+
+    printf("\n%s: %u", probeNames[i], pProbe->count);
+    if (pProbe->count > 0)
+      printf(" %u %u %u", pProbe->minUs, pProbe->sumUs / pProbe->count,
+             pProbe->maxUs);
+  }
+  printf("\n");
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Serve the console commands of the probes, 'p' lists and 'r' resets
+ *    them. Does not return; called by the initialization process when it
+ *    has started the others.
+ *
+ ****************************************************************************/
+void
+profConsole(void)
+{
+  char cmd;
+  tU8  i;
+
+  for(;;)
+  {
+    while(consolGetChar(&cmd) == TRUE)
+    {
+      if (cmd == 'p')
+        profDump();
+      else if (cmd == 'r')
+      {
+        for(i=0; i<PROF_PROBES; i++)
+        {
+          probes[i].count = 0;
+          probes[i].sumUs = 0;
+          probes[i].maxUs = 0;
+        }
+      }
+    }
+    osSleep(PROF_POLL_TICKS);
+  }
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    prof.h
+ *
+ * Description:
+ *    Expose the timing probes (build with PROFILE). Without PROFILE the
+ *    probe macros are empty.
+ *
+ *    PROF_BEGIN(id) and PROF_END(id) around a piece of code add its
+ *    duration (nowUs() of hw.h) to the probe: count, minimum, maximum and
+ *    mean. A probe must not be entered again before it has ended, by the
+ *    same or by another process. Sending 'p' to the console (UART #0)
+ *    lists the probes, 'r' resets them.
+ *
+ *****************************************************************************/
+#ifndef _PROF_H_
+#define _PROF_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define PROF_LCD_ICON   0     //bitmap entry of the display list, sent by the ISR
+#define PROF_MOVE_BALL  1     //moveBall() of Pong, when the ball moves
+#define PROF_PROBES     2
+
+#ifdef PROFILE
+
+#define PROF_BEGIN(id)          profBegin(id)
+#define PROF_END(id)            profEnd(id)
+#define PROF_CONSOLE()          profConsole()
+#define PROF_DUMP()             profDump()
+
+void profBegin(tU8 id);
+void profEnd(tU8 id);
+void profConsole(void);
+void profDump(void);
+
+#else
+
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+#define PROF_CONSOLE()
+#define PROF_DUMP()
+
+#endif
+
+#endif
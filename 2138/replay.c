@@ -0,0 +1,409 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    replay.c
+ *
+ * Description:
+ *    Recording and replay of game sessions (see replay.h).
+ *
+ *    The key process records the events it queues while a session is
+ *    recorded, and asks for the recorded events every tick while one is
+ *    replayed; the game process starts the session (or seeds rand()),
+ *    counts frames and ends the session. The session is kept in RAM in the layout it has in the
+ *    EEPROM, and is written in pages of the 24C16.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include <printf_P.h>
+#include "replay.h"
+#include "key.h"
+#include "eeprom.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define REPLAY_CHORD_RECORD (KEY_CENTER | KEY_DOWN)
+#define REPLAY_CHORD_PLAY   (KEY_CENTER | KEY_LEFT)
+
+#define REPLAY_TICK_MS      10      //ms per OS tick (appTick)
+#define REPLAY_EVENTS       256
+#define REPLAY_SEEDS        8
+#define REPLAY_FRAMES       256     //frame times kept for the listing
+#define REPLAY_MAGIC        0x5250
+#define REPLAY_EEPROM_ADDR  0x0000
+#define REPLAY_EEPROM_PAGE  16
+
+#define STATE_IDLE          0
+#define STATE_ARM_RECORD    1
+#define STATE_ARM_PLAY      2
+#define STATE_RECORD        3
+#define STATE_PLAY          4
+
+typedef struct
+{
+  tU16 tick;                //ticks since the start of the session
+  tU8  event;               //KEY_EVENT_ type << 5 | KEY_ bit
+  tU8  held;                //all keys held
+} tReplayEvent;
+
+typedef struct
+{
+  tU16 magic;
+  tU16 events;
+  tU16 seeds;
+  tU16 duration;            //ticks from the start to the end
+  tU32 seed[REPLAY_SEEDS];
+  tReplayEvent event[REPLAY_EVENTS];
+} tReplaySession;
+
+
+/*****************************************************************************
+ * External variables
+ ****************************************************************************/
+extern volatile tU32 ms;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static volatile tU8 state = STATE_IDLE;
+static tBool        chordHeld = FALSE;
+
+static tReplaySession session;
+static tU32 startMs;
+static tU16 nextEvent;
+static tU16 nextSeed;
+
+static tU16 frameMs[REPLAY_FRAMES];
+static tU32 frames;
+static tU32 lastFrame;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Start the key queue, the time base and the frame count of a session.
+ *
+ ****************************************************************************/
+static void
+startSession(tU8 newState)
+{
+  tKeyEvent event;
+
+  //the keys of the menu are not part of the session
+  while(getKeyEvent(&event) == TRUE)
+    ;
+
+  startMs   = ms;
+  lastFrame = startMs;
+  frames    = 0;
+  state     = newState;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write the session to the EEPROM, page by page.
+ *
+ ****************************************************************************/
+static tBool
+storeSession(void)
+{
+  tU8* pData = (tU8*)&session;
+  tU16 size  = sizeof(session);
+  tU16 offset;
+  tU16 len;
+
+  for(offset=0; offset<size; offset+=len)
+  {
+    len = REPLAY_EEPROM_PAGE;
+    if (len > size - offset)
+      len = size - offset;
+    if (eepromWrite(REPLAY_EEPROM_ADDR + offset, pData + offset, len) != I2C_CODE_OK)
+      return FALSE;
+    eepromPoll();
+  }
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read the session from the EEPROM.
+ *
+ * Returns:
+ *    TRUE if the EEPROM holds a session.
+ *
+ ****************************************************************************/
+static tBool
+loadSession(void)
+{
+  if (eepromPageRead(REPLAY_EEPROM_ADDR, (tU8*)&session, sizeof(session)) != I2C_CODE_OK)
+    return FALSE;
+  return session.magic == REPLAY_MAGIC &&
+         session.events <= REPLAY_EVENTS && session.seeds <= REPLAY_SEEDS;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    List the recorded session on the console: the seeds, then one event
+ *    per line (tick, type, key and held keys).
+ *
+ ****************************************************************************/
+static void
+listSession(void)
+{
+  tU16 i;
+
+  printf("\nreplay: %u ticks, %u seeds, %u events",
+         session.duration, session.seeds, session.events);
+  for(i=0; i<session.seeds; i++)
+    printf("\nseed %u", session.seed[i]);
+  for(i=0; i<session.events; i++)
+    printf("\n%u %u %x %x", session.event[i].tick, session.event[i].event >> 5,
+           session.event[i].event & KEY_ALL, session.event[i].held);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    List the frame count and the frame times (ms) on the console.
+ *
+ ****************************************************************************/
+static void
+listFrames(tU32 duration)
+{
+  tU32 i;
+
+  printf("\nreplay: %u frames in %u ms", frames, duration);
+  for(i=0; i<frames && i<REPLAY_FRAMES; i++)
+  {
+    if ((i % 16) == 0)
+      printf("\nframe ms:");
+    printf(" %u", frameMs[i]);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Called when a game starts, by games that do not seed rand(). An
+ *    armed session starts here.
+ *
+ ****************************************************************************/
+void
+replayStart(void)
+{
+  if (state == STATE_ARM_RECORD)
+  {
+    printf("\nreplay: recording");
+    session.events = 0;
+    session.seeds  = 0;
+    startSession(STATE_RECORD);
+  }
+  else if (state == STATE_ARM_PLAY)
+  {
+    if (loadSession() == FALSE)
+    {
+      printf("\nreplay: no session in the EEPROM");
+      state = STATE_IDLE;
+      return;
+    }
+    printf("\nreplay: playing %u events", session.events);
+    nextEvent = 0;
+    nextSeed  = 0;
+    startSession(STATE_PLAY);
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Called with the seed of rand() when a game starts. An armed session
+ *    starts here; a recorded seed replaces the seed during a replay.
+ *
+ * Returns:
+ *    The seed to use.
+ *
+ ****************************************************************************/
+tU32
+replaySeed(tU32 seed)
+{
+  replayStart();
+
+  if (state == STATE_RECORD && session.seeds < REPLAY_SEEDS)
+    session.seed[session.seeds++] = seed;
+  else if (state == STATE_PLAY && nextSeed < session.seeds)
+    seed = session.seed[nextSeed++];
+  return seed;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Record a key event. Called by the key process for every event it
+ *    queues; events after a full session are lost.
+ *
+ ****************************************************************************/
+void
+replayRecord(tU8 type, tU8 key, tU8 held)
+{
+  tReplayEvent* pEvent;
+
+  if (state != STATE_RECORD || session.events >= REPLAY_EVENTS)
+    return;
+
+  pEvent = &session.event[session.events++];
+  pEvent->tick  = (ms - startMs) / REPLAY_TICK_MS;
+  pEvent->event = (type << 5) | key;
+  pEvent->held  = held;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check if a session is replayed. The key process then takes the
+ *    events from replayNext() every tick, instead of sampling the keys.
+ *
+ ****************************************************************************/
+tBool
+replayPlaying(void)
+{
+  return state == STATE_PLAY;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the next recorded event, if its tick has come.
+ *
+ * Returns:
+ *    TRUE if an event was returned.
+ *
+ ****************************************************************************/
+tBool
+replayNext(tKeyEvent* pEvent)
+{
+  tReplayEvent* pNext;
+
+  if (state != STATE_PLAY || nextEvent >= session.events)
+    return FALSE;
+
+  pNext = &session.event[nextEvent];
+  if ((ms - startMs) / REPLAY_TICK_MS < pNext->tick)
+    return FALSE;
+
+  pEvent->ms   = ms;
+  pEvent->type = pNext->event >> 5;
+  pEvent->key  = pNext->event & KEY_ALL;
+  pEvent->held = pNext->held;
+  nextEvent++;
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check the sampled keys for the chords that arm (or disarm) the
+ *    recording and the replay of the next game. Called by the key
+ *    sampling; during a session the keys are passed on.
+ *
+ * Returns:
+ *    TRUE while a chord is held, the keys are not passed on then.
+ *
+ ****************************************************************************/
+tBool
+replayKeys(tU8 keys)
+{
+  tU8 armed;
+
+  if (state == STATE_RECORD || state == STATE_PLAY)
+    return FALSE;
+
+  if ((keys & REPLAY_CHORD_RECORD) == REPLAY_CHORD_RECORD)
+    armed = STATE_ARM_RECORD;
+  else if ((keys & REPLAY_CHORD_PLAY) == REPLAY_CHORD_PLAY)
+    armed = STATE_ARM_PLAY;
+  else
+  {
+    chordHeld = FALSE;
+    return FALSE;
+  }
+
+  if (chordHeld == FALSE)
+  {
+    chordHeld = TRUE;
+    state     = (state == armed) ? STATE_IDLE : armed;
+  }
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Mark the end of a frame (next to PERF_FRAME()).
+ *
+ ****************************************************************************/
+void
+replayFrame(void)
+{
+  tU32 now = ms;
+
+  if (state != STATE_RECORD && state != STATE_PLAY)
+    return;
+
+  if (frames < REPLAY_FRAMES)
+    frameMs[frames] = now - lastFrame;
+  frames++;
+  lastFrame = now;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    End the session when the game returns to the main menu. A recorded
+ *    session is stored and listed; both list the frames.
+ *
+ ****************************************************************************/
+void
+replayEnd(void)
+{
+  tU8  ended = state;
+  tU32 duration = ms - startMs;
+
+  if (ended != STATE_RECORD && ended != STATE_PLAY)
+    return;
+  state = STATE_IDLE;
+
+  if (ended == STATE_RECORD)
+  {
+    session.magic    = REPLAY_MAGIC;
+    session.duration = duration / REPLAY_TICK_MS;
+    if (storeSession() == FALSE)
+      printf("\nreplay: EEPROM write failed");
+    listSession();
+  }
+  listFrames(duration);
+  printf("\n");
+}
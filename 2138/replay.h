@@ -0,0 +1,70 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    replay.h
+ *
+ * Description:
+ *    Expose the recording and replay of game sessions (build with
+ *    REPLAY). Without REPLAY the macros leave the keys and seeds alone.
+ *
+ *    Holding CENTER and DOWN arms the recording of the next game, CENTER
+ *    and LEFT arms its replay (again to disarm). A session starts when
+ *    the game seeds rand() or calls REPLAY_START(), and ends when it
+ *    returns to the main menu.
+ *    The key events are recorded with their time since the start, and
+ *    the seeds in order. At the end the session is stored in the EEPROM
+ *    and listed on the console; a replay reads it from the EEPROM and
+ *    feeds the events to the key queue at the recorded ticks instead of
+ *    the sampled keys. Both print the frame count and frame times.
+ *
+ *****************************************************************************/
+#ifndef _REPLAY_H_
+#define _REPLAY_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "key.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#ifdef REPLAY
+
+#define REPLAY_START()                replayStart()
+#define REPLAY_SEED(seed)             replaySeed(seed)
+#define REPLAY_RECORD(type,key,held)  replayRecord(type, key, held)
+#define REPLAY_PLAYING()              replayPlaying()
+#define REPLAY_NEXT(pEvent)           replayNext(pEvent)
+#define REPLAY_KEYS(keys)             replayKeys(keys)
+#define REPLAY_FRAME()                replayFrame()
+#define REPLAY_END()                  replayEnd()
+
+void  replayStart(void);
+tU32  replaySeed(tU32 seed);
+void  replayRecord(tU8 type, tU8 key, tU8 held);
+tBool replayPlaying(void);
+tBool replayNext(tKeyEvent* pEvent);
+tBool replayKeys(tU8 keys);
+void  replayFrame(void);
+void  replayEnd(void);
+
+#else
+
+#define REPLAY_START()
+#define REPLAY_SEED(seed)             (seed)
+#define REPLAY_RECORD(type,key,held)
+#define REPLAY_PLAYING()              FALSE
+#define REPLAY_NEXT(pEvent)           FALSE
+#define REPLAY_KEYS(keys)             FALSE
+#define REPLAY_FRAME()
+#define REPLAY_END()
+
+#endif
+
+#endif
@@ -22,41 +22,18 @@
 #include "lcd.h"
 #include "key.h"
 #include "select.h"
+#include "ui.h"
+#include "lcdCapture.h"
 
 
 /*****************************************************************************
  * Local variables
  ****************************************************************************/
-static tMenu menu;
-static tU8 cursor;
+static tUiWidget border;
+static tUiWidget panel;
+static tUiWidget list;
 
 
-/*****************************************************************************
- *
- * Description:
- *    Draw cursor in main menu
- *
- * Params:
- *    [in] cursor - Cursor positions
- *
- ****************************************************************************/
-static void
-drawMenuCursor(void)
-{
-  tU32 row;
-
-  for(row=0; row<menu.noOfChoices; row++)
-  {
-    lcdGotoxy(menu.xPos+4,menu.yPos+17+(14*row));
-    if(row == cursor)
-      lcdColor(menu.bgColor+1,menu.selectedColor);
-    else
-      lcdColor(menu.bgColor,menu.choicesColor);
-    
-    lcdPuts(menu.pChoice[row]);
-  }
-}
-
 /*****************************************************************************
  *
  * Description:
@@ -65,59 +42,76 @@ drawMenuCursor(void)
  ****************************************************************************/
 tU8
 drawMenu(tMenu newMenu)
+{
+  return drawMenuOver(newMenu, NULL, NULL);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Implements a menu as a dialog. A cursor move only redraws the old
+ *    and the new choice. When a choice is made, the area of the menu is
+ *    restored from the widgets under it and the restore function. If
+ *    both are NULL the menu is left on the screen.
+ *
+ * Params:
+ *    [in] newMenu  - menu
+ *    [in] pUnder   - widgets under the menu, may be NULL
+ *    [in] pRestore - repaints other content under the menu, may be NULL
+ *
+ * Returns:
+ *    The selected choice.
+ *
+ ****************************************************************************/
+tU8
+drawMenuOver(tMenu newMenu, tUiWidget* pUnder, tUiRestore pRestore)
 {
   tU8 anyKey;
+
+  //border with header text, background and choices
+  LCD_CAPTURE_BEGIN("menu");
+  uiFrame(&border, newMenu.xPos, newMenu.yPos, newMenu.xLen, newMenu.yLen, newMenu.borderColor);
+  uiFrameHeader(&border, (char*)newMenu.pHeaderText, newMenu.headerTextXpos - newMenu.xPos, 1,
+                newMenu.headerColor);
+  uiFrame(&panel, newMenu.xPos+1, newMenu.yPos+16, newMenu.xLen-2, newMenu.yLen-17, newMenu.bgColor);
+  uiList(&list, newMenu.xPos+4, newMenu.yPos+17, (newMenu.xLen-5) / 8,
+         (const char**)newMenu.pChoice, newMenu.noOfChoices,
+         newMenu.bgColor, newMenu.choicesColor, newMenu.bgColor+1, newMenu.selectedColor);
+  uiListSetCursor(&list, newMenu.initialChoice);
+  uiAdd(&border, &panel);
+  uiAdd(&panel, &list);
+  uiDraw(&border);
+  LCD_CAPTURE_STOP();
   
-  menu = newMenu;
-  
-  //draw boarder
-  lcdRect(menu.xPos, menu.yPos, menu.xLen, menu.yLen, menu.borderColor);
-  lcdRect(menu.xPos+1, menu.yPos+16, menu.xLen-2, menu.yLen-17, menu.bgColor);
-  
-  //write header text
-  lcdGotoxy(menu.headerTextXpos,menu.yPos+1);
-  lcdColor(menu.borderColor,menu.headerColor);
-  lcdPuts(menu.pHeaderText);
-  
-  //write choices
-  cursor = menu.initialChoice;
-  drawMenuCursor();
-  
-  //dummy call just to reset previous key strokes
-  checkKey();
+  //discard the key events queued before the menu was shown
+  keyFlush();
 
   while(1)
   {
-    anyKey = checkKey();
+    anyKey = waitKeyMask(KEY_CENTER | KEY_UP | KEY_DOWN, 0);
     
     if (anyKey != KEY_NOTHING)
     {
       //select specific function
       if (anyKey == KEY_CENTER)
       {
-        return cursor;
+        if (pUnder != NULL || pRestore != NULL)
+          uiDialogClose(&border, pUnder, pRestore);
+        return list.cursor;
       }
       
       else if (anyKey == KEY_UP)
       {
-        if (cursor > 0)
-          cursor--;
-        else
-          cursor = menu.noOfChoices - 1;
-        drawMenuCursor();
+        uiListMove(&list, -1);
+        uiDraw(&list);
       }
       
       else if (anyKey == KEY_DOWN)
       {
-        if (cursor < menu.noOfChoices - 1)
-          cursor++;
-        else
-          cursor = 0;
-        drawMenuCursor();
+        uiListMove(&list, 1);
+        uiDraw(&list);
       }
     }
-    else
-      osSleep(1);
   }
 }
-
@@ -17,6 +17,7 @@
  * Includes
  *****************************************************************************/
 #include "../pre_emptive_os/api/general.h"
+#include "ui.h"
 
 
 /******************************************************************************
@@ -41,5 +42,6 @@ typedef struct
 } tMenu;
 
 tU8 drawMenu(tMenu newMenu);
+tU8 drawMenuOver(tMenu newMenu, tUiWidget* pUnder, tUiRestore pRestore);
 
 #endif
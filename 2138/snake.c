@@ -20,8 +20,12 @@
 #include <ea_init.h>
 #include <stdlib.h>
 #include "lcd.h"
+#include "lcdPalette.h"
 #include "key.h"
 #include "select.h"
+#include "lcdCapture.h"
+#include "perf.h"
+#include "replay.h"
 
 
 /******************************************************************************
@@ -88,7 +92,7 @@ void playSnake(void)
     level     = 1;
     score     = 0;
     speed     = 14;
-    srand(ms);        //Ensure random seed initiated
+    srand(REPLAY_SEED(ms));  //Ensure random seed initiated
     setupLevel();
 
     //main loop
@@ -123,12 +127,13 @@ void playSnake(void)
       //display snake in yellow
       for (i=0; i<=snakeLength; i++)
         gotoxy(snake[i].col, snake[i].row, 0xfc);
+      PERF_FRAME();
+      REPLAY_FRAME();
 
       //if first press on each level, pause until a key is pressed
       if (firstPress == TRUE)
       {
-        while(KEY_NOTHING == checkKey())
-          ;
+        waitKey(0);
         firstPress = FALSE;
       }
 
@@ -180,6 +185,14 @@ void playSnake(void)
       high_score = score;
     showScore();
 
+    //flash the screen red
+    {
+      tLcdPalette flash = lcdPaletteNormal;
+
+      lcdPaletteRamp(&flash, LCD_PALETTE_RED, 15, 15);
+      lcdPaletteFlash(&flash, 4, 1);
+    }
+
     {
       tMenu menu;
         
@@ -222,6 +235,7 @@ void setupLevel()
   tS32 row, col, i;
 
   //clear screen
+  LCD_CAPTURE_BEGIN("snake");
   lcdColor(0,0xe0);
   lcdClrscr();
 
@@ -277,6 +291,7 @@ void setupLevel()
   }
 
   showScore();
+  LCD_CAPTURE_STOP();
 }
 
 
@@ -0,0 +1,602 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    sprite.c
+ *
+ * Description:
+ *    Sprite layer on top of lcd.c. A fixed pool of sprites with position,
+ *    z-order and an image in the normal image format (width, height,
+ *    compression flag, escape value, data). Pixels equal to the colour
+ *    key of a sprite are transparent.
+ *
+ *    The background must be known to the sprite layer (a color and an
+ *    optional image at 0,0, see sprBackground()). Every sprite has a
+ *    save-under buffer with the background under it, so that the old
+ *    position can be restored without decoding the background image.
+ *
+ *    sprMove()/sprImage()/sprShow() only change the sprite, sprUpdate()
+ *    draws all changes: for every changed sprite the union of the old
+ *    and new rectangle (or the two rectangles, if they are apart) is
+ *    composed in RAM - background, then all sprites in z-order - and
+ *    sent in one window.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "sprite.h"
+#include "lcd.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define SCREEN_SIZE 130
+
+typedef struct
+{
+  tU8 x;
+  tU8 y;
+  tU8 w;
+  tU8 h;
+} tRect;
+
+typedef struct
+{
+  const tU8* pImage;
+  tU8*  pSaveUnder;     //background under drawn rectangle
+  tU8   colorKey;
+  tU8   z;
+  tU8   x;
+  tU8   y;
+  tRect drawn;          //visible part of sprite on screen
+  tBool used;
+  tBool visible;
+  tBool onScreen;
+  tBool dirty;
+} tSprite;
+
+//RLE decoder state
+typedef struct
+{
+  const tU8* pData;
+  tU8 compressed;
+  tU8 escapeChar;
+  tU8 runLeft;
+  tU8 color;
+} tRle;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tSprite sprites[SPRITE_MAX];
+static tU8     order[SPRITE_MAX];       //sprite ids sorted on z
+static tU8     numSprites = 0;
+
+static tU8  scratch[SPRITE_SCRATCH];
+static tBool scratchPending = FALSE;    //referenced by display list
+
+//background, with decoder state at the start of every image row
+static tU8        bkgColor;
+static const tU8* pBkgImage;
+static tU16       bkgRowOffset[SCREEN_SIZE];
+static tU8        bkgRowRunLeft[SCREEN_SIZE];
+static tU8        bkgRowColor[SCREEN_SIZE];
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static tU8   rleNext(tRle* pRle);
+static void  bkgRow(tU8 x, tU8 y, tU8 w, tU8* pDst);
+static tBool clipSprite(tSprite* pSprite, tRect* pRect);
+static tBool intersect(const tRect* pA, const tRect* pB, tRect* pOut);
+static void  sortSprites(void);
+static void  blitSprite(tSprite* pSprite, const tRect* pRegion);
+static void  compose(tSprite* pOwner, const tRect* pRegion, tBool useOld, const tRect* pNew);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get next pixel from an (optionally compressed) image.
+ *
+ ****************************************************************************/
+static tU8
+rleNext(tRle* pRle)
+{
+  if (pRle->compressed == FALSE)
+    return *pRle->pData++;
+
+  while(pRle->runLeft == 0)
+  {
+    if (*pRle->pData == pRle->escapeChar)
+    {
+      pRle->runLeft = pRle->pData[1];
+      pRle->color   = pRle->pData[2];
+      pRle->pData  += 3;
+    }
+    else
+    {
+      pRle->runLeft = 1;
+      pRle->color   = *pRle->pData++;
+    }
+  }
+  pRle->runLeft--;
+  return pRle->color;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Reset the sprite pool. The background is a black screen.
+ *
+ ****************************************************************************/
+void
+sprInit(void)
+{
+  tU8 i;
+
+  for(i=0; i<SPRITE_MAX; i++)
+    sprites[i].used = FALSE;
+  numSprites = 0;
+
+  sprBackground(0x00, NULL);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Set the background that sprites are drawn on. The caller draws the
+ *    background itself; all sprites are drawn again at next sprUpdate().
+ *
+ * Params:
+ *    [in] color  - background color
+ *    [in] pImage - image at 0,0 (or NULL), color is used outside of it
+ *
+ ****************************************************************************/
+void
+sprBackground(tU8 color, const tU8* pImage)
+{
+  tU8  i;
+  tRle rle;
+
+  bkgColor  = color;
+  pBkgImage = pImage;
+
+  //remember where every row starts in the compressed data
+  if ((pImage != NULL) && (pImage[2] != FALSE))
+  {
+    rle.pData      = &pImage[4];
+    rle.compressed = TRUE;
+    rle.escapeChar = pImage[3];
+    rle.runLeft    = 0;
+    rle.color      = 0;
+
+    for(i=0; (i < pImage[1]) && (i < SCREEN_SIZE); i++)
+    {
+      tU8 j;
+
+      bkgRowOffset[i]  = rle.pData - &pImage[4];
+      bkgRowRunLeft[i] = rle.runLeft;
+      bkgRowColor[i]   = rle.color;
+      for(j=0; j<pImage[0]; j++)
+        rleNext(&rle);
+    }
+  }
+
+  //old positions show the old background, nothing to restore
+  for(i=0; i<SPRITE_MAX; i++)
+  {
+    sprites[i].onScreen = FALSE;
+    sprites[i].dirty    = TRUE;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get background pixels of (part of) one row.
+ *
+ ****************************************************************************/
+static void
+bkgRow(tU8 x, tU8 y, tU8 w, tU8* pDst)
+{
+  tU8  i;
+  tU8  imgW = 0;
+  tRle rle;
+
+  if ((pBkgImage != NULL) && (y < pBkgImage[1]))
+  {
+    imgW = pBkgImage[0];
+    rle.compressed = pBkgImage[2];
+    rle.escapeChar = pBkgImage[3];
+    if (rle.compressed == FALSE)
+      rle.pData = &pBkgImage[4 + (tU32)y * imgW];
+    else
+    {
+      rle.pData   = &pBkgImage[4 + bkgRowOffset[y]];
+      rle.runLeft = bkgRowRunLeft[y];
+      rle.color   = bkgRowColor[y];
+    }
+
+    for(i=0; (i < x) && (i < imgW); i++)
+      rleNext(&rle);
+  }
+
+  for(i=0; i<w; i++)
+  {
+    if (x + i < imgW)
+      pDst[i] = rleNext(&rle);
+    else
+      pDst[i] = bkgColor;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Create a sprite (initially hidden, at 0,0).
+ *
+ * Params:
+ *    [in] pImage     - image, at most SPRITE_SCRATCH pixels
+ *    [in] colorKey   - transparent color
+ *    [in] z          - z-order, higher values are drawn on top
+ *    [in] pSaveUnder - buffer of width * height bytes (of the largest image
+ *                      that will be used with the sprite)
+ *
+ * Returns:
+ *    Sprite id, or SPRITE_NONE if the pool is full.
+ *
+ ****************************************************************************/
+tU8
+sprCreate(const tU8* pImage, tU8 colorKey, tU8 z, tU8* pSaveUnder)
+{
+  tU8 i;
+
+  if ((tU32)pImage[0] * pImage[1] > SPRITE_SCRATCH)
+    return SPRITE_NONE;
+
+  for(i=0; i<SPRITE_MAX; i++)
+  {
+    if (sprites[i].used == FALSE)
+    {
+      sprites[i].used       = TRUE;
+      sprites[i].pImage     = pImage;
+      sprites[i].pSaveUnder = pSaveUnder;
+      sprites[i].colorKey   = colorKey;
+      sprites[i].z          = z;
+      sprites[i].x          = 0;
+      sprites[i].y          = 0;
+      sprites[i].visible    = FALSE;
+      sprites[i].onScreen   = FALSE;
+      sprites[i].dirty      = FALSE;
+      sortSprites();
+      return i;
+    }
+  }
+  return SPRITE_NONE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Remove a sprite (from the screen directly).
+ *
+ ****************************************************************************/
+void
+sprDelete(tU8 id)
+{
+  sprShow(id, FALSE);
+  sprUpdate();
+  sprites[id].used = FALSE;
+  sortSprites();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Sort the used sprites on z-order (insertion sort, few sprites).
+ *
+ ****************************************************************************/
+static void
+sortSprites(void)
+{
+  tU8 i, j;
+
+  numSprites = 0;
+  for(i=0; i<SPRITE_MAX; i++)
+  {
+    if (sprites[i].used == FALSE)
+      continue;
+
+    for(j=numSprites; (j > 0) && (sprites[order[j-1]].z > sprites[i].z); j--)
+      order[j] = order[j-1];
+    order[j] = i;
+    numSprites++;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Move a sprite (drawn at next sprUpdate()).
+ *
+ ****************************************************************************/
+void
+sprMove(tU8 id, tU8 x, tU8 y)
+{
+  if ((sprites[id].x != x) || (sprites[id].y != y))
+  {
+    sprites[id].x     = x;
+    sprites[id].y     = y;
+    sprites[id].dirty = TRUE;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Change image of a sprite (drawn at next sprUpdate()). The image must
+ *    not be larger than the save-under buffer of the sprite.
+ *
+ ****************************************************************************/
+void
+sprImage(tU8 id, const tU8* pImage)
+{
+  sprites[id].pImage = pImage;
+  sprites[id].dirty  = TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Show or hide a sprite (drawn at next sprUpdate()).
+ *
+ ****************************************************************************/
+void
+sprShow(tU8 id, tBool visible)
+{
+  if (sprites[id].visible != visible)
+  {
+    sprites[id].visible = visible;
+    sprites[id].dirty   = TRUE;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the on-screen rectangle of a sprite.
+ *
+ * Returns:
+ *    FALSE if the sprite is hidden or completely off-screen.
+ *
+ ****************************************************************************/
+static tBool
+clipSprite(tSprite* pSprite, tRect* pRect)
+{
+  if ((pSprite->visible == FALSE) ||
+      (pSprite->x >= SCREEN_SIZE) || (pSprite->y >= SCREEN_SIZE))
+    return FALSE;
+
+  pRect->x = pSprite->x;
+  pRect->y = pSprite->y;
+  pRect->w = (pSprite->x + pSprite->pImage[0] > SCREEN_SIZE) ? SCREEN_SIZE - pSprite->x : pSprite->pImage[0];
+  pRect->h = (pSprite->y + pSprite->pImage[1] > SCREEN_SIZE) ? SCREEN_SIZE - pSprite->y : pSprite->pImage[1];
+  return ((pRect->w > 0) && (pRect->h > 0));
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Intersection of two rectangles.
+ *
+ * Returns:
+ *    FALSE if the rectangles do not overlap.
+ *
+ ****************************************************************************/
+static tBool
+intersect(const tRect* pA, const tRect* pB, tRect* pOut)
+{
+  tU8 x0 = (pA->x > pB->x) ? pA->x : pB->x;
+  tU8 y0 = (pA->y > pB->y) ? pA->y : pB->y;
+  tU8 x1 = (pA->x + pA->w < pB->x + pB->w) ? pA->x + pA->w : pB->x + pB->w;
+  tU8 y1 = (pA->y + pA->h < pB->y + pB->h) ? pA->y + pA->h : pB->y + pB->h;
+
+  if ((x0 >= x1) || (y0 >= y1))
+    return FALSE;
+
+  if (pOut != NULL)
+  {
+    pOut->x = x0;
+    pOut->y = y0;
+    pOut->w = x1 - x0;
+    pOut->h = y1 - y0;
+  }
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw the part of a sprite that is inside the region in the scratch
+ *    buffer (which holds the region), skipping the colour key.
+ *
+ ****************************************************************************/
+static void
+blitSprite(tSprite* pSprite, const tRect* pRegion)
+{
+  tU8  i, j;
+  tU8  color;
+  tU8  w = pSprite->pImage[0];
+  tU8  h = pSprite->pImage[1];
+  tRle rle;
+
+  rle.pData      = &pSprite->pImage[4];
+  rle.compressed = pSprite->pImage[2];
+  rle.escapeChar = pSprite->pImage[3];
+  rle.runLeft    = 0;
+
+  for(j=0; j<h; j++)
+  {
+    tU8 y = pSprite->y + j;
+
+    for(i=0; i<w; i++)
+    {
+      tU8 x = pSprite->x + i;
+
+      color = rleNext(&rle);
+      if ((color != pSprite->colorKey) &&
+          (x >= pRegion->x) && (x < pRegion->x + pRegion->w) &&
+          (y >= pRegion->y) && (y < pRegion->y + pRegion->h))
+        scratch[(y - pRegion->y) * pRegion->w + (x - pRegion->x)] = color;
+    }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Compose a region of the screen and send it to the LCD.
+ *
+ * Params:
+ *    [in] pOwner  - the sprite that has changed
+ *    [in] pRegion - region to compose (on screen, max SPRITE_SCRATCH pixels)
+ *    [in] useOld  - take background from the save-under of the owner
+ *                   where the owner was drawn before
+ *    [in] pNew    - new rectangle of the owner, its background is saved
+ *                   in the save-under (or NULL)
+ *
+ ****************************************************************************/
+static void
+compose(tSprite* pOwner, const tRect* pRegion, tBool useOld, const tRect* pNew)
+{
+  tU8   i, j;
+  tRect old;
+  tRect tmp;
+
+  //the scratch buffer may still be in the display list
+  if (scratchPending == TRUE)
+  {
+    lcdFlush();
+    scratchPending = FALSE;
+  }
+
+  //background
+  if ((useOld == FALSE) || (intersect(pRegion, &pOwner->drawn, &old) == FALSE))
+  {
+    old.x = old.y = 0;
+    old.w = old.h = 0;
+  }
+
+  for(j=0; j<pRegion->h; j++)
+  {
+    tU8  y    = pRegion->y + j;
+    tU8* pRow = &scratch[j * pRegion->w];
+
+    if ((y >= old.y) && (y < old.y + old.h))
+    {
+      //left of, saved part and right of old rectangle
+      bkgRow(pRegion->x, y, old.x - pRegion->x, pRow);
+      for(i=0; i<old.w; i++)
+        pRow[old.x - pRegion->x + i] =
+          pOwner->pSaveUnder[(y - pOwner->drawn.y) * pOwner->drawn.w + (old.x - pOwner->drawn.x) + i];
+      bkgRow(old.x + old.w, y, pRegion->x + pRegion->w - (old.x + old.w),
+             &pRow[old.x + old.w - pRegion->x]);
+    }
+    else
+      bkgRow(pRegion->x, y, pRegion->w, pRow);
+  }
+
+  //save background under the new position
+  if (pNew != NULL)
+    for(j=0; j<pNew->h; j++)
+      for(i=0; i<pNew->w; i++)
+        pOwner->pSaveUnder[j * pNew->w + i] =
+          scratch[(pNew->y - pRegion->y + j) * pRegion->w + (pNew->x - pRegion->x + i)];
+
+  //all sprites, bottom to top
+  for(i=0; i<numSprites; i++)
+  {
+    tSprite* pSprite = &sprites[order[i]];
+
+    if ((clipSprite(pSprite, &tmp) == TRUE) && (intersect(&tmp, pRegion, NULL) == TRUE))
+      blitSprite(pSprite, pRegion);
+  }
+
+  lcdIcon(pRegion->x, pRegion->y, pRegion->w, pRegion->h, FALSE, 0, scratch);
+  scratchPending = TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw all sprite changes since last call.
+ *
+ ****************************************************************************/
+void
+sprUpdate(void)
+{
+  tU8   i;
+  tRect newRect;
+  tRect region;
+
+  for(i=0; i<SPRITE_MAX; i++)
+  {
+    tSprite* pSprite = &sprites[i];
+    tBool    hasNew;
+
+    if ((pSprite->used == FALSE) || (pSprite->dirty == FALSE))
+      continue;
+
+    hasNew = clipSprite(pSprite, &newRect);
+
+    if ((pSprite->onScreen == TRUE) && (hasNew == TRUE) &&
+        (intersect(&pSprite->drawn, &newRect, NULL) == TRUE))
+    {
+      //one window covering both rectangles
+      region.x = (newRect.x < pSprite->drawn.x) ? newRect.x : pSprite->drawn.x;
+      region.y = (newRect.y < pSprite->drawn.y) ? newRect.y : pSprite->drawn.y;
+      region.w = ((newRect.x + newRect.w > pSprite->drawn.x + pSprite->drawn.w) ?
+                  newRect.x + newRect.w : pSprite->drawn.x + pSprite->drawn.w) - region.x;
+      region.h = ((newRect.y + newRect.h > pSprite->drawn.y + pSprite->drawn.h) ?
+                  newRect.y + newRect.h : pSprite->drawn.y + pSprite->drawn.h) - region.y;
+    }
+    else
+      region.w = 0;
+
+    if ((region.w > 0) && ((tU32)region.w * region.h <= SPRITE_SCRATCH))
+      compose(pSprite, &region, TRUE, &newRect);
+    else
+    {
+      if (pSprite->onScreen == TRUE)
+        compose(pSprite, &pSprite->drawn, TRUE, NULL);
+      if (hasNew == TRUE)
+        compose(pSprite, &newRect, FALSE, &newRect);
+    }
+
+    pSprite->onScreen = hasNew;
+    pSprite->drawn    = newRect;
+    pSprite->dirty    = FALSE;
+  }
+}
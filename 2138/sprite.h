@@ -0,0 +1,39 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    sprite.h
+ *
+ * Description:
+ *    Expose the sprite layer (moving objects over a known background).
+ *
+ *****************************************************************************/
+#ifndef _SPRITE_H_
+#define _SPRITE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define SPRITE_MAX      8       //number of sprites in pool
+#define SPRITE_SCRATCH  1024    //max pixels sent in one window
+#define SPRITE_NONE     0xff
+
+
+void sprInit(void);
+void sprBackground(tU8 color, const tU8* pImage);
+tU8  sprCreate(const tU8* pImage, tU8 colorKey, tU8 z, tU8* pSaveUnder);
+void sprDelete(tU8 id);
+void sprMove(tU8 id, tU8 x, tU8 y);
+void sprImage(tU8 id, const tU8* pImage);
+void sprShow(tU8 id, tBool visible);
+void sprUpdate(void);
+
+#endif
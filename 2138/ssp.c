@@ -0,0 +1,161 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    ssp.c
+ *
+ * Description:
+ *    Implements a 9-bit LCD bus with the SSP block in the LPC213x.
+ *    The first bit of every frame is the command/data bit, so no pin
+ *    reconfiguration is needed between words. The transmit FIFO is
+ *    refilled as soon as there is room in it, and only the final
+ *    sspWaitIdle() (before chip select is released) waits for the
+ *    frames to be shifted out.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "ssp.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define SSPCR0_9BIT  0x0008   //DSS = 9 bits, SPI frame format, CPOL = CPHA = 0
+#define SSPCR0_SCR   0x0300   //SCR = 3
+#define SSPCPSR_DIV  0x02     //PCLK / (2 * (3+1)), same bit rate as SPI0
+#define SSPCR1_SSE   0x02     //SSP enable, master mode
+
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static void sspDrainRx(void);
+static void sspPut(tU16 word);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize the SSP block for 9-bit frames.
+ *    The pins must be connected to the SSP block by the caller.
+ *
+ ****************************************************************************/
+void
+sspInit(void)
+{
+  SSP_WRITE(SSPCR1,  0x00);     //disable while configuring
+  SSP_WRITE(SSPCR0,  SSPCR0_9BIT | SSPCR0_SCR);
+  SSP_WRITE(SSPCPSR, SSPCPSR_DIV);
+  SSP_WRITE(SSPIMSC, 0x00);     //no interrupts
+  SSP_WRITE(SSPCR1,  SSPCR1_SSE);
+
+  sspDrainRx();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Empty the receive FIFO. Every transmitted frame also clocks in one
+ *    frame that nobody is interested in.
+ *
+ ****************************************************************************/
+static void
+sspDrainRx(void)
+{
+  volatile tU32 dummy;
+
+  while(SSP_READ(SSPSR) & SSPSR_RNE)
+    dummy = SSP_READ(SSPDR);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Put one frame in the transmit FIFO, wait only if it is full.
+ *
+ ****************************************************************************/
+static void
+sspPut(tU16 word)
+{
+  volatile tU32 dummy;
+  tU32 status;
+
+  while(((status = SSP_READ(SSPSR)) & SSPSR_TNF) == 0)
+    sspDrainRx();
+
+  SSP_WRITE(SSPDR, word);
+
+  //one frame in gives one frame out, so one read per write keeps up
+  if (status & SSPSR_RNE)
+    dummy = SSP_READ(SSPDR);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue one 9-bit word (bit 8 = command/data bit).
+ *
+ ****************************************************************************/
+void
+sspSendWord(tU16 word)
+{
+  sspPut(word & 0x1ff);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a block of bytes, all with the same command/data bit.
+ *
+ ****************************************************************************/
+void
+sspSendBlock(tU8 firstBit, const tU8* pData, tU32 len)
+{
+  tU16 dc = (firstBit == 1) ? 0x100 : 0x000;
+
+  while(len-- > 0)
+    sspPut(dc | *pData++);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue the same byte count times.
+ *
+ ****************************************************************************/
+void
+sspSendRepeat(tU8 firstBit, tU8 data, tU32 count)
+{
+  tU16 word = ((firstBit == 1) ? 0x100 : 0x000) | data;
+
+  while(count-- > 0)
+    sspPut(word);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait until all queued frames have been shifted out.
+ *    Must be called before the LCD controller is deselected.
+ *
+ ****************************************************************************/
+void
+sspWaitIdle(void)
+{
+  while(SSP_READ(SSPSR) & SSPSR_BSY)
+    sspDrainRx();
+
+  sspDrainRx();
+}
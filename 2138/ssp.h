@@ -0,0 +1,54 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    ssp.h
+ *
+ * Description:
+ *    Expose routines for the SSP block (LPC213x) used as 9-bit LCD bus.
+ *
+ *****************************************************************************/
+#ifndef _SSP_H_
+#define _SSP_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define SSP_FIFO_DEPTH 8
+
+//bits in SSPSR
+#define SSPSR_TFE  0x01     //transmit FIFO empty
+#define SSPSR_TNF  0x02     //transmit FIFO not full
+#define SSPSR_RNE  0x04     //receive FIFO not empty
+#define SSPSR_RFF  0x08     //receive FIFO full
+#define SSPSR_BSY  0x10     //busy
+
+//bits in SSPIMSC
+#define SSPIMSC_TXIM 0x08   //transmit FIFO at least half empty
+
+//register access, all SSP register accesses go through these macros
+//so that a fake SSP can be used when building on a host
+#ifdef HOST_BUILD
+#include "host/fakeSsp.h"
+#else
+#include <lpc2xxx.h>
+#define SSP_WRITE(reg, value) ((reg) = (value))
+#define SSP_READ(reg)         (reg)
+#endif
+
+
+void sspInit(void);
+void sspSendWord(tU16 word);
+void sspSendBlock(tU8 firstBit, const tU8* pData, tU32 len);
+void sspSendRepeat(tU8 firstBit, tU8 data, tU32 count);
+void sspWaitIdle(void);
+
+#endif
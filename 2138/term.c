@@ -0,0 +1,358 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    term.c
+ *
+ * Description:
+ *    Text console in a band of the LCD that uses the vertical scroll
+ *    commands of the controller. The band is defined as the scroll area
+ *    (VSCRDEF) and the text lines are used as a ring in display memory.
+ *    A new line moves the scroll start address (VSCSAD) one text line,
+ *    so scrolling costs one command and only the exposed line is cleared.
+ *
+ *    Characters are collected to text runs and queued on the display
+ *    list at end of line or at termFlush(). The functions take a
+ *    semaphore, so one process may write to the console while another
+ *    one opens and closes it.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include "term.h"
+#include "lcd.h"
+#include "lcdList.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define LINE_HEIGHT   14      //8x14 characters
+#define MEMORY_ROWS   132     //rows in display memory, visible rows start at 2
+#define FIRST_ROW     2
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tBool termOpened = FALSE;
+static tU8   termTop;         //first screen row of the console
+static tU8   termLines;       //number of text lines
+static tU8   termHeight;      //termLines * LINE_HEIGHT
+static tU8   termOffset;      //rows the memory ring has been scrolled
+static tU8   termLine;        //cursor line, 0 is the top line
+static tU8   termCol;         //cursor column
+static tU8   termBkg;
+static tU8   termText;
+
+//characters not yet queued, starting at column runCol
+static tU8   runText[TERM_COLUMNS];
+static tU8   runLen;
+static tU8   runCol;
+
+static tCntSem termSem;       //one process at a time in the console
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static tU8  memRow(tU8 line);
+static void setScroll(tU8 offset);
+static void newLine(void);
+static void closeTerm(void);
+static void flushRun(void);
+static void putChar(tU8 ch);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Get the screen row (in the unscrolled coordinate system used by the
+ *    window commands) where a text line is stored.
+ *
+ ****************************************************************************/
+static tU8
+memRow(tU8 line)
+{
+  tU16 row = termOffset + (tU16)line * LINE_HEIGHT;
+
+  if (row >= termHeight)
+    row -= termHeight;
+  return termTop + row;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue a new scroll start address.
+ *
+ ****************************************************************************/
+static void
+setScroll(tU8 offset)
+{
+  tU8 param = FIRST_ROW + termTop + offset;
+
+  lcdListCmd(LCD_CMD_VSCSAD, &param, 1);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize the console, before any process uses it.
+ *
+ ****************************************************************************/
+void
+termInit(void)
+{
+  osSemInit(&termSem, 1);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Open the console. Clears the console area and defines it as scroll
+ *    area. The area must fit on the screen (top + 14*lines <= 130).
+ *
+ * Params:
+ *    [in] top       - first screen row of the console
+ *    [in] lines     - number of text lines
+ *    [in] bkgColor  - background color
+ *    [in] textColor - text color
+ *
+ ****************************************************************************/
+void
+termOpen(tU8 top, tU8 lines, tU8 bkgColor, tU8 textColor)
+{
+  tU8 params[3];
+  tU8 error;
+
+  osSemTake(&termSem, 0, &error);
+
+  if (termOpened == TRUE)
+    closeTerm();
+
+  if (lines == 0)
+    lines = 1;
+  while(top + lines * LINE_HEIGHT > 130)
+    lines--;
+
+  termTop    = top;
+  termLines  = lines;
+  termHeight = lines * LINE_HEIGHT;
+  termOffset = 0;
+  termLine   = 0;
+  termCol    = 0;
+  termBkg    = bkgColor;
+  termText   = textColor;
+  runLen     = 0;
+  runCol     = 0;
+
+  lcdListRect(0, termTop, 130, termHeight, termBkg);
+
+  //top fixed area, scroll area and bottom fixed area (sum is 132 rows)
+  params[0] = FIRST_ROW + termTop;
+  params[1] = termHeight;
+  params[2] = MEMORY_ROWS - params[0] - params[1];
+  lcdListCmd(LCD_CMD_VSCRDEF, params, 3);
+  setScroll(0);
+
+  termOpened = TRUE;
+  osSemGive(&termSem, &error);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Close the console and return the controller to normal display mode.
+ *    The console area keeps the (scrolled) content until it is redrawn.
+ *
+ ****************************************************************************/
+void
+termClose(void)
+{
+  tU8 error;
+
+  osSemTake(&termSem, 0, &error);
+  closeTerm();
+  osSemGive(&termSem, &error);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Close the console, called with the semaphore taken.
+ *
+ ****************************************************************************/
+static void
+closeTerm(void)
+{
+  if (termOpened == FALSE)
+    return;
+
+  flushRun();
+  termOpened = FALSE;
+
+  termOffset = 0;
+  setScroll(0);
+  lcdListCmd(LCD_CMD_NORON, NULL, 0);
+  lcdFlush();
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check if the console is open.
+ *
+ ****************************************************************************/
+tBool
+termIsOpen(void)
+{
+  return termOpened;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue the collected characters as one text run.
+ *
+ ****************************************************************************/
+void
+termFlush(void)
+{
+  tU8 error;
+
+  osSemTake(&termSem, 0, &error);
+  flushRun();
+  osSemGive(&termSem, &error);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Queue the collected characters, called with the semaphore taken.
+ *
+ ****************************************************************************/
+static void
+flushRun(void)
+{
+  if (termOpened == FALSE || runLen == 0)
+    return;
+
+  lcdListText(1 + 8*runCol, memRow(termLine), termBkg, termText, runText, runLen);
+  runLen = 0;
+  runCol = termCol;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Move the cursor to the start of next line. On the last line the
+ *    scroll start address is moved one text line instead, and the line
+ *    that comes into view (the old top line) is cleared.
+ *
+ ****************************************************************************/
+static void
+newLine(void)
+{
+  flushRun();
+  termCol = 0;
+  runCol  = 0;
+
+  if (termLine + 1 < termLines)
+  {
+    termLine++;
+    return;
+  }
+
+  termOffset += LINE_HEIGHT;
+  if (termOffset >= termHeight)
+    termOffset = 0;
+
+  lcdListRect(0, memRow(termLine), 130, LINE_HEIGHT, termBkg);
+  setScroll(termOffset);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write one character to the console. '\n' starts a new line, '\r'
+ *    returns to the first column and long lines are wrapped. Other
+ *    control characters are ignored.
+ *
+ ****************************************************************************/
+void
+termPutchar(tU8 ch)
+{
+  tU8 error;
+
+  osSemTake(&termSem, 0, &error);
+  putChar(ch);
+  osSemGive(&termSem, &error);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write one character, called with the semaphore taken.
+ *
+ ****************************************************************************/
+static void
+putChar(tU8 ch)
+{
+  if (termOpened == FALSE)
+    return;
+
+  if (ch == '\n')
+    newLine();
+
+  else if (ch == '\r')
+  {
+    flushRun();
+    termCol = 0;
+    runCol  = 0;
+  }
+
+  else if (ch >= ' ' && ch <= 127)
+  {
+    if (termCol == TERM_COLUMNS)
+      newLine();
+
+    runText[runLen++] = ch;
+    termCol++;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write a string to the console and queue it.
+ *
+ ****************************************************************************/
+void
+termPuts(const char* pStr)
+{
+  tU8 error;
+
+  osSemTake(&termSem, 0, &error);
+  while(*pStr != '\0')
+    putChar(*pStr++);
+  flushRun();
+  osSemGive(&termSem, &error);
+}
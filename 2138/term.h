@@ -0,0 +1,36 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    term.h
+ *
+ * Description:
+ *    Expose the hardware scrolled text console on the LCD.
+ *
+ *****************************************************************************/
+#ifndef _TERM_H_
+#define _TERM_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define TERM_COLUMNS  16      //8x14 characters on one line
+
+
+void  termInit(void);
+void  termOpen(tU8 top, tU8 lines, tU8 bkgColor, tU8 textColor);
+void  termClose(void);
+tBool termIsOpen(void);
+void  termPutchar(tU8 ch);
+void  termPuts(const char* pStr);
+void  termFlush(void);
+
+#endif
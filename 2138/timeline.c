@@ -0,0 +1,185 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    timeline.c
+ *
+ * Description:
+ *    Player for sequences of drawing operations in a compact byte code
+ *    (see timeline.h), e.g. the startup sequence.
+ *
+ *    The player keeps the time at which each operation is due. Waits and
+ *    typed characters advance this time instead of sleeping for a fixed
+ *    time, so a slow drawing operation only delays the operations up to
+ *    the point where the timeline catches up again, and does not stretch
+ *    the whole sequence.
+ *
+ *    A key press stops the timeline at once.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/osapi.h"
+#include "../pre_emptive_os/api/general.h"
+#include "timeline.h"
+#include "lcd.h"
+#include "lcdPalette.h"
+#include "key.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define FADE_STEPS  8
+#define FADE_DELAY  2
+#define TL_TICK_MS  10        //ms per OS tick (appTick)
+
+
+/*****************************************************************************
+ * External variables
+ ****************************************************************************/
+extern volatile tU32 ms;
+
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static tBool waitUntil(tU32 time);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Wait until the ms counter has reached a time. The process sleeps in
+ *    waitKey() for the remaining ticks.
+ *
+ * Returns:
+ *    FALSE if a key was pressed.
+ *
+ ****************************************************************************/
+static tBool
+waitUntil(tU32 time)
+{
+  tS32 left;
+
+  for(;;)
+  {
+    left = (tS32)(time - ms);
+    if (left <= 0)
+      return (checkKey() == KEY_NOTHING) ? TRUE : FALSE;
+    if (waitKey((left + TL_TICK_MS - 1) / TL_TICK_MS) != KEY_NOTHING)
+      return FALSE;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Play a timeline.
+ *
+ * Params:
+ *    [in] pProgram - byte code, ends with TL_END
+ *    [in] pTexts   - texts for TL_TYPE
+ *    [in] pDraw    - draw function for TL_DRAW
+ *
+ * Returns:
+ *    TRUE if the timeline was played to the end, FALSE if it was stopped
+ *    by a key press.
+ *
+ ****************************************************************************/
+tBool
+timelinePlay(const tU8* pProgram, const char* const* pTexts, tTimelineDraw pDraw)
+{
+  const tU8* pOp = pProgram;
+  tU32 time = ms;         //time at which the current operation is due
+  tU8  loops = 0;         //repeats left of the active TL_LOOP
+
+  for(;;)
+  {
+    //every operation starts when it is due
+    if (waitUntil(time) == FALSE)
+      return FALSE;
+
+    switch(*pOp++)
+    {
+      case TL_END:
+        return TRUE;
+
+      case TL_WAIT:
+        time += pOp[0] | (pOp[1] << 8);
+        pOp  += 2;
+        break;
+
+      case TL_COLOR:
+        lcdColor(pOp[0], pOp[1]);
+        pOp += 2;
+        break;
+
+      case TL_CLEAR:
+        lcdClrscr();
+        break;
+
+      case TL_GOTO:
+        lcdGotoxy(pOp[0], pOp[1]);
+        pOp += 2;
+        break;
+
+      case TL_TYPE:
+      {
+        const char* pText = pTexts[pOp[1]];
+
+        //one character when it is due, then the time advances
+        while (*pText != '\0')
+        {
+          lcdPutchar(*pText++);
+          time += pOp[0];
+          if (*pText != '\0' && waitUntil(time) == FALSE)
+            return FALSE;
+        }
+        pOp += 2;
+      }
+      break;
+
+      case TL_DRAW:
+        pDraw(*pOp++);
+        break;
+
+      case TL_BLACK:
+        lcdPaletteSet(&lcdPaletteBlack);
+        break;
+
+      case TL_FADE_IN:
+        lcdPaletteFade(&lcdPaletteBlack, &lcdPaletteNormal, FADE_STEPS, FADE_DELAY);
+        break;
+
+      case TL_FADE_OUT:
+        lcdPaletteFade(&lcdPaletteNormal, &lcdPaletteBlack, FADE_STEPS, FADE_DELAY);
+        break;
+
+      case TL_LOOP:
+        //first time: load the counter, then jump back while more runs
+        //are left (a count of 0 runs the block once, as a count of 1)
+        if (loops == 0)
+          loops = pOp[0];
+        if (loops > 1)
+        {
+          loops--;
+          pOp -= pOp[1] + 1;
+        }
+        else
+        {
+          loops = 0;
+          pOp  += 2;
+        }
+        break;
+
+      default:
+        return TRUE;
+    }
+  }
+}
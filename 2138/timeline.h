@@ -0,0 +1,46 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    timeline.h
+ *
+ * Description:
+ *    Expose the timeline player and its byte code.
+ *
+ *****************************************************************************/
+#ifndef _TIMELINE_H_
+#define _TIMELINE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+//operations, followed by their parameter bytes
+#define TL_END        0x00    //end of timeline
+#define TL_WAIT       0x01    //time, ms (16 bit, low byte first)
+#define TL_COLOR      0x02    //background color, text color
+#define TL_CLEAR      0x03    //clear screen in background color
+#define TL_GOTO       0x04    //x, y of text
+#define TL_TYPE       0x05    //ms per character, text number
+#define TL_DRAW       0x06    //id, passed to the draw function
+#define TL_BLACK      0x07    //set black palette
+#define TL_FADE_IN    0x08    //fade from black to the normal palette
+#define TL_FADE_OUT   0x09    //fade from the normal palette to black
+#define TL_LOOP       0x0a    //runs (0 = 1), bytes from the first repeated byte to TL_LOOP
+
+//helpers to write timelines
+#define TL_WAIT_MS(t)   TL_WAIT, ((t) & 0xff), ((t) >> 8)
+
+typedef void (*tTimelineDraw)(tU8 id);
+
+
+tBool timelinePlay(const tU8* pProgram, const char* const* pTexts, tTimelineDraw pDraw);
+
+#endif
@@ -0,0 +1,694 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    fontc.c
+ *
+ * Description:
+ *    Host tool (run from the makefile) that compiles fonts to the
+ *    proportional font format described in font.h.
+ *
+ *    Usage: fontc [options] -n <array name> -o <output.h> <font.bdf>
+ *           fontc [options] -c <w>x<h>[,<first>] -n <array name> -o <output.h> <array.h>
+ *
+ *    Options:
+ *      -s <pixels>  space between two glyphs (default 1)
+ *      -w <pixels>  advance of glyphs without any pixels, e.g. the space
+ *                   (default half the cell width)
+ *      -k <pixels>  max kerning, i.e. how much closer two glyphs may be
+ *                   moved where their shapes allow it (default 0, off)
+ *      -x <factor>  scale all glyphs up (1 - 4)
+ *      -m           monospace, glyphs keep the full cell
+ *
+ *    Inputs are BDF fonts, or with -c a C array of fixed cells of w x h
+ *    pixels (one or two bytes per pixel row, MSB is the leftmost pixel)
+ *    starting with character <first> (default 32), e.g. ascii.h.
+ *
+ *    Glyphs are trimmed to their pixels and advance by their width plus
+ *    the space. The kerning pairs are found by comparing the right edge
+ *    of the first glyph with the left edge of the second, row by row
+ *    (including the neighbouring rows, so that glyphs never touch).
+ *    The written font is read back with the target code (font.c) and
+ *    compared with the glyphs.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../pre_emptive_os/api/general.h"
+#include "font.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define MAX_SIZE    0x400000
+#define MAX_CELL    64        //max cell size in the sources, before scaling
+#define NUM_CHARS   256
+
+typedef struct
+{
+  tBool present;
+  tU32  cellWidth;           //advance in the source
+  tU8   pixels[FONT_MAX_HEIGHT][MAX_CELL];
+
+  //compiled glyph
+  tU32  width;
+  tU32  advance;
+  tS32  left[FONT_MAX_HEIGHT];    //first pixel of every row, -1 if none
+  tS32  right[FONT_MAX_HEIGHT];   //last pixel of every row, -1 if none
+} tGlyph;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tGlyph glyphs[NUM_CHARS];
+static tU32   height = 0;
+static tU32   first = NUM_CHARS;
+static tU32   last = 0;
+
+static tU32   spacing = 1;
+static tS32   spaceWidth = -1;
+static tU32   maxKern = 0;
+static tU32   scale = 1;
+static tBool  monospace = FALSE;
+
+static tS8    kern[NUM_CHARS][NUM_CHARS];
+static tU32   numPairs = 0;
+
+static tU8*   pOut;
+static tU32   outLen = 0;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Print an error message and exit.
+ *
+ ****************************************************************************/
+static void
+fail(const char* pFormat, const char* pArg)
+{
+  fprintf(stderr, "fontc: ");
+  fprintf(stderr, pFormat, pArg);
+  fprintf(stderr, "\n");
+  exit(1);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read a whole file.
+ *
+ ****************************************************************************/
+static char*
+readFile(const char* pName)
+{
+  FILE* pFile;
+  char* pData;
+  tU32  len;
+
+  pFile = fopen(pName, "rb");
+  if (pFile == NULL)
+    fail("cannot open %s", pName);
+
+  pData = malloc(MAX_SIZE + 1);
+  len = fread(pData, 1, MAX_SIZE, pFile);
+  pData[len] = '\0';
+  fclose(pFile);
+  return pData;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Add a character, the pixels are set afterwards.
+ *
+ ****************************************************************************/
+static tGlyph*
+addGlyph(const char* pName, tU32 c, tU32 cellWidth)
+{
+  if (c >= NUM_CHARS)
+    return NULL;
+  if (cellWidth > MAX_CELL)
+    fail("%s: character too wide", pName);
+
+  if (c < first)
+    first = c;
+  if (c > last)
+    last = c;
+  memset(&glyphs[c], 0, sizeof(tGlyph));
+  glyphs[c].present   = TRUE;
+  glyphs[c].cellWidth = cellWidth;
+  return &glyphs[c];
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read fixed cells from a C array. Comments are skipped, so that
+ *    characters can be disabled by commenting them out.
+ *
+ ****************************************************************************/
+static void
+readArray(const char* pName, char* pData, tU32 cellWidth, tU32 cellHeight, tU32 firstChar)
+{
+  tU32  rowBytes = (cellWidth + 7) / 8;
+  tU8*  pBytes = malloc(MAX_SIZE);
+  tU32  numBytes = 0;
+  char* pPos;
+  tU32  i, c, x, y;
+
+  //remove the comments
+  for(pPos = pData; *pPos != '\0'; pPos++)
+  {
+    if (pPos[0] == '/' && pPos[1] == '*')
+    {
+      while(*pPos != '\0' && (pPos[0] != '*' || pPos[1] != '/'))
+        *pPos++ = ' ';
+      if (*pPos != '\0')
+        pPos[0] = pPos[1] = ' ';
+    }
+    else if (pPos[0] == '/' && pPos[1] == '/')
+      while(*pPos != '\0' && *pPos != '\n')
+        *pPos++ = ' ';
+  }
+
+  pPos = strchr(pData, '{');
+  if (pPos == NULL)
+    fail("%s: no array found", pName);
+  pPos++;
+
+  for(;;)
+  {
+    char* pEnd;
+    tU32  value;
+
+    while(*pPos == ' ' || *pPos == ',' || *pPos == '\r' || *pPos == '\n' || *pPos == '\t')
+      pPos++;
+    if (*pPos == '}' || *pPos == '\0')
+      break;
+
+    value = strtoul(pPos, &pEnd, 0);
+    if (pEnd == pPos || value > 255 || numBytes == MAX_SIZE)
+      fail("%s: bad array", pName);
+    pBytes[numBytes++] = value;
+    pPos = pEnd;
+  }
+
+  if (numBytes == 0 || numBytes % (rowBytes * cellHeight) != 0)
+    fail("%s: array is not a multiple of the cell size", pName);
+
+  height = cellHeight;
+  for(i=0; i<numBytes / (rowBytes * cellHeight); i++)
+  {
+    const tU8* pCell = pBytes + i * rowBytes * cellHeight;
+    tGlyph*    pGlyph;
+
+    c = firstChar + i;
+    pGlyph = addGlyph(pName, c, cellWidth);
+    if (pGlyph == NULL)
+      fail("%s: too many characters", pName);
+
+    for(y=0; y<cellHeight; y++)
+      for(x=0; x<cellWidth; x++)
+        pGlyph->pixels[y][x] = (pCell[y * rowBytes + x / 8] >> (7 - x % 8)) & 1;
+  }
+  free(pBytes);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read a BDF font. Every glyph is placed in a cell of its advance
+ *    (DWIDTH) and the font height, at the baseline of the font.
+ *
+ ****************************************************************************/
+static void
+readBdf(const char* pName, char* pData)
+{
+  char* pLine = pData;
+  tS32  ascent = -1;
+  tS32  descent = -1;
+  tS32  encoding = -1;
+  tS32  dWidth = 0;
+  tS32  bbw = 0, bbh = 0, bbx = 0, bby = 0;
+
+  while(pLine != NULL && *pLine != '\0')
+  {
+    char* pNext = strchr(pLine, '\n');
+
+    if (pNext != NULL)
+      *pNext++ = '\0';
+
+    if (strncmp(pLine, "FONT_ASCENT ", 12) == 0)
+      ascent = strtol(pLine + 12, NULL, 10);
+    else if (strncmp(pLine, "FONT_DESCENT ", 13) == 0)
+      descent = strtol(pLine + 13, NULL, 10);
+    else if (strncmp(pLine, "ENCODING ", 9) == 0)
+      encoding = strtol(pLine + 9, NULL, 10);
+    else if (strncmp(pLine, "DWIDTH ", 7) == 0)
+      dWidth = strtol(pLine + 7, NULL, 10);
+    else if (strncmp(pLine, "BBX ", 4) == 0)
+    {
+      if (sscanf(pLine + 4, "%d %d %d %d", &bbw, &bbh, &bbx, &bby) != 4)
+        fail("%s: bad BBX", pName);
+    }
+    else if (strncmp(pLine, "BITMAP", 6) == 0)
+    {
+      tGlyph* pGlyph = NULL;
+      tS32    row;
+
+      if (ascent < 0 || descent < 0 || ascent + descent > FONT_MAX_HEIGHT)
+        fail("%s: FONT_ASCENT/FONT_DESCENT missing or too large", pName);
+      height = ascent + descent;
+
+      if (encoding >= 0 && dWidth >= 0)
+        pGlyph = addGlyph(pName, encoding, dWidth);
+
+      for(row = 0; pNext != NULL && strncmp(pNext, "ENDCHAR", 7) != 0; row++)
+      {
+        char* pHex = pNext;
+        tS32  y = ascent - (bby + bbh) + row;
+        tS32  x;
+
+        pNext = strchr(pNext, '\n');
+        if (pNext != NULL)
+          pNext++;
+
+        for(x=0; pGlyph != NULL && x<bbw; x++)
+        {
+          char digit[2] = {pHex[x / 4], '\0'};
+          tS32 cellX = bbx + x;
+
+          if (((strtoul(digit, NULL, 16) >> (3 - x % 4)) & 1) == 0)
+            continue;
+          if (y < 0 || y >= (tS32)height || cellX < 0 || cellX >= MAX_CELL)
+            fail("%s: glyph outside of the font box", pName);
+          pGlyph->pixels[y][cellX] = 1;
+          if ((tU32)cellX >= pGlyph->cellWidth)
+            pGlyph->cellWidth = cellX + 1;
+        }
+      }
+      encoding = -1;
+    }
+    pLine = pNext;
+  }
+
+  if (height == 0)
+    fail("%s: no glyphs found", pName);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Scale up all glyphs.
+ *
+ ****************************************************************************/
+static void
+scaleGlyphs(void)
+{
+  tU32 c, x, y;
+
+  if (height * scale > FONT_MAX_HEIGHT)
+    fail("%s", "scaled font too high");
+
+  for(c=first; c<=last; c++)
+  {
+    tGlyph* pGlyph = &glyphs[c];
+    tU8     pixels[FONT_MAX_HEIGHT][MAX_CELL];
+
+    if (pGlyph->present == FALSE)
+      continue;
+    if (pGlyph->cellWidth * scale > MAX_CELL)
+      fail("%s", "scaled font too wide");
+
+    for(y=0; y<height * scale; y++)
+      for(x=0; x<pGlyph->cellWidth * scale; x++)
+        pixels[y][x] = pGlyph->pixels[y / scale][x / scale];
+    memcpy(pGlyph->pixels, pixels, sizeof(pixels));
+    pGlyph->cellWidth *= scale;
+  }
+  height *= scale;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Trim the glyphs to their pixels (unless monospace) and find the
+ *    edges of every row.
+ *
+ ****************************************************************************/
+static void
+compileGlyphs(void)
+{
+  tU32 c, x, y;
+
+  for(c=first; c<=last; c++)
+  {
+    tGlyph* pGlyph = &glyphs[c];
+    tS32    minX = MAX_CELL;
+    tS32    maxX = -1;
+
+    if (pGlyph->present == FALSE)
+      continue;
+
+    for(y=0; y<height; y++)
+      for(x=0; x<pGlyph->cellWidth; x++)
+        if (pGlyph->pixels[y][x])
+        {
+          if ((tS32)x < minX)
+            minX = x;
+          if ((tS32)x > maxX)
+            maxX = x;
+        }
+
+    if (monospace == TRUE)
+    {
+      minX = 0;
+      pGlyph->width   = pGlyph->cellWidth;
+      pGlyph->advance = pGlyph->cellWidth;
+    }
+    else if (maxX < 0)
+    {
+      pGlyph->width   = 0;
+      pGlyph->advance = (spaceWidth >= 0) ? (tU32)spaceWidth : (pGlyph->cellWidth + 1) / 2;
+    }
+    else
+    {
+      //move the pixels to the left edge
+      pGlyph->width   = maxX - minX + 1;
+      pGlyph->advance = pGlyph->width + spacing;
+      for(y=0; y<height; y++)
+      {
+        memmove(pGlyph->pixels[y], &pGlyph->pixels[y][minX], MAX_CELL - minX);
+        memset(&pGlyph->pixels[y][MAX_CELL - minX], 0, minX);
+      }
+    }
+
+    if (pGlyph->width > FONT_MAX_WIDTH)
+      fail("%s", "glyph wider than FONT_MAX_WIDTH pixels");
+    if (pGlyph->advance > 255)
+      fail("%s", "advance too large");
+
+    for(y=0; y<height; y++)
+    {
+      pGlyph->left[y]  = -1;
+      pGlyph->right[y] = -1;
+      for(x=0; x<pGlyph->width; x++)
+        if (pGlyph->pixels[y][x])
+        {
+          if (pGlyph->left[y] < 0)
+            pGlyph->left[y] = x;
+          pGlyph->right[y] = x;
+        }
+    }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Find the kerning pairs. The first glyph is widened by one row up and
+ *    down, and the smallest gap to the second glyph is halved towards the
+ *    normal space, by maxKern pixels at most.
+ *
+ ****************************************************************************/
+static void
+findKerning(void)
+{
+  tU32 a, b, y;
+
+  if (maxKern == 0 || monospace == TRUE)
+    return;
+
+  for(a=first; a<=last; a++)
+    for(b=first; b<=last; b++)
+    {
+      tGlyph* pA = &glyphs[a];
+      tGlyph* pB = &glyphs[b];
+      tS32    minGap = 0x7fffffff;
+      tS32    adjust;
+
+      if (pA->present == FALSE || pB->present == FALSE || pA->width == 0 || pB->width == 0)
+        continue;
+
+      for(y=0; y<height; y++)
+      {
+        tS32 right = pA->right[y];
+        tS32 gap;
+
+        if (y > 0 && pA->right[y - 1] > right)
+          right = pA->right[y - 1];
+        if (y + 1 < height && pA->right[y + 1] > right)
+          right = pA->right[y + 1];
+        if (right < 0 || pB->left[y] < 0)
+          continue;
+
+        gap = (tS32)pA->advance + pB->left[y] - right - 1;
+        if (gap < minGap)
+          minGap = gap;
+      }
+
+      //glyphs that are not side by side anywhere (e.g. ' and .) are kept,
+      //and half of the extra gap is taken (only gaps of 2 pixels or more)
+      if (minGap == 0x7fffffff || minGap < (tS32)spacing + 2)
+        continue;
+
+      adjust = ((tS32)spacing - minGap) / 2;
+      if (adjust < -(tS32)maxKern)
+        adjust = -(tS32)maxKern;
+      kern[a][b] = adjust;
+      numPairs++;
+    }
+
+  if (numPairs > 0xffff)
+    fail("%s", "too many kerning pairs");
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Append bytes to the font.
+ *
+ ****************************************************************************/
+static void
+put(tU8 value)
+{
+  if (outLen == MAX_SIZE)
+    fail("%s", "font too large");
+  pOut[outLen++] = value;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Build the font: header, glyph table, kerning pairs and bitmaps.
+ *
+ ****************************************************************************/
+static void
+buildFont(void)
+{
+  tU32 count = last - first + 1;
+  tU32 offset;
+  tU32 a, b, c, x, y;
+
+  pOut = malloc(MAX_SIZE);
+  put(FONT_MAGIC);
+  put(height);
+  put(first);
+  put(count);
+  put(numPairs);
+  put(numPairs >> 8);
+
+  offset = FONT_HEADER_SIZE + FONT_GLYPH_SIZE * count + FONT_KERN_SIZE * numPairs;
+  for(c=first; c<=last; c++)
+  {
+    tGlyph* pGlyph = &glyphs[c];
+
+    if (offset > 0xffff)
+      fail("%s", "font too large for 16-bit offsets");
+    put(offset);
+    put(offset >> 8);
+    put(pGlyph->width);
+    put(pGlyph->advance);
+    offset += height * ((pGlyph->width + 7) / 8);
+  }
+
+  for(a=first; a<=last; a++)
+    for(b=first; b<=last; b++)
+      if (kern[a][b] != 0)
+      {
+        put(a);
+        put(b);
+        put((tU8)kern[a][b]);
+      }
+
+  for(c=first; c<=last; c++)
+  {
+    tGlyph* pGlyph = &glyphs[c];
+
+    for(y=0; y<height; y++)
+      for(x=0; x<pGlyph->width; x += 8)
+      {
+        tU8 bits = 0;
+        tU32 i;
+
+        for(i=0; i<8 && x + i < pGlyph->width; i++)
+          if (pGlyph->pixels[y][x + i])
+            bits |= 0x80 >> i;
+        put(bits);
+      }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read the font back with the target code and compare.
+ *
+ ****************************************************************************/
+static void
+verifyFont(void)
+{
+  tU32 a, b, x, y;
+
+  if (fontValid(pOut) == FALSE || fontHeight(pOut) != height)
+    fail("%s", "font check failed");
+
+  for(a=0; a<NUM_CHARS; a++)
+  {
+    const tU8* pBits;
+    tU8 width, advance;
+
+    pBits = fontGlyph(pOut, a, &width, &advance);
+    if (a < first || a > last)
+    {
+      if (pBits != NULL)
+        fail("%s", "character outside of the font found");
+      continue;
+    }
+
+    if (width != glyphs[a].width || advance != glyphs[a].advance)
+      fail("%s", "glyph size differs");
+    for(y=0; y<height; y++)
+      for(x=0; x<width; x++)
+        if (((pBits[y * ((width + 7) / 8) + x / 8] >> (7 - x % 8)) & 1) != glyphs[a].pixels[y][x])
+          fail("%s", "glyph pixels differ");
+
+    for(b=first; b<=last; b++)
+      if (fontKern(pOut, a, b) != kern[a][b])
+        fail("%s", "kerning differs");
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write the font as a C array.
+ *
+ ****************************************************************************/
+static void
+writeHeader(const char* pFileName, const char* pArrayName, const char* pSource)
+{
+  FILE* pFile;
+  tU32  i;
+
+  pFile = fopen(pFileName, "w");
+  if (pFile == NULL)
+    fail("cannot create %s", pFileName);
+
+  fprintf(pFile, "/*\n * Generated by fontc, do not edit. Source:\n *    %s\n", pSource);
+  fprintf(pFile, " * characters %u - %u, height %u, %u kerning pairs, %u bytes\n */\n",
+          first, last, height, numPairs, outLen);
+  fprintf(pFile, "const unsigned char %s[] = {", pArrayName);
+  for(i=0; i<outLen; i++)
+    fprintf(pFile, "%s0x%02x%s", (i % 16) ? "" : "\n", pOut[i], (i + 1 < outLen) ? "," : "");
+  fprintf(pFile, "};\n");
+  fclose(pFile);
+}
+
+
+int
+main(int argc, char** argv)
+{
+  const char* pArrayName = NULL;
+  const char* pFileName = NULL;
+  const char* pSource = NULL;
+  unsigned int cellWidth = 0;
+  unsigned int cellHeight = 0;
+  unsigned int firstChar = 32;
+  char* pData;
+  int i;
+
+  for(i=1; i<argc; i++)
+  {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+      pArrayName = argv[++i];
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+      pFileName = argv[++i];
+    else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+    {
+      if (sscanf(argv[++i], "%ux%u,%u", &cellWidth, &cellHeight, &firstChar) < 2 ||
+          cellWidth == 0 || cellWidth > 16 || cellHeight == 0 || cellHeight > FONT_MAX_HEIGHT)
+        fail("bad cell size %s", argv[i]);
+    }
+    else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+      spacing = strtoul(argv[++i], NULL, 0);
+    else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+      spaceWidth = strtoul(argv[++i], NULL, 0);
+    else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc)
+      maxKern = strtoul(argv[++i], NULL, 0);
+    else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc)
+    {
+      scale = strtoul(argv[++i], NULL, 0);
+      if (scale < 1 || scale > 4)
+        fail("bad scale %s", argv[i]);
+    }
+    else if (strcmp(argv[i], "-m") == 0)
+      monospace = TRUE;
+    else
+      pSource = argv[i];
+  }
+
+  if (pArrayName == NULL || pFileName == NULL || pSource == NULL)
+  {
+    fprintf(stderr, "usage: fontc [-s <space>] [-w <space width>] [-k <max kerning>] [-x <scale>] [-m]\n"
+                    "             [-c <w>x<h>[,<first>]] -n <array name> -o <output.h> <font>\n");
+    return 1;
+  }
+
+  pData = readFile(pSource);
+  if (cellWidth > 0)
+    readArray(pSource, pData, cellWidth, cellHeight, firstChar);
+  else
+    readBdf(pSource, pData);
+  free(pData);
+
+  if (scale > 1)
+    scaleGlyphs();
+  compileGlyphs();
+  findKerning();
+  buildFont();
+  verifyFont();
+  writeHeader(pFileName, pArrayName, pSource);
+  return 0;
+}
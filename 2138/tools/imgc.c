@@ -0,0 +1,760 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    imgc.c
+ *
+ * Description:
+ *    Host tool (run from the makefile) that converts images to the
+ *    palettized, compressed image container described in img.h.
+ *
+ *    Usage: imgc -n <array name> -o <output.h> <image> [<image> ...]
+ *           imgc -d -n <array name> -o <output.h> <image> [<image> ...]
+ *           imgc -w <x>,<y> -n <array name> -o <output.h> <image>
+ *
+ *    Every input image becomes one frame, all frames must have the same
+ *    size and share one palette. Inputs can be binary PPM files (P6) or
+ *    the C arrays of the old format ({width, height, compression flag,
+ *    escape} followed by optionally RLE coded RRRGGGBB pixels).
+ *    The smallest number of bits per pixel (1 - 8) that holds the palette
+ *    is used. The written container is decoded again with the decoder of
+ *    the target (img.c) and compared with the input.
+ *
+ *    With -d the images are written as an animation: frame 0 in full and
+ *    then only the rectangles that change to the next frame (and from the
+ *    last frame back to frame 0).
+ *
+ *    With -w the image is written in the wire format instead, i.e., as
+ *    the LCD bus frames that draw it at position x, y.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../pre_emptive_os/api/general.h"
+#include "img.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define MAX_FRAMES  255
+#define MAX_SIZE    0x400000
+
+#define LCD_SIZE    130       //visible pixels
+#define CMD_NOP     0x00
+#define CMD_CASET   0x2a
+#define CMD_PASET   0x2b
+#define CMD_RAMWR   0x2c
+
+#define MERGE_GAP   4         //unchanged pixels sent to save a window
+#define MERGE_AREA  24        //unchanged pixels sent to save a rectangle
+#define MAX_RECTS   0x10000
+
+typedef struct
+{
+  tU32 x;
+  tU32 y;
+  tU32 w;
+  tU32 h;
+} tRect;
+
+typedef struct
+{
+  const char* pName;
+  tU32 width;
+  tU32 height;
+  tU8* pPixels;              //RRRGGGBB, width * height
+} tSource;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static tSource sources[MAX_FRAMES];
+static tU32    numSources = 0;
+
+static tU8  palette[256];
+static tU32 numColors = 0;
+static tU8  indexOf[256];
+static tU8  bpp;
+
+static tU8* pOut;
+static tU32 outLen = 0;
+
+static tU32 wireAcc = 0;
+static tU8  wireBits = 0;
+static tU32 wireWords = 0;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Print an error message and exit.
+ *
+ ****************************************************************************/
+static void
+fail(const char* pFormat, const char* pArg)
+{
+  fprintf(stderr, "imgc: ");
+  fprintf(stderr, pFormat, pArg);
+  fprintf(stderr, "\n");
+  exit(1);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read a whole file.
+ *
+ ****************************************************************************/
+static tU8*
+readFile(const char* pName, tU32* pLen)
+{
+  FILE* pFile;
+  tU8*  pData;
+
+  pFile = fopen(pName, "rb");
+  if (pFile == NULL)
+    fail("cannot open %s", pName);
+
+  pData = malloc(MAX_SIZE + 1);
+  *pLen = fread(pData, 1, MAX_SIZE, pFile);
+  pData[*pLen] = '\0';
+  fclose(pFile);
+  return pData;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read a binary PPM file, colors are truncated to RRRGGGBB.
+ *
+ ****************************************************************************/
+static void
+readPpm(tSource* pSrc, tU8* pData, tU32 len)
+{
+  tU32 values[3];
+  tU32 i, pos = 2;
+
+  for(i=0; i<3; i++)
+  {
+    //skip white space and comments
+    while(pos < len && (pData[pos] <= ' ' || pData[pos] == '#'))
+    {
+      if (pData[pos] == '#')
+        while(pos < len && pData[pos] != '\n')
+          pos++;
+      pos++;
+    }
+    values[i] = strtoul((char*)&pData[pos], NULL, 10);
+    while(pos < len && pData[pos] > ' ')
+      pos++;
+  }
+  pos++;
+
+  pSrc->width  = values[0];
+  pSrc->height = values[1];
+  if (values[2] != 255 || pos + 3 * pSrc->width * pSrc->height > len)
+    fail("%s: unsupported or truncated PPM", pSrc->pName);
+
+  pSrc->pPixels = malloc(pSrc->width * pSrc->height);
+  for(i=0; i<pSrc->width * pSrc->height; i++, pos += 3)
+    pSrc->pPixels[i] = (pData[pos] & 0xe0) | ((pData[pos+1] & 0xe0) >> 3) | (pData[pos+2] >> 6);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read an image array of the old format from a C source file.
+ *
+ ****************************************************************************/
+static void
+readArray(tSource* pSrc, tU8* pData)
+{
+  char* pPos = strchr((char*)pData, '{');
+  tU8*  pBytes;
+  tU32  numBytes = 0;
+  tU32  i, pixel;
+
+  if (pPos == NULL)
+    fail("%s: no array found", pSrc->pName);
+
+  pBytes = malloc(MAX_SIZE);
+  pPos++;
+  for(;;)
+  {
+    char* pEnd;
+    tU32  value;
+
+    while(*pPos == ' ' || *pPos == ',' || *pPos == '\r' || *pPos == '\n' || *pPos == '\t')
+      pPos++;
+    if (*pPos == '}' || *pPos == '\0')
+      break;
+
+    value = strtoul(pPos, &pEnd, 0);
+    if (pEnd == pPos || value > 255 || numBytes == MAX_SIZE)
+      fail("%s: bad array", pSrc->pName);
+    pBytes[numBytes++] = value;
+    pPos = pEnd;
+  }
+
+  if (numBytes < 4)
+    fail("%s: array too short", pSrc->pName);
+
+  pSrc->width   = pBytes[0];
+  pSrc->height  = pBytes[1];
+  pSrc->pPixels = malloc(pSrc->width * pSrc->height);
+
+  pixel = 0;
+  for(i=4; pixel < pSrc->width * pSrc->height; )
+  {
+    if (i >= numBytes)
+      fail("%s: array data too short", pSrc->pName);
+
+    if (pBytes[2] != 0 && pBytes[i] == pBytes[3])
+    {
+      tU32 count;
+
+      if (i + 2 >= numBytes)
+        fail("%s: array data too short", pSrc->pName);
+      for(count=0; count<pBytes[i+1] && pixel < pSrc->width * pSrc->height; count++)
+        pSrc->pPixels[pixel++] = pBytes[i+2];
+      i += 3;
+    }
+    else
+      pSrc->pPixels[pixel++] = pBytes[i++];
+  }
+  free(pBytes);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Append bytes to the container.
+ *
+ ****************************************************************************/
+static void
+put(tU8 value)
+{
+  if (outLen == MAX_SIZE)
+    fail("%s", "container too large");
+  pOut[outLen++] = value;
+}
+
+static void
+put32(tU32 pos, tU32 value)
+{
+  pOut[pos]   = value;
+  pOut[pos+1] = value >> 8;
+  pOut[pos+2] = value >> 16;
+  pOut[pos+3] = value >> 24;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Code one frame (palette indexes) with the literal/run/copy tokens.
+ *    Greedy: the longest copy in the window is taken if it saves more
+ *    than a run, literals collect everything else.
+ *
+ ****************************************************************************/
+static void
+encodeFrame(const tU8* pIndex, tU32 len)
+{
+  tU32 pos = 0;
+  tU32 litStart = 0;
+  tU32 litLen = 0;
+
+  while(pos <= len)
+  {
+    tU32 runLen = 0;
+    tU32 copyLen = 0;
+    tU32 copyDist = 0;
+    tU32 dist;
+
+    if (pos < len)
+    {
+      while(pos + runLen < len && runLen < IMG_RUN_MAX && pIndex[pos + runLen] == pIndex[pos])
+        runLen++;
+
+      for(dist=1; dist<=IMG_WINDOW && dist<=pos; dist++)
+      {
+        tU32 n = 0;
+
+        while(pos + n < len && n < IMG_COPY_MAX && pIndex[pos + n] == pIndex[pos + n - dist])
+          n++;
+        if (n > copyLen)
+        {
+          copyLen  = n;
+          copyDist = dist;
+        }
+      }
+    }
+
+    //a run costs 2 bytes and a copy 3 bytes, use them only if literals cost more
+    if (copyLen >= IMG_COPY_MIN && copyLen > runLen + 1 && copyLen * bpp > 24)
+      runLen = 0;
+    else
+    {
+      copyLen = 0;
+      if (runLen * bpp <= 16)
+        runLen = 0;
+    }
+
+    //flush literals before a token, at end of frame or when full
+    if (litLen > 0 && (runLen > 0 || copyLen > 0 || pos == len || litLen == IMG_LITERAL_MAX))
+    {
+      tU32 i;
+      tU16 bits = 0;
+      tU8  numBits = 0;
+
+      put(litLen - 1);
+      for(i=0; i<litLen; i++)
+      {
+        bits = (bits << bpp) | pIndex[litStart + i];
+        numBits += bpp;
+        if (numBits >= 8)
+        {
+          numBits -= 8;
+          put(bits >> numBits);
+        }
+      }
+      if (numBits > 0)
+        put(bits << (8 - numBits));
+      litLen = 0;
+    }
+
+    if (pos == len)
+      break;
+
+    if (runLen > 0)
+    {
+      put(0x80 + runLen - IMG_RUN_MIN);
+      put(pIndex[pos]);
+      pos += runLen;
+    }
+    else if (copyLen > 0)
+    {
+      put(0xc0 + copyLen - IMG_COPY_MIN);
+      put((copyDist - 1) & 0xff);
+      put((copyDist - 1) >> 8);
+      pos += copyLen;
+    }
+    else
+    {
+      if (litLen == 0)
+        litStart = pos;
+      litLen++;
+      pos++;
+    }
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Code the changes from one frame to another (palette indexes) as
+ *    rectangles. Changed pixels of a row are joined to spans (over gaps
+ *    of at most MERGE_GAP pixels). A span is added to a rectangle that
+ *    ends on the row above, or on the same row, if that draws at most
+ *    MERGE_AREA unchanged pixels more, otherwise it starts a rectangle.
+ *    The pixels of all rectangles are coded as one stream.
+ *
+ ****************************************************************************/
+static void
+encodeDelta(const tU8* pFrom, const tU8* pTo)
+{
+  static tRect rects[MAX_RECTS];
+  tU32 numRects = 0;
+  tU32 width  = sources[0].width;
+  tU32 height = sources[0].height;
+  tU32 x, y, i, pos;
+  tU8* pIndex = malloc(width * height * 2);
+
+  for(y=0; y<height; y++)
+  {
+    const tU8* pRowFrom = pFrom + y * width;
+    const tU8* pRowTo   = pTo + y * width;
+
+    x = 0;
+    while(x < width)
+    {
+      tU32 start, end, best, bestExtra;
+
+      if (pRowFrom[x] == pRowTo[x])
+      {
+        x++;
+        continue;
+      }
+
+      //extend the span while the next change is close enough
+      start = x;
+      end   = x;
+      for(x=x+1; x<width && x<=end+MERGE_GAP+1; x++)
+        if (pRowFrom[x] != pRowTo[x])
+          end = x;
+      x = end + 1;
+
+      //find the rectangle that grows least by taking the span
+      best = numRects;
+      bestExtra = MERGE_AREA + 1;
+      for(i=0; i<numRects; i++)
+      {
+        tU32 left  = (rects[i].x < start) ? rects[i].x : start;
+        tU32 right = (rects[i].x + rects[i].w > end + 1) ? rects[i].x + rects[i].w : end + 1;
+        tU32 extra;
+
+        if (rects[i].y + rects[i].h < y)
+          continue;
+        if (right - left > rects[i].w + (end - start + 1) + MERGE_GAP)
+          continue;                        //too far apart
+
+        extra = (right - left - rects[i].w) * rects[i].h;
+        if (rects[i].y + rects[i].h == y)
+          extra += (right - left) - (end - start + 1);
+        if (extra < bestExtra)
+        {
+          best = i;
+          bestExtra = extra;
+        }
+      }
+
+      if (best < numRects)
+      {
+        tU32 left  = (rects[best].x < start) ? rects[best].x : start;
+        tU32 right = (rects[best].x + rects[best].w > end + 1) ? rects[best].x + rects[best].w : end + 1;
+
+        if (rects[best].y + rects[best].h == y)
+          rects[best].h++;
+        rects[best].x = left;
+        rects[best].w = right - left;
+      }
+      else
+      {
+        if (numRects == MAX_RECTS)
+          fail("%s", "too many changes");
+        rects[numRects].x = start;
+        rects[numRects].y = y;
+        rects[numRects].w = end - start + 1;
+        rects[numRects].h = 1;
+        numRects++;
+      }
+    }
+  }
+
+  put(numRects);
+  put(numRects >> 8);
+
+  pos = 0;
+  for(i=0; i<numRects; i++)
+  {
+    tU32 j, k;
+
+    put(rects[i].x);
+    put(rects[i].y);
+    put(rects[i].w);
+    put(rects[i].h);
+
+    for(j=0; j<rects[i].h; j++)
+      for(k=0; k<rects[i].w; k++)
+        pIndex[pos++] = pTo[(rects[i].y + j) * width + rects[i].x + k];
+  }
+  encodeFrame(pIndex, pos);
+  free(pIndex);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Build the container from all sources, optionally as an animation.
+ *
+ ****************************************************************************/
+static void
+buildContainer(tBool delta)
+{
+  tU32 i, j, tablePos;
+  tU32 pixels = sources[0].width * sources[0].height;
+  tU32 frames = (delta == TRUE) ? numSources + 1 : numSources;
+  tU8* pIndex = malloc(pixels * numSources);
+  tU16 sum1 = 0;
+  tU16 sum2 = 0;
+
+  //shared palette, in order of first use
+  for(i=0; i<numSources; i++)
+    for(j=0; j<pixels; j++)
+    {
+      tU8 color = sources[i].pPixels[j];
+      tU32 k;
+
+      for(k=0; k<numColors && palette[k] != color; k++)
+        ;
+      if (k == numColors)
+        palette[numColors++] = color;
+      indexOf[color] = k;
+    }
+
+  for(bpp=1; (1U << bpp) < numColors; bpp++)
+    ;
+
+  if (delta == TRUE && (sources[0].width > 255 || sources[0].height > 255))
+    fail("%s", "animations are limited to 255x255");
+
+  pOut = malloc(MAX_SIZE);
+  put(IMG_MAGIC);
+  put((delta == TRUE) ? (bpp | IMG_FLAG_DELTA) : bpp);
+  put(sources[0].width);
+  put(sources[0].width >> 8);
+  put(sources[0].height);
+  put(sources[0].height >> 8);
+  put(numSources);
+  put(numColors - 1);
+  for(i=0; i<6; i++)
+    put(0);                                //checksum and size, set below
+  for(i=0; i<numColors; i++)
+    put(palette[i]);
+
+  tablePos = outLen;
+  for(i=0; i<4*frames; i++)
+    put(0);
+
+  for(i=0; i<numSources; i++)
+    for(j=0; j<pixels; j++)
+      pIndex[i * pixels + j] = indexOf[sources[i].pPixels[j]];
+
+  for(i=0; i<frames; i++)
+  {
+    put32(tablePos + 4*i, outLen);
+    if (delta == FALSE || i == 0)
+      encodeFrame(&pIndex[i * pixels], pixels);
+    else
+      encodeDelta(&pIndex[(i - 1) * pixels], &pIndex[(i % numSources) * pixels]);
+  }
+
+  for(i=IMG_HEADER_SIZE; i<outLen; i++)
+  {
+    sum1 = (sum1 + pOut[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  pOut[8] = sum1;
+  pOut[9] = sum2;
+  put32(10, outLen);
+  free(pIndex);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Append a 9-bit word (bit 8 = data) to the wire format image.
+ *
+ ****************************************************************************/
+static void
+putWord(tU16 word)
+{
+  wireAcc   = (wireAcc << 9) | word;
+  wireBits += 9;
+  while(wireBits >= 8)
+  {
+    wireBits -= 8;
+    put(wireAcc >> wireBits);
+  }
+  wireWords++;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Build a wire format image of the (only) source at position x, y.
+ *
+ ****************************************************************************/
+static void
+buildWire(tU32 x, tU32 y)
+{
+  tSource* pSrc = &sources[0];
+  tU32 i;
+
+  if (numSources != 1 || x + pSrc->width > LCD_SIZE || y + pSrc->height > LCD_SIZE)
+    fail("%s: one image that fits on the screen is needed", pSrc->pName);
+
+  pOut = malloc(MAX_SIZE);
+  put(IMG_WIRE_MAGIC);
+  put(x);
+  put(y);
+  put(pSrc->width);
+  put(pSrc->height);
+  for(i=0; i<4; i++)
+    put(0);                                //size, set below
+
+  //visible area starts at row/column 2 of the controller
+  putWord(CMD_CASET);
+  putWord(0x100 | (x + 2));
+  putWord(0x100 | (x + pSrc->width + 1));
+  putWord(CMD_PASET);
+  putWord(0x100 | (y + 2));
+  putWord(0x100 | (y + pSrc->height + 1));
+  putWord(CMD_RAMWR);
+  for(i=0; i<pSrc->width * pSrc->height; i++)
+    putWord(0x100 | pSrc->pPixels[i]);
+  while(wireWords % 8 != 0)
+    putWord(CMD_NOP);
+
+  put32(5, outLen - IMG_WIRE_HEADER);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Decode the container with the target decoder and compare.
+ *
+ ****************************************************************************/
+static void
+verifyContainer(void)
+{
+  static tImgDecoder dec;
+  tU32 width  = sources[0].width;
+  tU32 pixels = sources[0].width * sources[0].height;
+  tU8* pFrame = malloc(pixels);
+  tU32 i, j;
+
+  if (imgCheck(pOut) == FALSE)
+    fail("%s", "container check failed");
+
+  for(i=0; i<numSources; i++)
+  {
+    if (imgIsDelta(pOut) == FALSE || i == 0)
+    {
+      imgDecodeStart(&dec, pOut, imgFrameData(pOut, i));
+      for(j=0; j<pixels; j++)
+        pFrame[j] = imgDecodePixel(&dec);
+    }
+    else
+    {
+      //apply the changed rectangles to the previous frame
+      const tU8* pData = imgFrameData(pOut, i);
+      tU32 rects = pData[0] | (pData[1] << 8);
+
+      imgDecodeStart(&dec, pOut, pData + 2 + IMG_RECT_SIZE * rects);
+      for(pData += 2; rects > 0; rects--, pData += IMG_RECT_SIZE)
+        for(j=0; j<(tU32)pData[2] * pData[3]; j++)
+          pFrame[(pData[1] + j / pData[2]) * width + pData[0] + j % pData[2]] = imgDecodePixel(&dec);
+    }
+
+    if (memcmp(pFrame, sources[i].pPixels, pixels) != 0)
+      fail("%s: decoded frame differs", sources[i].pName);
+  }
+  free(pFrame);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write the container as a C array.
+ *
+ ****************************************************************************/
+static void
+writeHeader(const char* pFileName, const char* pArrayName)
+{
+  FILE* pFile;
+  tU32  i;
+
+  pFile = fopen(pFileName, "w");
+  if (pFile == NULL)
+    fail("cannot create %s", pFileName);
+
+  fprintf(pFile, "/*\n * Generated by imgc, do not edit. Source:\n");
+  for(i=0; i<numSources; i++)
+    fprintf(pFile, " *    %s\n", sources[i].pName);
+  if (pOut[0] == IMG_WIRE_MAGIC)
+    fprintf(pFile, " * %ux%u at %u,%u, wire format, %u bytes\n */\n",
+            sources[0].width, sources[0].height, pOut[1], pOut[2], outLen);
+  else
+    fprintf(pFile, " * %ux%u, %u frame(s), %u colors at %u bpp, %u bytes\n */\n",
+            sources[0].width, sources[0].height, numSources, numColors, bpp, outLen);
+  fprintf(pFile, "const unsigned char %s[] = {", pArrayName);
+  for(i=0; i<outLen; i++)
+    fprintf(pFile, "%s0x%02x%s", (i % 16) ? "" : "\n", pOut[i], (i + 1 < outLen) ? "," : "");
+  fprintf(pFile, "};\n");
+  fclose(pFile);
+}
+
+
+int
+main(int argc, char** argv)
+{
+  const char* pArrayName = NULL;
+  const char* pFileName = NULL;
+  tBool wire = FALSE;
+  tBool delta = FALSE;
+  unsigned int wireX = 0;
+  unsigned int wireY = 0;
+  int i;
+
+  for(i=1; i<argc; i++)
+  {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+      pArrayName = argv[++i];
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+      pFileName = argv[++i];
+    else if (strcmp(argv[i], "-d") == 0)
+      delta = TRUE;
+    else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+    {
+      if (sscanf(argv[++i], "%u,%u", &wireX, &wireY) != 2)
+        fail("bad position %s", argv[i]);
+      wire = TRUE;
+    }
+    else if (numSources < MAX_FRAMES)
+    {
+      tSource* pSrc = &sources[numSources++];
+      tU8*     pData;
+      tU32     len;
+
+      pSrc->pName = argv[i];
+      pData = readFile(pSrc->pName, &len);
+      if (len > 2 && pData[0] == 'P' && pData[1] == '6')
+        readPpm(pSrc, pData, len);
+      else
+        readArray(pSrc, pData);
+      free(pData);
+
+      if (pSrc->width == 0 || pSrc->height == 0 || pSrc->width > 0xffff || pSrc->height > 0xffff ||
+          pSrc->width != sources[0].width || pSrc->height != sources[0].height)
+        fail("%s: bad size", pSrc->pName);
+    }
+  }
+
+  if (pArrayName == NULL || pFileName == NULL || numSources == 0)
+  {
+    fprintf(stderr, "usage: imgc [-d | -w <x>,<y>] -n <array name> -o <output.h> <image> [<image> ...]\n");
+    return 1;
+  }
+
+  if (wire == TRUE)
+  {
+    buildWire(wireX, wireY);
+    writeHeader(pFileName, pArrayName);
+    return 0;
+  }
+
+  buildContainer(delta);
+  verifyContainer();
+  writeHeader(pFileName, pArrayName);
+  return 0;
+}
@@ -0,0 +1,347 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    lcdreplay.c
+ *
+ * Description:
+ *    Host tool that replays LCD bus captures (see lcdCapture.h) through
+ *    the controller model (host/fakeController.c) and writes the screen
+ *    after every capture as a 130x130 PPM image.
+ *
+ *    Usage: lcdreplay [-o <dir>] [-g <golden dir>] [-b <budget file>] <capture>
+ *
+ *    The capture file is the console output of a build with
+ *    LCD_CAPTURE = 1, other console text around the captures is skipped.
+ *    The display memory is kept from one capture to the next, like the
+ *    panel keeps it. A name captured again gets the suffix _2, _3, ...
+ *
+ *    With -g every image is compared with the image of the same name in
+ *    the golden directory, a missing golden image is a failure. With -b the bus bytes of every capture are
+ *    checked against the budget file (lines "<name> <max bytes>", # for
+ *    comments). The tool returns 1 if an image differs or a budget is
+ *    exceeded, so it can be used as a regression check.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../pre_emptive_os/api/general.h"
+#include "../lcdCapture.h"
+#include "../host/fakeController.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define MAX_SIZE      0x4000000
+#define MAX_CAPTURES  256
+#define MAX_NAME      64
+#define IMAGE_BYTES   (FAKE_CONTROLLER_SIZE * FAKE_CONTROLLER_SIZE * 3)
+
+typedef struct
+{
+  char name[MAX_NAME];
+  tU32 maxBytes;
+} tBudget;
+
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+static char    names[MAX_CAPTURES][MAX_NAME];
+static tU32    numNames = 0;
+static tBudget budgets[MAX_CAPTURES];
+static tU32    numBudgets = 0;
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Print an error message and exit.
+ *
+ ****************************************************************************/
+static void
+fail(const char* pFormat, const char* pArg)
+{
+  fprintf(stderr, "lcdreplay: ");
+  fprintf(stderr, pFormat, pArg);
+  fprintf(stderr, "\n");
+  exit(2);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read a whole file.
+ *
+ ****************************************************************************/
+static tU8*
+readFile(const char* pName, tU32* pLen)
+{
+  FILE* pFile;
+  tU8*  pData;
+
+  pFile = fopen(pName, "rb");
+  if (pFile == NULL)
+    return NULL;
+
+  pData = malloc(MAX_SIZE + 1);
+  *pLen = fread(pData, 1, MAX_SIZE, pFile);
+  pData[*pLen] = '\0';
+  fclose(pFile);
+  return pData;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Read the budget file.
+ *
+ ****************************************************************************/
+static void
+readBudgets(const char* pName)
+{
+  char line[256];
+  FILE* pFile = fopen(pName, "r");
+
+  if (pFile == NULL)
+    fail("cannot open %s", pName);
+
+  while(fgets(line, sizeof(line), pFile) != NULL && numBudgets < MAX_CAPTURES)
+  {
+    tBudget* pBudget = &budgets[numBudgets];
+    unsigned int maxBytes;
+
+    if (line[0] == '#')
+      continue;
+    if (sscanf(line, "%63s %u", pBudget->name, &maxBytes) == 2)
+    {
+      pBudget->maxBytes = maxBytes;
+      numBudgets++;
+    }
+  }
+  fclose(pFile);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Make the image name of a capture unique (name, name_2, name_3, ...).
+ *
+ ****************************************************************************/
+static void
+uniqueName(const char* pName, char* pUnique)
+{
+  tU32 count = 1;
+  tU32 i;
+
+  strcpy(pUnique, pName);
+  for(i=0; i<numNames; i++)
+    if (strncmp(names[i], pName, MAX_NAME) == 0)
+      count++;
+  if (numNames < MAX_CAPTURES)
+    strcpy(names[numNames++], pName);
+  if (count > 1)
+    sprintf(pUnique + strlen(pUnique), "_%u", count);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Write the screen as a binary PPM file.
+ *
+ ****************************************************************************/
+static void
+writePpm(const char* pFileName, const tU8* pRgb)
+{
+  FILE* pFile = fopen(pFileName, "wb");
+
+  if (pFile == NULL)
+    fail("cannot create %s", pFileName);
+  fprintf(pFile, "P6\n%u %u\n255\n", FAKE_CONTROLLER_SIZE, FAKE_CONTROLLER_SIZE);
+  fwrite(pRgb, 1, IMAGE_BYTES, pFile);
+  fclose(pFile);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Compare the screen with a golden PPM file (written by this tool).
+ *
+ * Returns:
+ *    Number of differing pixels, or -1 if there is no golden image.
+ *
+ ****************************************************************************/
+static tS32
+compareGolden(const char* pFileName, const tU8* pRgb)
+{
+  char header[32];
+  tU8* pData;
+  tU32 len;
+  tU32 headerLen;
+  tS32 diff = 0;
+  tU32 i;
+
+  pData = readFile(pFileName, &len);
+  if (pData == NULL)
+    return -1;
+
+  headerLen = sprintf(header, "P6\n%u %u\n255\n", FAKE_CONTROLLER_SIZE, FAKE_CONTROLLER_SIZE);
+  if (len != headerLen + IMAGE_BYTES || memcmp(pData, header, headerLen) != 0)
+    fail("%s: not a 130x130 PPM image", pFileName);
+
+  for(i=0; i<IMAGE_BYTES; i += 3)
+    if (memcmp(pData + headerLen + i, pRgb + i, 3) != 0)
+      diff++;
+  free(pData);
+  return diff;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Replay one capture from the position after its name.
+ *
+ * Returns:
+ *    Position after the end of the capture.
+ *
+ ****************************************************************************/
+static tU32
+replay(const tU8* pData, tU32 pos, tU32 len)
+{
+  while(pos + 1 < len)
+  {
+    tU16 unit = pData[pos] | (pData[pos + 1] << 8);
+    tU16 count = 1;
+
+    pos += 2;
+    if (unit == LCD_CAPTURE_END)
+      return pos;
+
+    if (unit & LCD_CAPTURE_REPEAT)
+    {
+      if (pos + 1 >= len)
+        break;
+      count = unit & LCD_CAPTURE_MAX_RUN;
+      unit  = pData[pos] | (pData[pos + 1] << 8);
+      pos  += 2;
+    }
+    while(count-- > 0)
+      fakeControllerWord(unit & 0x1ff);
+  }
+
+  fprintf(stderr, "lcdreplay: capture not terminated\n");
+  return len;
+}
+
+
+int
+main(int argc, char** argv)
+{
+  const char* pOutDir = ".";
+  const char* pGoldenDir = NULL;
+  const char* pCapture = NULL;
+  static tU8 rgb[IMAGE_BYTES];
+  tU8* pData;
+  tU32 len;
+  tU32 pos = 0;
+  int  result = 0;
+  int  i;
+
+  for(i=1; i<argc; i++)
+  {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+      pOutDir = argv[++i];
+    else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+      pGoldenDir = argv[++i];
+    else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+      readBudgets(argv[++i]);
+    else
+      pCapture = argv[i];
+  }
+
+  if (pCapture == NULL)
+  {
+    fprintf(stderr, "usage: lcdreplay [-o <dir>] [-g <golden dir>] [-b <budget file>] <capture>\n");
+    return 2;
+  }
+
+  pData = readFile(pCapture, &len);
+  if (pData == NULL)
+    fail("cannot open %s", pCapture);
+
+  fakeControllerReset();
+  while(pos + 4 < len)
+  {
+    char  name[MAX_NAME];
+    char  imageName[MAX_NAME + 8];
+    char  fileName[512];
+    tU32  n = 0;
+    tU32  words;
+    tU32  bytes;
+    tS32  diff;
+
+    //skip console text up to the next capture
+    if (memcmp(pData + pos, "LCDC", 4) != 0)
+    {
+      pos++;
+      continue;
+    }
+    for(pos += 4; pos < len && pData[pos] != '\0'; pos++)
+      if (n < MAX_NAME - 1)
+        name[n++] = pData[pos];
+    name[n] = '\0';
+    pos++;
+
+    words = fakeController()->words;
+    pos   = replay(pData, pos, len);
+    words = fakeController()->words - words;
+    bytes = (words * 9 + 7) / 8;
+
+    uniqueName(name, imageName);
+    fakeControllerRgb(rgb);
+    sprintf(fileName, "%s/%s.ppm", pOutDir, imageName);
+    writePpm(fileName, rgb);
+    printf("%-16s %7u words %7u bytes", imageName, words, bytes);
+
+    if (pGoldenDir != NULL)
+    {
+      sprintf(fileName, "%s/%s.ppm", pGoldenDir, imageName);
+      diff = compareGolden(fileName, rgb);
+      if (diff < 0)
+      {
+        printf("  no golden image");
+        result = 1;
+      }
+      else if (diff > 0)
+      {
+        printf("  %d pixels differ", diff);
+        result = 1;
+      }
+    }
+
+    for(n=0; n<numBudgets; n++)
+      if (strcmp(budgets[n].name, imageName) == 0 && bytes > budgets[n].maxBytes)
+      {
+        printf("  over budget (%u bytes)", budgets[n].maxBytes);
+        result = 1;
+      }
+    printf("\n");
+  }
+
+  free(pData);
+  return result;
+}
@@ -18,6 +18,7 @@
 #include <lpc2xxx.h>
 #include "uart.h"
 #include "irq_code/irqUart.h"
+#include "perf.h"
 
 
 /*****************************************************************************
@@ -140,6 +141,7 @@ uart1SendChar(tU8 charToSend)
   {
     uart1TxRunning = TRUE;
     U1THR          = charToSend;
+    PERF_UART1_BYTE();
   }
 
   //disable IRQ
@@ -0,0 +1,488 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    ui.c
+ *
+ * Description:
+ *    Retained widgets for menus and dialogs. A screen is a tree of
+ *    widgets (frames with labels, lists and other frames as children),
+ *    every widget keeps its geometry, colors and content. Changing a
+ *    widget only marks the changed part dirty - e.g. moving the cursor
+ *    of a list marks the old and the new item - and uiDraw() draws the
+ *    dirty parts of a tree, parents before children.
+ *
+ *    Content that was overwritten by something else (a dialog or another
+ *    screen) is repainted with uiInvalidate() for the overwritten area
+ *    and uiDraw(). uiDialogClose() does this for the area of a dialog and
+ *    calls an optional function for the content that is not made of
+ *    widgets.
+ *
+ *    Labels and list items are drawn padded with spaces to their width,
+ *    so a shorter text replaces a longer one without clearing first.
+ *
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+#include "ui.h"
+#include "lcd.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define CHAR_WIDTH   8
+#define SCREEN_SIZE  130
+
+
+/*****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static void  initWidget(tUiWidget* pWidget, tU8 type, tU8 x, tU8 y, tU8 xLen, tU8 yLen,
+                        tU8 bkgColor, tU8 textColor);
+static tBool overlaps(tU8 x0, tU8 xLen0, tU8 x1, tU8 xLen1);
+static void  drawText(tU8 x, tU8 y, tU8 columns, const char* pText, tU8 bkgColor, tU8 textColor);
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Common initialization of all widget types.
+ *
+ ****************************************************************************/
+static void
+initWidget(tUiWidget* pWidget, tU8 type, tU8 x, tU8 y, tU8 xLen, tU8 yLen,
+           tU8 bkgColor, tU8 textColor)
+{
+  pWidget->pNext       = NULL;
+  pWidget->pChild      = NULL;
+  pWidget->pText       = NULL;
+  pWidget->ppItems     = NULL;
+  pWidget->type        = type;
+  pWidget->x           = x;
+  pWidget->y           = y;
+  pWidget->xLen        = xLen;
+  pWidget->yLen        = yLen;
+  pWidget->bkgColor    = bkgColor;
+  pWidget->textColor   = textColor;
+  pWidget->selBkgColor = bkgColor;
+  pWidget->selColor    = textColor;
+  pWidget->textX       = 0;
+  pWidget->textY       = 0;
+  pWidget->count       = 0;
+  pWidget->cursor      = 0;
+  pWidget->dirty       = 0;
+  pWidget->dirtyX0     = 0;
+  pWidget->dirtyY0     = 0;
+  pWidget->dirtyX1     = 0;
+  pWidget->dirtyY1     = 0;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Check if two ranges overlap.
+ *
+ ****************************************************************************/
+static tBool
+overlaps(tU8 x0, tU8 xLen0, tU8 x1, tU8 xLen1)
+{
+  if ((tU16)x0 + xLen0 <= x1 || (tU16)x1 + xLen1 <= x0)
+    return FALSE;
+  return TRUE;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw a text padded with spaces to a number of columns (one text run).
+ *
+ ****************************************************************************/
+static void
+drawText(tU8 x, tU8 y, tU8 columns, const char* pText, tU8 bkgColor, tU8 textColor)
+{
+  char line[UI_COLUMNS + 1];
+  tU8  i = 0;
+
+  if (pText != NULL)
+    for(; i < columns && pText[i] != '\0'; i++)
+      line[i] = pText[i];
+  for(; i < columns; i++)
+    line[i] = ' ';
+  line[i] = '\0';
+
+  lcdGotoxy(x, y);
+  lcdColor(bkgColor, textColor);
+  lcdPuts(line);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize a frame, a filled rectangle. Frames are the parents of
+ *    other widgets, e.g. a menu is a frame with a list.
+ *
+ ****************************************************************************/
+void
+uiFrame(tUiWidget* pFrame, tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 bkgColor)
+{
+  initWidget(pFrame, UI_FRAME, x, y, xLen, yLen, bkgColor, bkgColor);
+  pFrame->dirtyX0 = x;
+  pFrame->dirtyY0 = y;
+  pFrame->dirtyX1 = x + xLen;
+  pFrame->dirtyY1 = y + yLen;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Set the header text of a frame.
+ *
+ * Params:
+ *    [in] pFrame       - frame
+ *    [in] pText        - text, drawn on the frame color
+ *    [in] textX, textY - position relative to the frame
+ *    [in] textColor    - text color
+ *
+ ****************************************************************************/
+void
+uiFrameHeader(tUiWidget* pFrame, const char* pText, tU8 textX, tU8 textY, tU8 textColor)
+{
+  pFrame->pText     = pText;
+  pFrame->textX     = textX;
+  pFrame->textY     = textY;
+  pFrame->textColor = textColor;
+  pFrame->dirty    |= UI_DIRTY_TEXT;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize a label.
+ *
+ * Params:
+ *    [in] pLabel  - label
+ *    [in] x, y    - position
+ *    [in] columns - width in characters (at most UI_COLUMNS)
+ *    [in] pText   - text, may be NULL
+ *
+ ****************************************************************************/
+void
+uiLabel(tUiWidget* pLabel, tU8 x, tU8 y, tU8 columns, const char* pText, tU8 bkgColor, tU8 textColor)
+{
+  initWidget(pLabel, UI_LABEL, x, y, columns * CHAR_WIDTH, UI_ROW_HEIGHT, bkgColor, textColor);
+  pLabel->pText = pText;
+  pLabel->dirty = UI_DIRTY_TEXT;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Initialize a list, one item per text line.
+ *
+ * Params:
+ *    [in] pList       - list
+ *    [in] x, y        - position of the first item
+ *    [in] columns     - width in characters (at most UI_COLUMNS)
+ *    [in] ppItems     - item texts, the array is used by the list
+ *    [in] count       - number of items (at most UI_LIST_MAX)
+ *    [in] selBkgColor - colors of the selected item
+ *    [in] selColor
+ *
+ ****************************************************************************/
+void
+uiList(tUiWidget* pList, tU8 x, tU8 y, tU8 columns, const char** ppItems, tU8 count,
+       tU8 bkgColor, tU8 textColor, tU8 selBkgColor, tU8 selColor)
+{
+  initWidget(pList, UI_LIST, x, y, columns * CHAR_WIDTH, count * UI_ROW_HEIGHT, bkgColor, textColor);
+  pList->ppItems     = ppItems;
+  pList->count       = count;
+  pList->selBkgColor = selBkgColor;
+  pList->selColor    = selColor;
+  pList->dirty       = (tU16)((1UL << count) - 1);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Add a widget as the last (top most) child of a frame.
+ *
+ ****************************************************************************/
+void
+uiAdd(tUiWidget* pParent, tUiWidget* pChild)
+{
+  tUiWidget** ppLast = &pParent->pChild;
+
+  while (*ppLast != NULL)
+    ppLast = &(*ppLast)->pNext;
+  *ppLast = pChild;
+  pChild->pNext = NULL;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Change the text of a label.
+ *
+ ****************************************************************************/
+void
+uiLabelSet(tUiWidget* pLabel, const char* pText)
+{
+  if (pLabel->pText != pText)
+  {
+    pLabel->pText  = pText;
+    pLabel->dirty |= UI_DIRTY_TEXT;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Change the text of a list item.
+ *
+ ****************************************************************************/
+void
+uiListSetItem(tUiWidget* pList, tU8 item, const char* pText)
+{
+  if (item < pList->count && pList->ppItems[item] != pText)
+  {
+    pList->ppItems[item] = pText;
+    pList->dirty |= 1 << item;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Select an item of a list, only the old and the new item are redrawn.
+ *
+ ****************************************************************************/
+void
+uiListSetCursor(tUiWidget* pList, tU8 cursor)
+{
+  if (cursor < pList->count && cursor != pList->cursor)
+  {
+    pList->dirty |= (1 << pList->cursor) | (1 << cursor);
+    pList->cursor = cursor;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Move the cursor of a list, wraps around at the first and last item.
+ *
+ * Returns:
+ *    The new cursor position.
+ *
+ ****************************************************************************/
+tU8
+uiListMove(tUiWidget* pList, tS8 step)
+{
+  tS16 cursor = (tS16)pList->cursor + step;
+
+  while (cursor < 0)
+    cursor += pList->count;
+  while (cursor >= pList->count)
+    cursor -= pList->count;
+
+  uiListSetCursor(pList, (tU8)cursor);
+  return pList->cursor;
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Mark the parts of a widget and its children that cover an area of
+ *    the screen as dirty, e.g. after a dialog has been drawn over it.
+ *
+ ****************************************************************************/
+void
+uiInvalidate(tUiWidget* pWidget, tU8 x, tU8 y, tU8 xLen, tU8 yLen)
+{
+  tUiWidget* pChild;
+  tU8 i;
+
+  if (overlaps(x, xLen, pWidget->x, pWidget->xLen) == FALSE ||
+      overlaps(y, yLen, pWidget->y, pWidget->yLen) == FALSE)
+    return;
+
+  switch(pWidget->type)
+  {
+    case UI_FRAME:
+    {
+      //add the area, clipped to the frame, to the area to fill
+      tBool covered = FALSE;
+      tU16 x0 = (x > pWidget->x) ? x : pWidget->x;
+      tU16 y0 = (y > pWidget->y) ? y : pWidget->y;
+      tU16 x1 = (tU16)x + xLen;
+      tU16 y1 = (tU16)y + yLen;
+
+      if (x1 > (tU16)pWidget->x + pWidget->xLen)
+        x1 = (tU16)pWidget->x + pWidget->xLen;
+      if (y1 > (tU16)pWidget->y + pWidget->yLen)
+        y1 = (tU16)pWidget->y + pWidget->yLen;
+
+      //no need to fill what a child frame will fill
+      for(pChild = pWidget->pChild; pChild != NULL; pChild = pChild->pNext)
+        if (pChild->type == UI_FRAME &&
+            x0 >= pChild->x && x1 <= (tU16)pChild->x + pChild->xLen &&
+            y0 >= pChild->y && y1 <= (tU16)pChild->y + pChild->yLen)
+          covered = TRUE;
+
+      if (covered == FALSE)
+      {
+        if (pWidget->dirtyX1 > pWidget->dirtyX0)
+        {
+          if (pWidget->dirtyX0 < x0) x0 = pWidget->dirtyX0;
+          if (pWidget->dirtyY0 < y0) y0 = pWidget->dirtyY0;
+          if (pWidget->dirtyX1 > x1) x1 = pWidget->dirtyX1;
+          if (pWidget->dirtyY1 > y1) y1 = pWidget->dirtyY1;
+        }
+        pWidget->dirtyX0 = x0;
+        pWidget->dirtyY0 = y0;
+        pWidget->dirtyX1 = x1;
+        pWidget->dirtyY1 = y1;
+      }
+
+      //the header is drawn again as a whole
+      if (pWidget->pText != NULL && overlaps(y, yLen, pWidget->y + pWidget->textY, UI_ROW_HEIGHT))
+        pWidget->dirty |= UI_DIRTY_TEXT;
+
+      for(pChild = pWidget->pChild; pChild != NULL; pChild = pChild->pNext)
+        uiInvalidate(pChild, x, y, xLen, yLen);
+    }
+    break;
+
+    case UI_LABEL:
+      pWidget->dirty |= UI_DIRTY_TEXT;
+      break;
+
+    case UI_LIST:
+      for(i = 0; i < pWidget->count; i++)
+        if (overlaps(y, yLen, pWidget->y + i * UI_ROW_HEIGHT, UI_ROW_HEIGHT))
+          pWidget->dirty |= 1 << i;
+      break;
+
+    default:
+      break;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Mark a widget and all its children as dirty.
+ *
+ ****************************************************************************/
+void
+uiInvalidateAll(tUiWidget* pWidget)
+{
+  uiInvalidate(pWidget, 0, 0, SCREEN_SIZE, SCREEN_SIZE);
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Draw the dirty parts of a widget and its children.
+ *
+ ****************************************************************************/
+void
+uiDraw(tUiWidget* pWidget)
+{
+  tUiWidget* pChild;
+  tU8 i;
+
+  switch(pWidget->type)
+  {
+    case UI_FRAME:
+      if (pWidget->dirtyX1 > pWidget->dirtyX0)
+      {
+        lcdRect(pWidget->dirtyX0, pWidget->dirtyY0,
+                pWidget->dirtyX1 - pWidget->dirtyX0, pWidget->dirtyY1 - pWidget->dirtyY0,
+                pWidget->bkgColor);
+        pWidget->dirtyX0 = pWidget->dirtyX1 = 0;
+      }
+      if ((pWidget->dirty & UI_DIRTY_TEXT) != 0 && pWidget->pText != NULL)
+      {
+        lcdGotoxy(pWidget->x + pWidget->textX, pWidget->y + pWidget->textY);
+        lcdColor(pWidget->bkgColor, pWidget->textColor);
+        lcdPuts(pWidget->pText);
+      }
+      pWidget->dirty = 0;
+
+      for(pChild = pWidget->pChild; pChild != NULL; pChild = pChild->pNext)
+        uiDraw(pChild);
+      break;
+
+    case UI_LABEL:
+      if (pWidget->dirty != 0)
+        drawText(pWidget->x, pWidget->y, pWidget->xLen / CHAR_WIDTH, pWidget->pText,
+                 pWidget->bkgColor, pWidget->textColor);
+      pWidget->dirty = 0;
+      break;
+
+    case UI_LIST:
+      for(i = 0; i < pWidget->count && pWidget->dirty != 0; i++)
+      {
+        if ((pWidget->dirty & (1 << i)) == 0)
+          continue;
+
+        if (i == pWidget->cursor)
+          drawText(pWidget->x, pWidget->y + i * UI_ROW_HEIGHT, pWidget->xLen / CHAR_WIDTH,
+                   pWidget->ppItems[i], pWidget->selBkgColor, pWidget->selColor);
+        else
+          drawText(pWidget->x, pWidget->y + i * UI_ROW_HEIGHT, pWidget->xLen / CHAR_WIDTH,
+                   pWidget->ppItems[i], pWidget->bkgColor, pWidget->textColor);
+        pWidget->dirty &= ~(1 << i);
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+
+/*****************************************************************************
+ *
+ * Description:
+ *    Remove a dialog from the screen. The area of the dialog is redrawn
+ *    from the widgets under it and then from the restore function.
+ *
+ * Params:
+ *    [in] pDialog  - dialog frame
+ *    [in] pUnder   - widgets under the dialog, may be NULL
+ *    [in] pRestore - repaints other content in an area, may be NULL
+ *
+ ****************************************************************************/
+void
+uiDialogClose(tUiWidget* pDialog, tUiWidget* pUnder, tUiRestore pRestore)
+{
+  if (pUnder != NULL)
+  {
+    uiInvalidate(pUnder, pDialog->x, pDialog->y, pDialog->xLen, pDialog->yLen);
+    uiDraw(pUnder);
+  }
+  if (pRestore != NULL)
+    pRestore(pDialog->x, pDialog->y, pDialog->xLen, pDialog->yLen);
+}
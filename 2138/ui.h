@@ -0,0 +1,81 @@
+/******************************************************************************
+ *
+ * Copyright:
+ *    (C) 2011
+ *
+ * File:
+ *    ui.h
+ *
+ * Description:
+ *    Expose the retained widget layer (frames, labels and lists).
+ *
+ *****************************************************************************/
+#ifndef _UI_H_
+#define _UI_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "../pre_emptive_os/api/general.h"
+
+
+/******************************************************************************
+ * Typedefs and defines
+ *****************************************************************************/
+#define UI_FRAME       0        //filled rectangle with optional header text
+#define UI_LABEL       1        //one line of text
+#define UI_LIST        2        //text lines, one of them selected
+
+#define UI_ROW_HEIGHT  14       //8x14 characters
+#define UI_COLUMNS     16       //max characters of a label or list item
+#define UI_LIST_MAX    16       //max items in a list
+#define UI_DIRTY_TEXT  0x0001   //label text or frame header must be drawn
+
+typedef struct _tUiWidget
+{
+  struct _tUiWidget* pNext;     //next widget with the same parent
+  struct _tUiWidget* pChild;    //first child, drawn on top of this widget
+  const char*  pText;           //label text or frame header (NULL for none)
+  const char** ppItems;         //list items
+  tU8  type;
+  tU8  x;
+  tU8  y;
+  tU8  xLen;
+  tU8  yLen;
+  tU8  bkgColor;
+  tU8  textColor;
+  tU8  selBkgColor;             //list: colors of the selected item
+  tU8  selColor;
+  tU8  textX;                   //frame: header position relative to x, y
+  tU8  textY;
+  tU8  count;                   //list: number of items
+  tU8  cursor;                  //list: selected item
+  tU16 dirty;                   //list: one bit per item, others UI_DIRTY_TEXT
+  tU8  dirtyX0;                 //frame: area to fill, end exclusive
+  tU8  dirtyY0;
+  tU8  dirtyX1;
+  tU8  dirtyY1;
+} tUiWidget;
+
+//repaints screen content that is not made of widgets, e.g. a game board
+typedef void (*tUiRestore)(tU8 x, tU8 y, tU8 xLen, tU8 yLen);
+
+
+void uiFrame(tUiWidget* pFrame, tU8 x, tU8 y, tU8 xLen, tU8 yLen, tU8 bkgColor);
+void uiFrameHeader(tUiWidget* pFrame, const char* pText, tU8 textX, tU8 textY, tU8 textColor);
+void uiLabel(tUiWidget* pLabel, tU8 x, tU8 y, tU8 columns, const char* pText, tU8 bkgColor, tU8 textColor);
+void uiList(tUiWidget* pList, tU8 x, tU8 y, tU8 columns, const char** ppItems, tU8 count,
+            tU8 bkgColor, tU8 textColor, tU8 selBkgColor, tU8 selColor);
+void uiAdd(tUiWidget* pParent, tUiWidget* pChild);
+
+void uiLabelSet(tUiWidget* pLabel, const char* pText);
+void uiListSetItem(tUiWidget* pList, tU8 item, const char* pText);
+void uiListSetCursor(tUiWidget* pList, tU8 cursor);
+tU8  uiListMove(tUiWidget* pList, tS8 step);
+
+void uiInvalidate(tUiWidget* pWidget, tU8 x, tU8 y, tU8 xLen, tU8 yLen);
+void uiInvalidateAll(tUiWidget* pWidget);
+void uiDraw(tUiWidget* pWidget);
+void uiDialogClose(tUiWidget* pDialog, tUiWidget* pUnder, tUiRestore pRestore);
+
+#endif